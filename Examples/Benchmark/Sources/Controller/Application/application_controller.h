@@ -0,0 +1,8 @@
+
+#pragma once
+
+class ApplicationController : public uicore::Application
+{
+public:
+	ApplicationController();
+};
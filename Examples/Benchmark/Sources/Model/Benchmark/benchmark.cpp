@@ -0,0 +1,19 @@
+
+#include "precomp.h"
+#include "benchmark.h"
+
+using namespace uicore;
+
+std::string BenchmarkResult::to_string() const
+{
+	return string_format("%1: %2 %3", name, Text::to_string(value, 4), unit);
+}
+
+double Benchmark::time_per_iteration(int iterations, const std::function<void()> &func)
+{
+	int64_t start = System::microseconds();
+	for (int i = 0; i < iterations; i++)
+		func();
+	int64_t end = System::microseconds();
+	return (end - start) / (double)std::max(iterations, 1);
+}
@@ -0,0 +1,28 @@
+
+#pragma once
+
+class BenchmarkResult
+{
+public:
+	BenchmarkResult() { }
+	BenchmarkResult(const std::string &name, double value, const std::string &unit) : name(name), value(value), unit(unit) { }
+
+	std::string name;
+	double value = 0.0;
+	std::string unit;
+
+	std::string to_string() const;
+};
+
+class Benchmark
+{
+public:
+	virtual ~Benchmark() { }
+
+	virtual std::string name() const = 0;
+	virtual void run(const uicore::CanvasPtr &canvas, std::vector<BenchmarkResult> &results) = 0;
+
+protected:
+	// Runs func the specified number of times and returns the average time per iteration in microseconds
+	static double time_per_iteration(int iterations, const std::function<void()> &func);
+};
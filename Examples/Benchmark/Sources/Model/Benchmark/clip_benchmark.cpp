@@ -0,0 +1,42 @@
+
+#include "precomp.h"
+#include "clip_benchmark.h"
+
+using namespace uicore;
+
+void ClipBenchmark::run(const CanvasPtr &canvas, std::vector<BenchmarkResult> &results)
+{
+	lists.render(canvas, 0);
+	canvas->end();
+	canvas->begin();
+
+	// The same scrolling lists, with clip changes kept inside the batch and with a flush for every clip change
+	bool default_batched_clipping = canvas->batched_clipping();
+	bool default_stats_enabled = canvas->stats_enabled();
+	canvas->set_stats_enabled(true);
+	for (bool batched_clipping : { true, false })
+	{
+		canvas->set_batched_clipping(batched_clipping);
+		std::string clip_name = batched_clipping ? "batched clipping" : "scissor clipping";
+
+		int frame = 0;
+		int total_draw_calls = 0;
+		int total_clip_flushes = 0;
+		double frame_time = time_per_iteration(frames_per_test, [&]()
+		{
+			lists.render(canvas, frame++);
+			canvas->end();
+			total_draw_calls += canvas->stats().draw_calls;
+			total_clip_flushes += canvas->stats().clip_change_flushes;
+			canvas->begin();
+		});
+		double frame_draw_calls = total_draw_calls / (double)frames_per_test;
+		double frame_clip_flushes = total_clip_flushes / (double)frames_per_test;
+
+		results.push_back(BenchmarkResult(string_format("%1, %2", lists.name(), clip_name), frame_time / 1000.0, "ms/frame"));
+		results.push_back(BenchmarkResult(string_format("%1, %2 draw calls", lists.name(), clip_name), frame_draw_calls, "calls/frame"));
+		results.push_back(BenchmarkResult(string_format("%1, %2 clip change flushes", lists.name(), clip_name), frame_clip_flushes, "flushes/frame"));
+	}
+	canvas->set_batched_clipping(default_batched_clipping);
+	canvas->set_stats_enabled(default_stats_enabled);
+}
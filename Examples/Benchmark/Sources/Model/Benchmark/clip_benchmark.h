@@ -0,0 +1,16 @@
+#pragma once
+
+#include "benchmark.h"
+#include "Model/Scenes/list_scene.h"
+
+class ClipBenchmark : public Benchmark
+{
+public:
+	std::string name() const override { return "Clip"; }
+	void run(const uicore::CanvasPtr &canvas, std::vector<BenchmarkResult> &results) override;
+
+private:
+	ListScene lists;
+
+	static const int frames_per_test = 20;
+};
@@ -0,0 +1,77 @@
+
+#include "precomp.h"
+#include "font_benchmark.h"
+
+using namespace uicore;
+
+void FontBenchmark::run(const CanvasPtr &canvas, std::vector<BenchmarkResult> &results)
+{
+	for (int glyph_count : { 100, 1000, 10000 })
+	{
+		// A new font gets its own glyph cache, so the cache holds exactly glyph_count glyphs
+		auto font = Font::create("Segoe UI", 13.0f);
+		std::string text = glyph_text(glyph_count);
+		font->measure_text(canvas, text);
+
+		int iterations = std::max(glyphs_per_test / glyph_count, 1);
+
+		double measure_time = time_per_iteration(iterations, [&]() { font->measure_text(canvas, text); });
+		results.push_back(BenchmarkResult(string_format("measure_text, %1 cached glyphs", glyph_count), glyph_count / measure_time, "Mglyphs/s"));
+
+		double draw_time = time_per_iteration(iterations, [&]() { font->draw_text(canvas, Pointf(0.0f, 20.0f), text, StandardColorf::black()); });
+		results.push_back(BenchmarkResult(string_format("draw_text, %1 cached glyphs", glyph_count), glyph_count / draw_time, "Mglyphs/s"));
+	}
+
+	// What a text area does every frame: measure each visible line again
+	auto font = Font::create("Segoe UI", 13.0f);
+	std::vector<std::string> lines;
+	for (int i = 0; i < text_area_lines; i++)
+		lines.push_back(string_format("%1: The quick brown fox jumps over the lazy dog", i));
+	font->measure_texts(canvas, lines);
+
+	int iterations = std::max(glyphs_per_test / (text_area_lines * (int)lines[0].length()), 1);
+	double lines_time = time_per_iteration(iterations, [&]() { font->measure_texts(canvas, lines); });
+	results.push_back(BenchmarkResult(string_format("measure_texts, %1 repeated lines", text_area_lines), text_area_lines / lines_time, "Mlines/s"));
+
+	// A screen full of text, drawn with the compact quad vertices and with the full sprite vertices
+	std::vector<std::string> screen_lines;
+	for (int glyphs = 0; glyphs < screen_glyphs; glyphs += (int)lines[0].length())
+		screen_lines.push_back(lines[screen_lines.size() % lines.size()]);
+
+	bool default_compact_quads = canvas->compact_quads();
+	bool default_stats_enabled = canvas->stats_enabled();
+	canvas->set_stats_enabled(true);
+	for (bool compact_quads : { true, false })
+	{
+		canvas->set_compact_quads(compact_quads);
+		std::string vertex_name = compact_quads ? "compact quads" : "sprite vertices";
+
+		uint64_t total_bytes = 0;
+		double frame_time = time_per_iteration(frames_per_test, [&]()
+		{
+			for (size_t i = 0; i < screen_lines.size(); i++)
+				font->draw_text(canvas, Pointf((i / 100) * 300.0f, (i % 100) * 10.0f + 10.0f), screen_lines[i], StandardColorf::black());
+			canvas->end();
+			total_bytes += canvas->stats().vertex_bytes;
+			canvas->begin();
+		});
+		double frame_bytes = total_bytes / (double)frames_per_test;
+
+		results.push_back(BenchmarkResult(string_format("%1 glyph screen, %2", screen_glyphs, vertex_name), frame_time / 1000.0, "ms/frame"));
+		results.push_back(BenchmarkResult(string_format("%1 glyph screen, %2 upload", screen_glyphs, vertex_name), frame_bytes / 1024.0, "KB/frame"));
+	}
+	canvas->set_compact_quads(default_compact_quads);
+	canvas->set_stats_enabled(default_stats_enabled);
+}
+
+std::string FontBenchmark::glyph_text(int glyph_count)
+{
+	// Printable latin first, then CJK ideographs, so large counts exercise the hashed part of the cache
+	std::string text;
+	for (int i = 0; i < glyph_count; i++)
+	{
+		unsigned int code_point = (i < 95) ? 32 + i : 0x4e00 + (i - 95);
+		text += Text::from_utf32(code_point);
+	}
+	return text;
+}
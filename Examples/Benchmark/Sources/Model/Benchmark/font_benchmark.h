@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include "benchmark.h"
+
+class FontBenchmark : public Benchmark
+{
+public:
+	std::string name() const override { return "Font"; }
+	void run(const uicore::CanvasPtr &canvas, std::vector<BenchmarkResult> &results) override;
+
+private:
+	static std::string glyph_text(int glyph_count);
+
+	// Number of glyphs processed per timed test
+	static const int glyphs_per_test = 1000000;
+
+	// Visible lines in the simulated text area
+	static const int text_area_lines = 50;
+
+	// Glyphs drawn per frame in the screen test, and frames per timed test
+	static const int screen_glyphs = 20000;
+	static const int frames_per_test = 20;
+};
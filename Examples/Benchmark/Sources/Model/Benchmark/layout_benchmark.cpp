@@ -0,0 +1,67 @@
+#include "precomp.h"
+#include "layout_benchmark.h"
+
+using namespace uicore;
+
+// View tree laid out on demand rather than by a window, so only layout is timed
+class LayoutBenchmarkTree : public ViewTree
+{
+public:
+	LayoutBenchmarkTree(const CanvasPtr &canvas) : tree_canvas(canvas) { }
+
+	DisplayWindowPtr display_window() override { return nullptr; }
+	CanvasPtr canvas() const override { return tree_canvas; }
+
+	void layout(const Rectf &box) { update_layout(tree_canvas, box); }
+
+protected:
+	void set_needs_render() override { }
+	Pointf client_to_screen_pos(const Pointf &pos) override { return pos; }
+	Pointf screen_to_client_pos(const Pointf &pos) override { return pos; }
+
+private:
+	CanvasPtr tree_canvas;
+};
+
+void LayoutBenchmark::run(const CanvasPtr &canvas, std::vector<BenchmarkResult> &results)
+{
+	// Panels sized by their content are laid out together with the whole tree, fixed size panels are layout boundaries
+	measure("content sized panels", canvas, "layout: flex; flex-direction: column", results);
+	measure("fixed size panels", canvas, "width: 18px; height: 600px; layout: flex; flex-direction: column", results);
+}
+
+void LayoutBenchmark::measure(const std::string &test_name, const CanvasPtr &canvas, const std::string &panel_style, std::vector<BenchmarkResult> &results)
+{
+	LayoutBenchmarkTree tree(canvas);
+	tree.root_view()->style()->set("layout: flex; flex-direction: row");
+
+	std::shared_ptr<View> edited_leaf;
+	for (int i = 0; i < panels; i++)
+	{
+		auto panel = tree.add_child();
+		panel->style()->set(panel_style);
+		for (int j = 0; j < leaves_per_panel; j++)
+		{
+			auto leaf = panel->add_child();
+			leaf->style()->set("height: 4px; margin: 1px 2px; background: rgb(200,200,200)");
+			if (i == panels / 2 && j == leaves_per_panel / 2)
+				edited_leaf = leaf;
+		}
+	}
+
+	Rectf box(0.0f, 0.0f, 1920.0f, 1080.0f);
+	double full_layout_time = time_per_iteration(1, [&]() { tree.layout(box); });
+
+	bool tall = false;
+	double relayout_time = time_per_iteration(relayouts_per_test, [&]()
+	{
+		tall = !tall;
+		edited_leaf->style()->set(tall ? "height: 6px" : "height: 4px");
+		edited_leaf->set_needs_layout();
+		tree.layout(box);
+	});
+
+	int views = panels * (leaves_per_panel + 1);
+	results.push_back(BenchmarkResult(string_format("first layout of %1 views, %2", views, test_name), full_layout_time / 1000.0, "ms"));
+	results.push_back(BenchmarkResult(string_format("relayout after one leaf changed, %1", test_name), relayout_time / 1000.0, "ms"));
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "benchmark.h"
+
+class LayoutBenchmark : public Benchmark
+{
+public:
+	std::string name() const override { return "Layout"; }
+	void run(const uicore::CanvasPtr &canvas, std::vector<BenchmarkResult> &results) override;
+
+private:
+	void measure(const std::string &test_name, const uicore::CanvasPtr &canvas, const std::string &panel_style, std::vector<BenchmarkResult> &results);
+
+	// The tree has panels * leaves_per_panel leaf views
+	static const int panels = 100;
+	static const int leaves_per_panel = 100;
+
+	// Leaf edits per timed test, each followed by a relayout
+	static const int relayouts_per_test = 200;
+};
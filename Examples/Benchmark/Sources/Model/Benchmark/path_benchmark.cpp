@@ -0,0 +1,272 @@
+
+#include "precomp.h"
+#include "path_benchmark.h"
+#include "Model/Svg/svg.h"
+#include <random>
+
+using namespace uicore;
+
+const char *PathBenchmark::svg_filename = "../SvgViewer/Resources/tiger.svg";
+
+void PathBenchmark::run(const CanvasPtr &canvas, std::vector<BenchmarkResult> &results)
+{
+	Svg svg(svg_filename);
+
+	// Rasterize every frame, except where the cache is measured
+	size_t default_cache_budget = canvas->path_cache_budget();
+	canvas->set_path_cache_budget(0);
+
+	// Icon size, window size and zoomed in: curve flattening should adapt to each
+	for (float height : { 32.0f, 500.0f, 4000.0f })
+	{
+		Rectf viewbox(0.0f, 0.0f, height, height);
+		svg.render(canvas, viewbox);
+
+		double frame_time = time_per_iteration(frames_per_test, [&]()
+		{
+			svg.render(canvas, viewbox);
+			canvas->end();
+			canvas->begin();
+		});
+		results.push_back(BenchmarkResult(string_format("tiger.svg fill, %1 px", (int)height), frame_time / 1000.0, "ms/frame"));
+		add_outline_results(canvas, string_format("tiger.svg fill, %1 px", (int)height), [&]() { svg.render(canvas, viewbox); }, results);
+	}
+
+	// Compare the coverage rasterizers on the same corpus
+	PathRasterizer default_rasterizer = canvas->path_rasterizer();
+	int default_threads = canvas->path_rasterizer_threads();
+	for (const auto &entry : create_corpus(canvas, svg))
+	{
+		add_outline_results(canvas, entry.name, entry.draw, results);
+		for (const auto &config : rasterizer_configs(default_cache_budget))
+		{
+			canvas->set_path_rasterizer(config.rasterizer);
+			canvas->set_path_rasterizer_threads(config.threads);
+			canvas->set_path_cache_budget(config.cache_budget);
+			entry.draw();
+
+			PathCacheStats start_stats = canvas->path_cache_stats();
+
+			double frame_time = time_per_iteration(frames_per_test, [&]()
+			{
+				entry.draw();
+				canvas->end();
+				canvas->begin();
+			});
+			results.push_back(BenchmarkResult(string_format("%1, %2", entry.name, config.name), frame_time / 1000.0, "ms/frame"));
+
+			if (config.cache_budget > 0)
+			{
+				// An unchanged drawing should never be rasterized again
+				PathCacheStats stats = canvas->path_cache_stats();
+				uint64_t hits = stats.hits - start_stats.hits;
+				uint64_t misses = stats.misses - start_stats.misses;
+				results.push_back(BenchmarkResult(string_format("%1, %2 hit rate", entry.name, config.name), hits * 100.0 / std::max(hits + misses, (uint64_t)1), "%"));
+			}
+		}
+	}
+	canvas->set_path_rasterizer(default_rasterizer);
+	canvas->set_path_rasterizer_threads(default_threads);
+
+	// Stroke chart gridlines: a few thousand short polylines, solid and dashed, in one path and in a path per line
+	Sizef size = canvas->size();
+	auto gridlines = create_gridlines(size, num_gridlines);
+	std::vector<PathPtr> gridline_paths;
+	for (int i = 0; i < num_gridlines; i++)
+		gridline_paths.push_back(create_gridlines(size, 1, i));
+
+	Pen solid(Colorf(0.5f, 0.5f, 0.5f, 1.0f), 1.0f);
+	Pen dashed = solid;
+	dashed.dashes = { 4.0f, 3.0f };
+	Pen dotted(Colorf(0.5f, 0.5f, 0.5f, 1.0f), 2.0f);
+	dotted.cap = PenCap::round;
+	dotted.dashes = { 0.0f, 6.0f };
+
+	std::vector<std::pair<std::string, Pen>> pens = { { "solid", solid }, { "dashed", dashed }, { "dotted", dotted } };
+	for (const auto &pen : pens)
+	{
+		add_outline_results(canvas, string_format("%1 gridlines, %2", num_gridlines, pen.first), [&]() { gridlines->stroke(canvas, pen.second); }, results);
+		for (size_t cache_budget : { (size_t)0, default_cache_budget })
+		{
+			canvas->set_path_cache_budget(cache_budget);
+			std::string cache_name = cache_budget > 0 ? "cached" : "uncached";
+
+			double frame_time = time_per_iteration(frames_per_test, [&]()
+			{
+				gridlines->stroke(canvas, pen.second);
+				canvas->end();
+				canvas->begin();
+			});
+			results.push_back(BenchmarkResult(string_format("%1 gridlines, %2, %3", num_gridlines, pen.first, cache_name), frame_time / 1000.0, "ms/frame"));
+
+			frame_time = time_per_iteration(frames_per_test, [&]()
+			{
+				for (const auto &path : gridline_paths)
+					path->stroke(canvas, pen.second);
+				canvas->end();
+				canvas->begin();
+			});
+			results.push_back(BenchmarkResult(string_format("%1 gridline paths, %2, %3", num_gridlines, pen.first, cache_name), frame_time / 1000.0, "ms/frame"));
+		}
+	}
+	canvas->set_path_cache_budget(default_cache_budget);
+}
+
+void PathBenchmark::add_outline_results(const CanvasPtr &canvas, const std::string &name, const std::function<void()> &draw, std::vector<BenchmarkResult> &results)
+{
+	// The stats are reset by begin, so the drawing gets a frame of its own. Masks found in the cache are not flattened
+	bool default_stats_enabled = canvas->stats_enabled();
+	size_t default_cache_budget = canvas->path_cache_budget();
+	canvas->set_stats_enabled(true);
+	canvas->set_path_cache_budget(0);
+
+	canvas->end();
+	canvas->begin();
+	draw();
+	canvas->end();
+	CanvasStats stats = canvas->stats();
+	canvas->begin();
+
+	canvas->set_stats_enabled(default_stats_enabled);
+	canvas->set_path_cache_budget(default_cache_budget);
+
+	results.push_back(BenchmarkResult(string_format("%1 vertices", name), stats.path_vertices, "vertices/frame"));
+	results.push_back(BenchmarkResult(string_format("%1 edges", name), stats.path_edges, "edges/frame"));
+}
+
+std::vector<PathBenchmark::RasterizerConfig> PathBenchmark::rasterizer_configs(size_t cache_budget)
+{
+	std::vector<RasterizerConfig> configs;
+	configs.push_back(RasterizerConfig("analytic", PathRasterizer::analytic, 1, 0));
+	configs.push_back(RasterizerConfig(string_format("analytic, %1 threads", System::num_cores()), PathRasterizer::analytic, 0, 0));
+	configs.push_back(RasterizerConfig("analytic, cached", PathRasterizer::analytic, 1, cache_budget));
+	configs.push_back(RasterizerConfig("supersampled", PathRasterizer::supersampled, 1, 0));
+	return configs;
+}
+
+std::vector<PathBenchmark::CorpusEntry> PathBenchmark::create_corpus(const CanvasPtr &canvas, Svg &svg)
+{
+	Sizef size = canvas->size();
+	Brush brush(Colorf(0.2f, 0.4f, 0.8f, 0.5f));
+
+	auto map_polygon = create_map_polygon(size);
+	auto star_alternate = create_star(size, PathFillMode::alternate);
+	auto star_winding = create_star(size, PathFillMode::winding);
+	auto circles = create_circles(size);
+	auto chart = create_chart(size);
+
+	std::vector<CorpusEntry> corpus;
+	corpus.push_back(CorpusEntry("tiger.svg", [=, &svg]() { svg.render(canvas, Rectf(0.0f, 0.0f, size.height, size.height)); }));
+	corpus.push_back(CorpusEntry("map polygon", [=]() { map_polygon->fill(canvas, brush); }));
+	corpus.push_back(CorpusEntry("star, alternate", [=]() { star_alternate->fill(canvas, brush); }));
+	corpus.push_back(CorpusEntry("star, winding", [=]() { star_winding->fill(canvas, brush); }));
+	corpus.push_back(CorpusEntry("circles", [=]() { circles->fill(canvas, brush); }));
+	corpus.push_back(CorpusEntry("chart", [=]() { chart->fill(canvas, brush); }));
+	return corpus;
+}
+
+PathPtr PathBenchmark::create_map_polygon(const Sizef &size)
+{
+	// A coastline like outline with a jagged edge
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> jitter(0.9f, 1.1f);
+
+	const int num_points = 20000;
+	Pointf center(size.width * 0.5f, size.height * 0.5f);
+	Sizef radius(size.width * 0.45f, size.height * 0.45f);
+
+	auto path = Path::create();
+	for (int i = 0; i < num_points; i++)
+	{
+		float angle = i * 2.0f * PI / num_points;
+		float scale = jitter(random);
+		Pointf point(center.x + std::cos(angle) * radius.width * scale, center.y + std::sin(angle) * radius.height * scale);
+		if (i == 0)
+			path->move_to(point);
+		else
+			path->line_to(point);
+	}
+	path->close();
+	return path;
+}
+
+PathPtr PathBenchmark::create_star(const Sizef &size, PathFillMode mode)
+{
+	// Every edge crosses many others, so the fill mode decides which regions are inside
+	const int num_points = 25;
+	const int step = 12;
+	Pointf center(size.width * 0.5f, size.height * 0.5f);
+	float radius = std::min(size.width, size.height) * 0.48f;
+
+	auto path = Path::create();
+	path->set_fill_mode(mode);
+	for (int i = 0; i < num_points; i++)
+	{
+		float angle = ((i * step) % num_points) * 2.0f * PI / num_points;
+		Pointf point(center.x + std::sin(angle) * radius, center.y - std::cos(angle) * radius);
+		if (i == 0)
+			path->move_to(point);
+		else
+			path->line_to(point);
+	}
+	path->close();
+	return path;
+}
+
+PathPtr PathBenchmark::create_circles(const Sizef &size)
+{
+	std::mt19937 random(2);
+	std::uniform_real_distribution<float> x(0.0f, size.width);
+	std::uniform_real_distribution<float> y(0.0f, size.height);
+	std::uniform_real_distribution<float> radius(2.0f, 100.0f);
+
+	auto path = Path::create();
+	path->set_fill_mode(PathFillMode::winding);
+	for (int i = 0; i < 200; i++)
+		path->add_circle(x(random), y(random), radius(random));
+	return path;
+}
+
+PathPtr PathBenchmark::create_chart(const Sizef &size)
+{
+	// An area chart with a dense data series, plus thin bars below it
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> value(0.2f, 0.5f);
+
+	const int num_samples = 2000;
+	auto path = Path::create();
+	path->move_to(0.0f, size.height * 0.5f);
+	for (int i = 0; i <= num_samples; i++)
+		path->line_to(i * size.width / num_samples, size.height * value(random));
+	path->line_to(size.width, size.height * 0.5f);
+	path->close();
+
+	const int num_bars = 300;
+	for (int i = 0; i < num_bars; i++)
+	{
+		float bar_height = size.height * 0.4f * value(random);
+		path->add_rect(Rectf(i * size.width / num_bars, size.height - bar_height, Sizef(1.5f, bar_height)));
+	}
+	return path;
+}
+
+PathPtr PathBenchmark::create_gridlines(const Sizef &size, int count, int first)
+{
+	// Horizontal and vertical lines alternate, each split into a few segments like a chart with tick marks
+	const int segments_per_line = 4;
+	const int lines_per_direction = (num_gridlines + 1) / 2;
+
+	auto path = Path::create();
+	for (int i = first; i < first + count; i++)
+	{
+		bool horizontal = i % 2 == 0;
+		float t = (i / 2 + 0.5f) / lines_per_direction;
+		Pointf start = horizontal ? Pointf(0.0f, size.height * t) : Pointf(size.width * t, 0.0f);
+		Pointf end = horizontal ? Pointf(size.width, size.height * t) : Pointf(size.width * t, size.height);
+
+		path->move_to(start);
+		for (int j = 1; j <= segments_per_line; j++)
+			path->line_to(start + (end - start) * (j / (float)segments_per_line));
+	}
+	return path;
+}
@@ -0,0 +1,57 @@
+
+#pragma once
+
+#include "benchmark.h"
+
+class Svg;
+
+class PathBenchmark : public Benchmark
+{
+public:
+	std::string name() const override { return "Path"; }
+	void run(const uicore::CanvasPtr &canvas, std::vector<BenchmarkResult> &results) override;
+
+private:
+	class CorpusEntry
+	{
+	public:
+		CorpusEntry(const std::string &name, std::function<void()> draw) : name(name), draw(draw) { }
+
+		std::string name;
+		std::function<void()> draw;
+	};
+
+	class RasterizerConfig
+	{
+	public:
+		RasterizerConfig(const std::string &name, uicore::PathRasterizer rasterizer, int threads, size_t cache_budget) : name(name), rasterizer(rasterizer), threads(threads), cache_budget(cache_budget) { }
+
+		std::string name;
+		uicore::PathRasterizer rasterizer;
+		int threads;
+		size_t cache_budget;
+	};
+
+	static std::vector<RasterizerConfig> rasterizer_configs(size_t cache_budget);
+
+	// Adds the number of points and lines a drawing was flattened into, as curve flattening decides how much the rasterizers have to do
+	static void add_outline_results(const uicore::CanvasPtr &canvas, const std::string &name, const std::function<void()> &draw, std::vector<BenchmarkResult> &results);
+
+	// Shapes that stress path filling in different ways: many edges, self intersections, many small paths and thin slivers
+	static std::vector<CorpusEntry> create_corpus(const uicore::CanvasPtr &canvas, Svg &svg);
+
+	static uicore::PathPtr create_map_polygon(const uicore::Sizef &size);
+	static uicore::PathPtr create_star(const uicore::Sizef &size, uicore::PathFillMode mode);
+	static uicore::PathPtr create_circles(const uicore::Sizef &size);
+	static uicore::PathPtr create_chart(const uicore::Sizef &size);
+	static uicore::PathPtr create_gridlines(const uicore::Sizef &size, int count, int first = 0);
+
+	// Path data of the SvgViewer example
+	static const char *svg_filename;
+
+	// Number of times the drawing is filled per timed test
+	static const int frames_per_test = 20;
+
+	// Number of polylines in the stroke test
+	static const int num_gridlines = 2000;
+};
@@ -0,0 +1,87 @@
+#include "precomp.h"
+#include "render_benchmark.h"
+#include "Model/Scenes/glyph_scene.h"
+#include "Model/Scenes/list_scene.h"
+#include "Model/Scenes/svg_scene.h"
+#include "Model/Scenes/view_scene.h"
+#include "View/Scenes/flex_scene_view.h"
+#include "View/Scenes/form_scene_view.h"
+
+using namespace uicore;
+
+void RenderBenchmark::run(const CanvasPtr &canvas, std::vector<BenchmarkResult> &results)
+{
+	// The offscreen canvases bind their own frame buffers, so the window canvas must not be in a frame meanwhile
+	canvas->end();
+
+	Size image_size(image_width, image_height);
+	run_target("gpu", OffscreenCanvas::create(canvas->gc(), image_size), results);
+	run_target("software", OffscreenCanvas::create(image_size), results);
+
+	canvas->begin();
+}
+
+void RenderBenchmark::run_target(const std::string &target_name, const OffscreenCanvasPtr &offscreen, std::vector<BenchmarkResult> &results)
+{
+	const CanvasPtr &canvas = offscreen->canvas();
+	canvas->set_stats_enabled(true);
+
+	double frame_pixels = offscreen->size().width * (double)offscreen->size().height;
+
+	for (const auto &scene : create_scenes())
+	{
+		std::string test_name = string_format("%1, %2", target_name, scene->name());
+
+		int frame = 0;
+		for (int i = 0; i < warmup_frames; i++)
+		{
+			canvas->begin();
+			canvas->clear(Colorf(1.0f, 1.0f, 1.0f));
+			scene->render(canvas, frame++);
+			canvas->end();
+		}
+
+		int total_draw_calls = 0;
+		int total_state_changes = 0;
+		int total_state_changes_elided = 0;
+		double frame_time = time_per_iteration(frames_per_test, [&]()
+		{
+			canvas->gc()->reset_state_stats();
+			canvas->begin();
+			canvas->clear(Colorf(1.0f, 1.0f, 1.0f));
+			scene->render(canvas, frame++);
+			canvas->end();
+			total_draw_calls += canvas->stats().draw_calls;
+			total_state_changes += canvas->gc()->state_stats().issued();
+			total_state_changes_elided += canvas->gc()->state_stats().elided();
+		});
+
+		// Includes waiting for the GPU to finish the frames queued above
+		double readback_time = time_per_iteration(1, [&]()
+		{
+			offscreen->start_readback();
+			offscreen->pixels();
+		});
+
+		results.push_back(BenchmarkResult(test_name, frame_time / 1000.0, "ms/frame"));
+		results.push_back(BenchmarkResult(string_format("%1 draw calls", test_name), total_draw_calls / (double)frames_per_test, "calls/frame"));
+		if (total_state_changes + total_state_changes_elided > 0)
+		{
+			results.push_back(BenchmarkResult(string_format("%1 state changes", test_name), total_state_changes / (double)frames_per_test, "calls/frame"));
+			results.push_back(BenchmarkResult(string_format("%1 redundant state changes skipped", test_name), total_state_changes_elided / (double)frames_per_test, "calls/frame"));
+		}
+		results.push_back(BenchmarkResult(string_format("%1 fill rate", test_name), frame_pixels / frame_time, "Mpixels/s"));
+		results.push_back(BenchmarkResult(string_format("%1 readback", test_name), readback_time / 1000.0, "ms"));
+	}
+}
+
+std::vector<std::shared_ptr<RenderScene>> RenderBenchmark::create_scenes()
+{
+	std::vector<std::shared_ptr<RenderScene>> scenes;
+	scenes.push_back(std::make_shared<ViewScene>("flex layout", []() { return std::make_shared<FlexSceneView>(); }));
+	scenes.push_back(std::make_shared<ViewScene>("form", []() { return std::make_shared<FormSceneView>(); }));
+	scenes.push_back(std::make_shared<SvgScene>("../SvgViewer/Resources/tiger.svg"));
+	scenes.push_back(std::make_shared<GlyphScene>());
+	scenes.push_back(std::make_shared<ListScene>());
+	return scenes;
+}
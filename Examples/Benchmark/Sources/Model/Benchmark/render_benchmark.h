@@ -0,0 +1,23 @@
+#pragma once
+
+#include "benchmark.h"
+
+class RenderScene;
+
+class RenderBenchmark : public Benchmark
+{
+public:
+	std::string name() const override { return "Render"; }
+	void run(const uicore::CanvasPtr &canvas, std::vector<BenchmarkResult> &results) override;
+
+private:
+	void run_target(const std::string &target_name, const uicore::OffscreenCanvasPtr &offscreen, std::vector<BenchmarkResult> &results);
+	static std::vector<std::shared_ptr<RenderScene>> create_scenes();
+
+	// Size of the offscreen image the scenes are rendered into
+	static const int image_width = 1024;
+	static const int image_height = 768;
+
+	static const int warmup_frames = 3;
+	static const int frames_per_test = 20;
+};
@@ -0,0 +1,69 @@
+#include "precomp.h"
+#include "style_benchmark.h"
+
+using namespace uicore;
+
+void StyleBenchmark::run(const CanvasPtr &canvas, std::vector<BenchmarkResult> &results)
+{
+	// A chain of views where each level has an element style and two shared rule styles, like a view tree styled by a stylesheet
+	Style root_style;
+	root_style.set("font: 13px/20px 'Segoe UI'; color: rgb(0,0,0); background: white");
+
+	Style rule_style;
+	rule_style.set("flex: auto; margin: 2px 4px; padding: 3px 6px; border: 1px solid rgb(200,200,200); border-radius: 3px");
+
+	Style hover_style;
+	hover_style.set("background: rgb(230,240,250)");
+
+	std::vector<std::unique_ptr<Style>> element_styles;
+	std::vector<std::unique_ptr<StyleCascade>> cascades;
+	cascades.push_back(std::unique_ptr<StyleCascade>(new StyleCascade({ &root_style })));
+	for (int level = 0; level < tree_depth; level++)
+	{
+		element_styles.push_back(std::unique_ptr<Style>(new Style()));
+		element_styles.back()->set("width: %1px; padding-left: 1em", 100 + level);
+		cascades.push_back(std::unique_ptr<StyleCascade>(new StyleCascade({ element_styles.back().get(), &hover_style, &rule_style }, cascades.back().get())));
+	}
+	const StyleCascade &leaf = *cascades.back();
+
+	// Box and flex properties queried during layout, mostly not inherited
+	measure("layout properties", leaf, {
+		"width", "height", "margin-left", "margin-top", "margin-right", "margin-bottom",
+		"padding-left", "padding-top", "padding-right", "padding-bottom",
+		"border-left-width", "border-top-width", "flex-grow", "flex-shrink", "flex-basis", "position"
+	}, *cascades.front(), results);
+
+	// Inherited text properties resolved through the parent chain
+	measure("inherited properties", leaf, { "color", "font-size", "line-height", "font-weight", "text-align", "font-family-names[0]" }, *cascades.front(), results);
+
+	// Undeclared properties falling back to their initial values
+	measure("initial values", leaf, { "min-width", "max-width", "left", "top", "z-index", "box-shadow[0]" }, *cascades.front(), results);
+}
+
+void StyleBenchmark::measure(const std::string &test_name, const StyleCascade &cascade, const std::vector<std::string> &properties, StyleCascade &root, std::vector<BenchmarkResult> &results)
+{
+	std::vector<const char *> names;
+	for (const auto &property : properties)
+		names.push_back(property.c_str());
+
+	// Repeated queries are answered from the computed value cache. Invalidating the root cascade, as a state change
+	// on the root view would, forces the inherited values to be resolved again.
+	float sum = 0.0f;
+	int iterations = queries_per_test / (int)names.size();
+	for (bool root_changes : { false, true })
+	{
+		double iteration_time = time_per_iteration(iterations, [&]()
+		{
+			if (root_changes)
+				root.invalidate();
+			for (const char *name : names)
+				sum += cascade.computed_value(name).number();
+		});
+
+		std::string change_name = root_changes ? ", root changed every pass" : "";
+		results.push_back(BenchmarkResult(string_format("computed_value, %1%2", test_name, change_name), names.size() * 1000000.0 / std::max(iteration_time, 0.001), "queries/s"));
+	}
+
+	if (sum == 42.0f) // Keeps the queries from being optimized away
+		results.back().unit += " ";
+}
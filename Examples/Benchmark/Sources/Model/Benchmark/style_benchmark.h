@@ -0,0 +1,19 @@
+#pragma once
+
+#include "benchmark.h"
+
+class StyleBenchmark : public Benchmark
+{
+public:
+	std::string name() const override { return "Style"; }
+	void run(const uicore::CanvasPtr &canvas, std::vector<BenchmarkResult> &results) override;
+
+private:
+	void measure(const std::string &test_name, const uicore::StyleCascade &cascade, const std::vector<std::string> &properties, uicore::StyleCascade &root, std::vector<BenchmarkResult> &results);
+
+	// Depth of the parent chain below the root cascade
+	static const int tree_depth = 8;
+
+	// Property lookups per timed test
+	static const int queries_per_test = 1000000;
+};
@@ -0,0 +1,31 @@
+#include "precomp.h"
+#include "glyph_scene.h"
+
+using namespace uicore;
+
+void GlyphScene::render(const CanvasPtr &canvas, int frame)
+{
+	const float line_height = 12.0f;
+	const float column_width = 500.0f;
+	const int lines_per_column = (num_lines + 1) / 2;
+
+	if (!font)
+	{
+		font = Font::create("Segoe UI", 11.0f);
+
+		const std::string alphabet = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456789 .,;:(){}";
+		for (int i = 0; i < num_lines; i++)
+		{
+			std::string line;
+			for (int j = 0; j < chars_per_line; j++)
+				line.push_back(alphabet[(i * 7 + j) % alphabet.size()]);
+			lines.push_back(line);
+		}
+	}
+
+	for (int i = 0; i < num_lines; i++)
+	{
+		Pointf pos((i / lines_per_column) * column_width, (i % lines_per_column + 1) * line_height);
+		font->draw_text(canvas, pos, lines[i], Colorf(0.0f, 0.0f, 0.0f));
+	}
+}
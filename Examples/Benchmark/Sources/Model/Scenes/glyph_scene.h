@@ -0,0 +1,18 @@
+#pragma once
+
+#include "render_scene.h"
+
+// A screen full of small text, like a log view or a code editor
+class GlyphScene : public RenderScene
+{
+public:
+	std::string name() const override { return uicore::string_format("%1 glyphs", num_lines * chars_per_line); }
+	void render(const uicore::CanvasPtr &canvas, int frame) override;
+
+	static const int num_lines = 125;
+	static const int chars_per_line = 80;
+
+private:
+	uicore::FontPtr font;
+	std::vector<std::string> lines;
+};
@@ -0,0 +1,44 @@
+#include "precomp.h"
+#include "list_scene.h"
+
+using namespace uicore;
+
+void ListScene::render(const CanvasPtr &canvas, int frame)
+{
+	const float list_width = 240.0f;
+	const float list_height = 600.0f;
+	const float row_height = 18.0f;
+
+	if (!font)
+		font = Font::create("Segoe UI", 13.0f);
+
+	float scroll = frame * 3.5f;
+
+	for (int list = 0; list < num_lists; list++)
+	{
+		Rectf list_box = Rectf::xywh(list * (list_width + 10.0f), 0.0f, list_width, list_height);
+		canvas->push_clip(list_box);
+
+		for (int row = 0; row < rows_per_list; row++)
+		{
+			// Row, then an icon cell and a text cell nested inside it, like a list view item
+			Rectf row_box = Rectf::xywh(list_box.left, list_box.top + row * row_height - scroll, list_width, row_height);
+			canvas->push_clip(row_box);
+			Path::rect(row_box)->fill(canvas, Brush(row % 2 ? Colorf(0.95f, 0.95f, 0.95f) : Colorf(1.0f, 1.0f, 1.0f)));
+
+			Rectf icon_box = Rectf::xywh(row_box.left + 2.0f, row_box.top + 2.0f, 14.0f, 14.0f);
+			canvas->push_clip(icon_box);
+			Path::rect(icon_box.left - 2.0f, icon_box.top - 2.0f, 18.0f, 18.0f)->fill(canvas, Brush(Colorf(0.2f, 0.4f, 0.8f)));
+			canvas->pop_clip();
+
+			Rectf text_box = Rectf::xywh(row_box.left + 20.0f, row_box.top, 120.0f, row_height);
+			canvas->push_clip(text_box);
+			font->draw_text(canvas, Pointf(text_box.left, text_box.top + 14.0f), string_format("Item %1 with a label that is too long for its cell", row), Colorf(0.0f, 0.0f, 0.0f));
+			canvas->pop_clip();
+
+			canvas->pop_clip();
+		}
+
+		canvas->pop_clip();
+	}
+}
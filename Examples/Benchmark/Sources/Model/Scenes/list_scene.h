@@ -0,0 +1,20 @@
+#pragma once
+
+#include "render_scene.h"
+
+// Scrolling list views side by side, with a clip rect for every row and cell
+class ListScene : public RenderScene
+{
+public:
+	std::string name() const override { return uicore::string_format("%1 clipped list rows", num_rows()); }
+	void render(const uicore::CanvasPtr &canvas, int frame) override;
+
+	static int num_rows() { return num_lists * rows_per_list; }
+
+private:
+	// Lists side by side, and the rows in each of them
+	static const int num_lists = 10;
+	static const int rows_per_list = 100;
+
+	uicore::FontPtr font;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+// Canned content drawn by the render benchmarks, one frame at a time
+class RenderScene
+{
+public:
+	virtual ~RenderScene() { }
+
+	virtual std::string name() const = 0;
+
+	// Draws one frame between Canvas::begin() and Canvas::end(). Animated scenes use frame to change what they draw.
+	virtual void render(const uicore::CanvasPtr &canvas, int frame) = 0;
+};
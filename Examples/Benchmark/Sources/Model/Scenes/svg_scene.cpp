@@ -0,0 +1,18 @@
+#include "precomp.h"
+#include "svg_scene.h"
+#include "Model/Svg/svg.h"
+
+using namespace uicore;
+
+SvgScene::SvgScene(const std::string &filename) : filename(filename)
+{
+}
+
+void SvgScene::render(const CanvasPtr &canvas, int frame)
+{
+	if (!svg)
+		svg = std::make_shared<Svg>(filename);
+
+	float size = std::min(canvas->width(), canvas->height());
+	svg->render(canvas, Rectf(0.0f, 0.0f, size, size));
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "render_scene.h"
+
+class Svg;
+
+// A large vector drawing, filled from scratch every frame unless the path cache keeps it
+class SvgScene : public RenderScene
+{
+public:
+	SvgScene(const std::string &filename);
+
+	std::string name() const override { return uicore::FilePath::filename(filename); }
+	void render(const uicore::CanvasPtr &canvas, int frame) override;
+
+private:
+	std::string filename;
+	std::shared_ptr<Svg> svg;
+};
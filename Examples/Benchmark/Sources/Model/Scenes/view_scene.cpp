@@ -0,0 +1,17 @@
+#include "precomp.h"
+#include "view_scene.h"
+
+using namespace uicore;
+
+void ViewScene::render(const CanvasPtr &canvas, int frame)
+{
+	if (!window)
+	{
+		window = std::make_shared<TextureWindow>(canvas);
+		window->set_viewport(Rectf(0.0f, 0.0f, canvas->size()));
+		window->set_always_render();
+		window->set_root_view(create_root_view());
+	}
+
+	window->update();
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "render_scene.h"
+
+// A view tree laid out and rendered into the canvas through a texture window, like a window showing a form
+class ViewScene : public RenderScene
+{
+public:
+	ViewScene(const std::string &name, const std::function<std::shared_ptr<uicore::View>()> &create_root_view) : scene_name(name), create_root_view(create_root_view) { }
+
+	std::string name() const override { return scene_name; }
+	void render(const uicore::CanvasPtr &canvas, int frame) override;
+
+private:
+	std::string scene_name;
+	std::function<std::shared_ptr<uicore::View>()> create_root_view;
+	std::shared_ptr<uicore::TextureWindow> window;
+};
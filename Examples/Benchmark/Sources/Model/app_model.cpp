@@ -0,0 +1,27 @@
+
+#include "precomp.h"
+#include "app_model.h"
+#include "Model/Benchmark/clip_benchmark.h"
+#include "Model/Benchmark/font_benchmark.h"
+#include "Model/Benchmark/path_benchmark.h"
+#include "Model/Benchmark/render_benchmark.h"
+#include "Model/Benchmark/style_benchmark.h"
+#include "Model/Benchmark/layout_benchmark.h"
+
+using namespace uicore;
+
+AppModel::AppModel()
+{
+	benchmarks.push_back(std::make_shared<FontBenchmark>());
+	benchmarks.push_back(std::make_shared<PathBenchmark>());
+	benchmarks.push_back(std::make_shared<ClipBenchmark>());
+	benchmarks.push_back(std::make_shared<RenderBenchmark>());
+	benchmarks.push_back(std::make_shared<StyleBenchmark>());
+	benchmarks.push_back(std::make_shared<LayoutBenchmark>());
+}
+
+AppModel *AppModel::instance()
+{
+	static AppModel model;
+	return &model;
+}
@@ -0,0 +1,15 @@
+
+#pragma once
+
+#include "Model/Benchmark/benchmark.h"
+
+class AppModel
+{
+public:
+	AppModel();
+
+	static AppModel *instance();
+
+	std::vector<std::shared_ptr<Benchmark>> benchmarks;
+	std::vector<BenchmarkResult> results;
+};
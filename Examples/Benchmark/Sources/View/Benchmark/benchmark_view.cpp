@@ -0,0 +1,55 @@
+
+#include "precomp.h"
+#include "benchmark_view.h"
+#include "Model/app_model.h"
+#include <iostream>
+
+using namespace uicore;
+
+BenchmarkView::BenchmarkView()
+{
+	style()->set("flex: auto");
+}
+
+void BenchmarkView::render_content(const CanvasPtr &canvas)
+{
+	if (!benchmarks_run)
+	{
+		benchmarks_run = true;
+		run_benchmarks(canvas);
+
+		// Redraw to replace whatever the benchmarks left on the canvas
+		set_needs_render();
+		return;
+	}
+
+	if (!font)
+		font = Font::create("Segoe UI", 13.0f);
+
+	float y = 20.0f;
+	for (const auto &result : AppModel::instance()->results)
+	{
+		font->draw_text(canvas, Pointf(0.0f, y), result.to_string(), StandardColorf::black());
+		y += 18.0f;
+	}
+}
+
+void BenchmarkView::run_benchmarks(const CanvasPtr &canvas)
+{
+	AppModel *model = AppModel::instance();
+	model->results.clear();
+
+	for (const auto &benchmark : model->benchmarks)
+	{
+		std::vector<BenchmarkResult> results;
+		benchmark->run(canvas, results);
+
+		for (const auto &result : results)
+		{
+			BenchmarkResult named_result = result;
+			named_result.name = benchmark->name() + " - " + result.name;
+			std::cout << named_result.to_string() << std::endl;
+			model->results.push_back(named_result);
+		}
+	}
+}
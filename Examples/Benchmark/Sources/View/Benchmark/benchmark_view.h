@@ -0,0 +1,17 @@
+
+#pragma once
+
+class BenchmarkView : public uicore::View
+{
+public:
+	BenchmarkView();
+
+protected:
+	void render_content(const uicore::CanvasPtr &canvas) override;
+
+private:
+	void run_benchmarks(const uicore::CanvasPtr &canvas);
+
+	bool benchmarks_run = false;
+	uicore::FontPtr font;
+};
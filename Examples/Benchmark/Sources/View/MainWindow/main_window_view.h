@@ -0,0 +1,19 @@
+
+#pragma once
+
+#include "View/Benchmark/benchmark_view.h"
+
+class MainWindowView : public uicore::ColumnView
+{
+public:
+	MainWindowView()
+	{
+		style()->set("background: rgb(240,240,240)");
+		style()->set("padding: 11px");
+		style()->set("font: 11px/15px 'Segoe UI'; color: black");
+
+		benchmark = add_child<BenchmarkView>();
+	}
+
+	std::shared_ptr<BenchmarkView> benchmark;
+};
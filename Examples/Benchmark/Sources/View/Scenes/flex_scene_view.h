@@ -0,0 +1,53 @@
+#pragma once
+
+// The kind of page shown by the FlexCheatSheet example: headlines, paragraphs and flex containers full of boxes
+class FlexSceneView : public uicore::RowView
+{
+public:
+	FlexSceneView()
+	{
+		using namespace uicore;
+
+		style()->set(R"(
+			background: rgb(250,250,250);
+			font: 11px/15px 'Segoe UI'; color: black
+			)");
+
+		auto panel = add_child<ColumnView>();
+		panel->style()->set("width: 200px; background: rgb(240,240,240); padding: 15px");
+
+		auto examples = add_child<ColumnView>();
+		examples->style()->set("flex: 1 1");
+
+		const char *container_styles[] =
+		{
+			"flex-direction: row; justify-content: flex-start",
+			"flex-direction: column; align-items: flex-end",
+			"flex-flow: row wrap; align-items: center; justify-content: center; align-content: flex-end"
+		};
+
+		for (auto container_style : container_styles)
+		{
+			auto button = panel->add_child<ButtonBaseView>();
+			button->style()->set("margin: 5px 0; padding: 2px 5px");
+			button->label()->set_text(container_style);
+
+			auto headline = examples->add_child<TextBlockBaseView>();
+			headline->style()->set("font-style: italic; font-size: 24px; line-height: 32px; margin: 15px; flex: none");
+			headline->add_text(container_style);
+
+			auto paragraph = examples->add_child<TextBlockBaseView>();
+			paragraph->style()->set("margin: 8px 15px; flex: none");
+			paragraph->add_text("Flex items are the children of a flex container. They are positioned along a main axis and a cross axis. The main axis is horizontal by default, so the items flow into a row.");
+
+			auto container = examples->add_child<View>();
+			container->style()->set("background-color: #dce7f2; border: 1px solid #2a4f73; margin: 15px; flex: none");
+			container->style()->set(container_style);
+			for (int i = 0; i < 6; i++)
+			{
+				auto box = container->add_child<View>();
+				box->style()->set("width: 60px; height: 40px; background-color: #e46119; border: 1px solid #626262; margin: 3px");
+			}
+		}
+	}
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+// The form shown by the ThemedForm example, styled without its theme images
+class FormSceneView : public uicore::ColumnView
+{
+public:
+	FormSceneView()
+	{
+		using namespace uicore;
+
+		style()->set(R"(
+			background: rgb(240,240,240);
+			padding: 11px;
+			font: 12px/15px 'Segoe UI';
+			color: black;
+			align-items: flex-start
+			)");
+
+		auto headline = add_child<TextBlockBaseView>();
+		headline->style()->set("font: 16px/40px 'Segoe UI'; color: rgb(0,51,153)");
+		headline->add_text("Form example with standard views");
+
+		auto paragraph = add_child<TextBlockBaseView>();
+		paragraph->style()->set("margin-bottom: 10px");
+		paragraph->add_text("This is an example of a form using the standard UICore views.");
+
+		auto button = add_child<ButtonBaseView>();
+		button->style()->set("background: rgb(225,225,225); border: 1px solid rgb(173,173,173); padding: 3px 10px");
+		button->label()->set_text("Test Button");
+
+		auto slider = add_child<SliderBaseView>();
+		slider->set_horizontal();
+		slider->style()->set("flex-direction: row; width: 300px; margin-top: 5px");
+		slider->track()->style()->set("flex: 1 1 auto; height: 4px; margin: 7px 0px; background: rgb(200,200,200)");
+		slider->thumb()->style()->set("position: absolute; width: 11px; height: 19px; background: rgb(0,120,215)");
+
+		for (int row = 0; row < 2; row++)
+		{
+			auto option_row = add_child<RowView>();
+			option_row->style()->set("margin: 5px 0; align-items: center");
+			for (auto text : { "Option 1", "Option 2", "Option 3" })
+			{
+				std::shared_ptr<View> option;
+				if (row == 0)
+					option = option_row->add_child<RadioButtonBaseView>();
+				else
+					option = option_row->add_child<CheckBoxBaseView>();
+				option->style()->set("width: 13px; height: 13px; margin-right: 5px; background: white; border: 1px solid rgb(51,51,51)");
+
+				auto label = option_row->add_child<LabelBaseView>();
+				label->style()->set("margin-right: 15px");
+				label->set_text(text);
+			}
+		}
+
+		auto textfield = add_child<TextFieldBaseView>();
+		textfield->style()->set("border: 1px solid #dadada; padding: 3px 9px 4px 10px; background: white");
+		textfield->set_placeholder("A Textfield");
+		textfield->set_preferred_size(40);
+	}
+};
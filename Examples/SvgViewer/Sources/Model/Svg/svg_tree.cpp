@@ -336,14 +336,14 @@ void SvgTreeBuilder::render_path(const PathPtr &path, const XmlNodePtr &e)
 	SvgAttributeReader fill_opacity(e, "fill-opacity");
 	SvgAttributeReader fill_rule(e, "fill-rule");
 
-	SvgAttributeReader stroke(e, "stroke");
-	SvgAttributeReader stroke_dasharray(e, "stroke-dasharray");
-	SvgAttributeReader stroke_dashoffset(e, "stroke-dashoffset");
-	SvgAttributeReader stroke_linecap(e, "stroke-linecap");
-	SvgAttributeReader stroke_linejoin(e, "stroke-linejoin");
-	SvgAttributeReader stroke_miterlimit(e, "stroke-miterlimit");
-	SvgAttributeReader stroke_opacity(e, "stroke-opacity");
-	SvgAttributeReader stroke_width(e, "stroke-width");
+	SvgAttributeReader stroke(e, "stroke", true);
+	SvgAttributeReader stroke_dasharray(e, "stroke-dasharray", true);
+	SvgAttributeReader stroke_dashoffset(e, "stroke-dashoffset", true);
+	SvgAttributeReader stroke_linecap(e, "stroke-linecap", true);
+	SvgAttributeReader stroke_linejoin(e, "stroke-linejoin", true);
+	SvgAttributeReader stroke_miterlimit(e, "stroke-miterlimit", true);
+	SvgAttributeReader stroke_opacity(e, "stroke-opacity", true);
+	SvgAttributeReader stroke_width(e, "stroke-width", true);
 
 	if (fill_rule.is_keyword("evenodd"))
 		path->set_fill_mode(PathFillMode::alternate);
@@ -362,13 +362,36 @@ void SvgTreeBuilder::render_path(const PathPtr &path, const XmlNodePtr &e)
 		path_node->fill = true;
 	}
 
-	if (!stroke.is_keyword("none"))
+	if (!stroke.is_end() && !stroke.is_keyword("none"))
 	{
 		double width = 1.0;
 		if (stroke_width.is_length())
 			width = stroke_width.get_length();
 
-		path_node->pen = Pen(Colorf::white, (float)width);
+		Pen pen(Colorf(0.0f, 0.0f, 0.0f), (float)width);
+		if (stroke.is_color())
+			pen.color = stroke.get_color();
+
+		if (stroke_linecap.is_keyword("round"))
+			pen.cap = PenCap::round;
+		else if (stroke_linecap.is_keyword("square"))
+			pen.cap = PenCap::square;
+
+		if (stroke_linejoin.is_keyword("round"))
+			pen.join = PenJoin::round;
+		else if (stroke_linejoin.is_keyword("bevel"))
+			pen.join = PenJoin::bevel;
+
+		if (stroke_miterlimit.is_number())
+			pen.miter_limit = (float)stroke_miterlimit.get_number();
+
+		while (stroke_dasharray.is_sequence_number())
+			pen.dashes.push_back((float)stroke_dasharray.get_sequence_number());
+
+		if (stroke_dashoffset.is_length())
+			pen.dash_offset = (float)stroke_dashoffset.get_length();
+
+		path_node->pen = pen;
 		path_node->stroke = true;
 	}
 
@@ -389,8 +412,8 @@ void SvgNode::render(const CanvasPtr &canvas)
 
 	if (stroke && fill)
 	{
-		path->stroke(canvas, pen);
 		path->fill(canvas, brush);
+		path->stroke(canvas, pen);
 	}
 	else if (stroke)
 	{
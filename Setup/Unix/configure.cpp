@@ -160,6 +160,22 @@ public:
         output << "    LIBRARY DESTINATION lib" << std::endl;
         output << "    ARCHIVE DESTINATION lib)" << std::endl;
         output << "install(DIRECTORY Sources/Include/ DESTINATION include FILES_MATCHING PATTERN \"*.h\")" << std::endl;
+        output << "enable_testing()" << std::endl;
+        output_tests(output, "Tests");
+    }
+    
+    static void output_tests(std::ofstream &output, const std::string &path)
+    {
+        for (auto file : Directory::files(path))
+        {
+            if (Path::extension(file) == ".cpp")
+            {
+                std::string name = file.substr(0, file.size() - 4);
+                output << "add_executable(" << name << " " << Path::combine(path, file) << ")" << std::endl;
+                output << "target_link_libraries(" << name << " uicore)" << std::endl;
+                output << "add_test(NAME " << name << " COMMAND " << name << ")" << std::endl;
+            }
+        }
     }
     
     static void output_target_files(std::ofstream &output, const std::string &path)
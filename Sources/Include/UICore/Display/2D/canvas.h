@@ -35,6 +35,7 @@
 #include "../../Core/Math/size.h"
 #include "../../Core/Math/rect.h"
 #include "../../Core/Math/color.h"
+#include <cstdint>
 
 namespace uicore
 {
@@ -47,6 +48,54 @@ namespace uicore
 	class Path;
 	class Pen;
 	class Brush;
+	enum class PathRasterizer;
+	class PathCacheStats;
+
+	/// \brief Rendering counters of a canvas, collected from Canvas::begin() until Canvas::end()
+	///
+	/// Every draw call ends a batch. The flush counters tell why each batch ended, and add up to draw_calls.
+	class CanvasStats
+	{
+	public:
+		/// \brief Number of draw calls issued to the graphic context
+		int draw_calls = 0;
+
+		/// \brief Number of vertices uploaded
+		int vertices = 0;
+
+		/// \brief Vertex data uploaded, in bytes
+		uint64_t vertex_bytes = 0;
+
+		/// \brief Batches ended because other geometry needed a different batcher
+		int batcher_switch_flushes = 0;
+
+		/// \brief Batches ended because all texture slots of the batch were in use
+		int texture_slot_flushes = 0;
+
+		/// \brief Batches ended to switch the glyph program, the glyph color or the vertex format
+		int glyph_program_flushes = 0;
+
+		/// \brief Batches ended because the scissor had to change for the clip rect
+		int clip_change_flushes = 0;
+
+		/// \brief Batches ended because the vertex or mask buffers were full
+		int buffer_full_flushes = 0;
+
+		/// \brief Batches ended by Canvas::end(), Canvas::clear() or other state changes
+		int explicit_flushes = 0;
+
+		/// \brief Number of coverage mask blocks rasterized for path fills and strokes. Masks found in the path cache are not included
+		int mask_blocks = 0;
+
+		/// \brief Number of points in the flattened outlines of path fills and strokes that were rasterized
+		int path_vertices = 0;
+
+		/// \brief Number of line segments in the flattened outlines of path fills and strokes that were rasterized
+		int path_edges = 0;
+
+		/// \brief Number of glyphs that had to be rasterized because they were not in a glyph cache
+		int glyph_cache_misses = 0;
+	};
 
 	/// \brief 2D Graphics Canvas
 	class Canvas
@@ -55,6 +104,9 @@ namespace uicore
 		/// \brief Constructs a canvas
 		static std::shared_ptr<Canvas> create(const DisplayWindowPtr &window);
 
+		/// \brief Constructs a canvas drawing directly to a graphic context, such as one from SoftwareTarget
+		static std::shared_ptr<Canvas> create(const GraphicContextPtr &gc);
+
 		/// \brief Returns the graphic context associated with this canvas
 		virtual const GraphicContextPtr &gc() const = 0;
 
@@ -121,6 +173,64 @@ namespace uicore
 
 		/// \brief Snaps the point to the nearest pixel corner
 		virtual Pointf grid_fit(const Pointf &pos) = 0;
+
+		/// \brief Sets the algorithm used when filling paths
+		virtual void set_path_rasterizer(PathRasterizer rasterizer) = 0;
+
+		/// \brief Returns the algorithm used when filling paths
+		virtual PathRasterizer path_rasterizer() const = 0;
+
+		/// \brief Sets the number of threads used to rasterize large path fills
+		///
+		/// Only used by PathRasterizer::analytic. The default is 1. A value of 0 uses one thread per core.
+		virtual void set_path_rasterizer_threads(int num_threads) = 0;
+
+		/// \brief Returns the number of threads used to rasterize large path fills
+		virtual int path_rasterizer_threads() const = 0;
+
+		/// \brief Sets how much memory may be used to keep the masks of filled paths
+		///
+		/// A path that is filled again unchanged and with the same transform reuses its mask instead
+		/// of being rasterized. Paths are matched by their contents, so a path object recreated every
+		/// frame is found as well. Only used by PathRasterizer::analytic. 0 disables the cache.
+		virtual void set_path_cache_budget(size_t bytes) = 0;
+
+		/// \brief Returns the memory that may be used to keep the masks of filled paths
+		virtual size_t path_cache_budget() const = 0;
+
+		/// \brief Returns the path mask cache counters for this canvas
+		virtual PathCacheStats path_cache_stats() const = 0;
+
+		/// \brief Sets if images, glyphs and rectangle fills are batched as compact quads
+		///
+		/// A compact quad is four 20 byte vertices drawn with a shared index buffer, instead of six 44 byte
+		/// vertices. Quads with repeating texture coordinates, colors outside 0-1 or a 3D transform always
+		/// use the full vertices, as do targets without shaders. The default is true.
+		virtual void set_compact_quads(bool enable) = 0;
+
+		/// \brief Returns true if images, glyphs and rectangle fills are batched as compact quads
+		virtual bool compact_quads() const = 0;
+
+		/// \brief Sets if the canvas counts rendering statistics. The default is false
+		virtual void set_stats_enabled(bool enable) = 0;
+
+		/// \brief Returns true if the canvas counts rendering statistics
+		virtual bool stats_enabled() const = 0;
+
+		/// \brief Returns the statistics of the current frame
+		///
+		/// The counters are reset by begin(). After end() they describe the completed frame.
+		virtual const CanvasStats &stats() const = 0;
+
+		/// \brief Sets if clip rect changes may be handled without ending the current batch
+		///
+		/// With batched clipping, images, glyphs and rectangle fills are clipped on the CPU and the scissor
+		/// is only updated once other geometry is drawn. This keeps clipped list rows and text in a single
+		/// draw call. Without it, every clip change flushes the batch and updates the scissor. The default is true.
+		virtual void set_batched_clipping(bool enable) = 0;
+
+		/// \brief Returns true if clip rect changes are handled without ending the current batch
+		virtual bool batched_clipping() const = 0;
 	};
 
 	typedef std::shared_ptr<Canvas> CanvasPtr;
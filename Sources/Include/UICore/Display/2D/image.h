@@ -31,6 +31,7 @@
 #include <memory>
 #include "../../Core/Math/origin.h"
 #include "../../Core/Math/color.h"
+#include "../../Core/Signals/signal.h"
 #include "../Image/image_import_description.h"
 #include "UICore/Display/Render/texture.h"
 
@@ -57,6 +58,12 @@ namespace uicore
 		static std::shared_ptr<Image> create(const CanvasPtr &canvas, const PixelBufferPtr &pixelbuffer, const Rect &rect, float pixel_ratio = 1.0f);
 		static std::shared_ptr<Image> create(const CanvasPtr &canvas, const std::string &filename, const ImageImportDescription &import_desc = ImageImportDescription(), float pixel_ratio = 1.0f);
 
+		/// \brief Constructs an image that is decoded on a worker thread and uploaded to the GPU over the next frames
+		///
+		/// Until is_ready() returns true the image has a size of zero and draws nothing.
+		/// The import description is processed on the worker thread.
+		static std::shared_ptr<Image> create_async(const CanvasPtr &canvas, const std::string &filename, const ImageImportDescription &import_desc = ImageImportDescription(), float pixel_ratio = 1.0f);
+
 		/// \brief Returns x scale.
 		virtual float scale_x() const = 0;
 
@@ -81,6 +88,16 @@ namespace uicore
 		/// \brief Return the height of the image.
 		virtual float height() const = 0;
 
+		/// \brief Returns false while an image created with create_async is still loading
+		///
+		/// Also returns true if loading failed. The image then keeps a size of zero.
+		virtual bool is_ready() const = 0;
+
+		/// \brief Signal emitted when an image created with create_async finished loading
+		///
+		/// It is emitted by Canvas::begin, before the frame is laid out.
+		virtual Signal<void()> &sig_ready() = 0;
+
 		/// \brief Copies all information from this image to another, excluding the graphics that remain shared
 		virtual std::shared_ptr<Image> clone() const = 0;
 
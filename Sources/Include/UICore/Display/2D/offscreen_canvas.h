@@ -0,0 +1,91 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include <memory>
+#include "../../Core/Math/size.h"
+
+namespace uicore
+{
+	class GraphicContext;
+	typedef std::shared_ptr<GraphicContext> GraphicContextPtr;
+	class Canvas;
+	typedef std::shared_ptr<Canvas> CanvasPtr;
+	class Texture2D;
+	typedef std::shared_ptr<Texture2D> Texture2DPtr;
+	class PixelBuffer;
+	typedef std::shared_ptr<PixelBuffer> PixelBufferPtr;
+
+	/// \brief Canvas rendering into an offscreen image that can be read back into a pixel buffer
+	///
+	/// Draw with canvas() between Canvas::begin() and Canvas::end() like any other canvas. Call start_readback()
+	/// after end() to begin copying the image off the GPU, then pixels() when the result is needed. Doing other work
+	/// in between hides the transfer latency.
+	class OffscreenCanvas
+	{
+	public:
+		/// \brief Creates an offscreen canvas rendering into a texture of the graphic context
+		///
+		/// \param gc = Graphic context the texture and frame buffer are created on
+		/// \param size = Size of the image, in pixels
+		static std::shared_ptr<OffscreenCanvas> create(const GraphicContextPtr &gc, const Size &size);
+
+		/// \brief Creates an offscreen canvas rendering on the CPU using the software target
+		///
+		/// \param size = Size of the image, in pixels
+		/// \param pixel_ratio = Number of pixels per device independent pixel
+		static std::shared_ptr<OffscreenCanvas> create(const Size &size, float pixel_ratio = 1.0f);
+
+		/// \brief Returns the canvas drawing into the image
+		virtual const CanvasPtr &canvas() const = 0;
+
+		/// \brief Returns the texture holding the image, or null for a software canvas
+		virtual const Texture2DPtr &texture() const = 0;
+
+		/// \brief Returns the size of the image, in pixels
+		virtual Size size() const = 0;
+
+		/// \brief Starts copying the image into a staging buffer
+		///
+		/// Must not be called between Canvas::begin() and Canvas::end().
+		virtual void start_readback() = 0;
+
+		/// \brief Returns true if start_readback() was called and pixels() has not picked up the result yet
+		virtual bool readback_pending() const = 0;
+
+		/// \brief Returns the image as a tf_rgba8 pixel buffer, with the first row at the top of the canvas
+		///
+		/// Waits for a pending readback to complete, or reads the image directly if none was started.
+		/// Must not be called between Canvas::begin() and Canvas::end().
+		virtual PixelBufferPtr pixels() = 0;
+	};
+
+	typedef std::shared_ptr<OffscreenCanvas> OffscreenCanvasPtr;
+}
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
 #include "../../Core/Math/rect.h"
 #include "../../Core/Math/mat4.h"
 #include "../../Core/Math/color.h"
@@ -51,6 +52,36 @@ namespace uicore
 		winding
 	};
 
+	/// \brief Algorithm used to compute the coverage of filled paths
+	enum class PathRasterizer
+	{
+		/// \brief Exact area coverage computed from the path edges
+		analytic,
+
+		/// \brief Coverage sampled at 2x2 points per pixel
+		supersampled
+	};
+
+	/// \brief Path mask cache counters for a canvas
+	class PathCacheStats
+	{
+	public:
+		/// \brief Number of path fills that reused a cached mask
+		uint64_t hits = 0;
+
+		/// \brief Number of path fills that had to be rasterized
+		uint64_t misses = 0;
+
+		/// \brief Number of masks evicted to stay within the path cache budget
+		uint64_t evictions = 0;
+
+		/// \brief Number of masks currently cached
+		int paths = 0;
+
+		/// \brief Memory used by cached masks, in bytes
+		size_t bytes = 0;
+	};
+
 	class Path
 	{
 	public:
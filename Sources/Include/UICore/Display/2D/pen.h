@@ -30,9 +30,36 @@
 #pragma once
 
 #include "../../Core/Math/color.h"
+#include <vector>
 
 namespace uicore
 {
+	/// \brief Shape used where two stroked lines meet
+	enum class PenJoin
+	{
+		/// \brief Extends the outer edges until they meet, unless that exceeds the miter limit
+		miter,
+
+		/// \brief Rounds the corner with the stroke width as diameter
+		round,
+
+		/// \brief Cuts the corner off between the outer edges
+		bevel
+	};
+
+	/// \brief Shape used at the ends of open stroked lines and dashes
+	enum class PenCap
+	{
+		/// \brief Ends exactly at the end point
+		butt,
+
+		/// \brief Extends with a half circle
+		round,
+
+		/// \brief Extends by half the stroke width
+		square
+	};
+
 	class Pen
 	{
 	public:
@@ -41,5 +68,19 @@ namespace uicore
 
 		Colorf color;
 		float width = 1.0f;
+
+		PenJoin join = PenJoin::miter;
+		PenCap cap = PenCap::butt;
+
+		/// \brief Longest miter, relative to the stroke width, before a miter join becomes a bevel
+		float miter_limit = 4.0f;
+
+		/// \brief Alternating dash and gap lengths. Empty for a solid line
+		///
+		/// A list with an odd number of entries is repeated to make it even, as in SVG.
+		std::vector<float> dashes;
+
+		/// \brief Distance into the dash pattern at which the line starts
+		float dash_offset = 0.0f;
 	};
 }
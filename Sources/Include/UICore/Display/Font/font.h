@@ -97,6 +97,12 @@ namespace uicore
 		virtual void draw_text(const CanvasPtr &canvas, const Pointf &position, const std::string &text, const Colorf &color = StandardColorf::white()) = 0;
 		void draw_text(const CanvasPtr &canvas, float xpos, float ypos, const std::string &text, const Colorf &color = StandardColorf::white()) { draw_text(canvas, Pointf(xpos, ypos), text, color); }
 
+		/// \brief Rasterizes the glyphs of a text ahead of time
+		///
+		/// Glyphs not yet in the glyph cache are uploaded to the glyph atlas in one batch, avoiding
+		/// a rasterization stall when they are first drawn.
+		virtual void prewarm(const CanvasPtr &canvas, const std::string &text) = 0;
+
 		/// \brief Gets the glyph metrics
 		///
 		/// \param glyph = The glyph to get
@@ -109,6 +115,12 @@ namespace uicore
 		/// \return The metrics
 		virtual GlyphMetrics measure_text(const CanvasPtr &canvas, const std::string &string) = 0;
 
+		/// \brief Measure the size of several texts
+		///
+		/// \param strings = The texts to measure
+		/// \return The metrics for each text
+		virtual std::vector<GlyphMetrics> measure_texts(const CanvasPtr &canvas, const std::vector<std::string> &strings) = 0;
+
 		/// \brief Retrieves font metrics description for the selected font.
 		virtual const FontMetrics &font_metrics(const CanvasPtr &canvas) = 0;
 
@@ -37,6 +37,38 @@
 
 namespace uicore
 {
+	class Canvas;
+	typedef std::shared_ptr<Canvas> CanvasPtr;
+
+	/// \brief Glyph cache counters for the fonts in a font family
+	class GlyphCacheStats
+	{
+	public:
+		/// \brief Number of glyph lookups found in the cache
+		uint64_t hits = 0;
+
+		/// \brief Number of glyph lookups that had to be rasterized
+		uint64_t misses = 0;
+
+		/// \brief Number of glyphs evicted to stay within the glyph cache budget
+		uint64_t evictions = 0;
+
+		/// \brief Number of glyphs currently cached
+		int glyphs = 0;
+
+		/// \brief Texture memory used by cached glyphs, in bytes
+		size_t glyph_bytes = 0;
+
+		/// \brief Texture memory allocated by the glyph atlas, in bytes
+		size_t atlas_bytes = 0;
+
+		/// \brief Number of textures used by the glyph atlas
+		int atlas_textures = 0;
+
+		/// \brief Fraction of the glyph atlas occupied by glyphs
+		float occupancy() const { return atlas_bytes > 0 ? glyph_bytes / (float)atlas_bytes : 0.0f; }
+	};
+
 	/// \brief FontFamily class
 	///
 	/// A FontFamily is a collection of font descriptions
@@ -57,6 +89,42 @@ namespace uicore
 
 		// \brief Add standard font
 		virtual void add(const FontDescription &desc, const std::string &ttf_filename) = 0;
+
+		/// \brief Sets the maximum texture memory, in bytes, used by cached glyphs of the fonts in this family
+		///
+		/// When the budget is exceeded the least recently used glyphs are evicted from the glyph atlas.
+		/// A budget of 0 means the glyph cache is unbounded (the default).
+		virtual void set_glyph_cache_budget(size_t bytes) = 0;
+
+		/// \brief Returns the glyph cache budget in bytes (0 = unbounded)
+		virtual size_t glyph_cache_budget() const = 0;
+
+		/// \brief Returns the glyph cache counters for the fonts in this family
+		virtual GlyphCacheStats glyph_cache_stats() const = 0;
+
+		/// \brief Rasterize glyph cache misses on background threads
+		///
+		/// A glyph is measured right away but not drawn until its image is ready. Windows that
+		/// drew it are then repainted. Font engines without thread support rasterize immediately.
+		virtual void set_async_rasterization(bool enable) = 0;
+
+		/// \brief Returns true if glyph cache misses are rasterized on background threads
+		virtual bool async_rasterization() const = 0;
+
+		/// \brief Rasterizes the glyphs of a text at each of the specified heights
+		///
+		/// Uses the normal weight and style. Call Font::prewarm for other variants.
+		virtual void prewarm(const CanvasPtr &canvas, const std::vector<float> &heights, const std::string &text) = 0;
+
+		/// \brief Loads glyph images saved by save_glyph_cache
+		///
+		/// Glyphs found in the file are uploaded instead of rasterized. Entries are matched by font
+		/// file contents, size and render mode, so images from another font version are never used.
+		/// Missing, outdated or damaged files are ignored.
+		virtual void load_glyph_cache(const std::string &filename) = 0;
+
+		/// \brief Saves the images of all glyphs currently cached for fonts loaded from font files
+		virtual void save_glyph_cache(const std::string &filename) = 0;
 	};
 
 	typedef std::shared_ptr<FontFamily> FontFamilyPtr;
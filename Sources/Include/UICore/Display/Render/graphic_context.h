@@ -253,6 +253,7 @@ namespace uicore
 		shader_glsl,
 		shader_hlsl,
 		shader_fixed_function,
+		shader_software,
 		num_shader_languages
 	};
 
@@ -265,6 +266,28 @@ namespace uicore
 	class DepthStencilState { };
 	typedef std::shared_ptr<DepthStencilState> DepthStencilStatePtr;
 
+	/// State changes passed on to the driver, and state changes skipped because the state was already set.
+	class GraphicContextStateStats
+	{
+	public:
+		int texture_binds = 0;
+		int texture_binds_elided = 0;
+		int program_binds = 0;
+		int program_binds_elided = 0;
+		int blend_states = 0;
+		int blend_states_elided = 0;
+		int primitives_array_binds = 0;
+		int primitives_array_binds_elided = 0;
+		int scissor_changes = 0;
+		int scissor_changes_elided = 0;
+
+		/// Total number of state changes passed on to the driver
+		int issued() const { return texture_binds + program_binds + blend_states + primitives_array_binds + scissor_changes; }
+
+		/// Total number of state changes skipped
+		int elided() const { return texture_binds_elided + program_binds_elided + blend_states_elided + primitives_array_binds_elided + scissor_changes_elided; }
+	};
+
 	/// Interface to drawing graphics.
 	class GraphicContext
 	{
@@ -574,6 +597,23 @@ namespace uicore
 
 		/// Flush the command buffer
 		virtual void flush() = 0;
+
+		/// Returns how many state changes were passed on to the driver and how many were skipped as redundant.
+		///
+		/// The counters keep counting until reset_state_stats() is called, usually at the start of a frame.
+		/// Targets without a state cache leave them at zero.
+		virtual const GraphicContextStateStats &state_stats() const = 0;
+
+		/// Sets the state change counters back to zero.
+		virtual void reset_state_stats() = 0;
+
+		/// Returns how many bytes of images loaded with Image::create_async are uploaded per frame.
+		virtual int upload_budget() const = 0;
+
+		/// Sets how many bytes of images loaded with Image::create_async are uploaded per frame.
+		///
+		/// At least one image is uploaded every frame, even if it alone is larger than the budget. The default is 4 MB.
+		virtual void set_upload_budget(int bytes_per_frame) = 0;
 	};
 
 	typedef std::shared_ptr<GraphicContext> GraphicContextPtr;
@@ -304,6 +304,12 @@ namespace uicore
 		/// \param interval = See note
 		virtual void flip(int interval = -1) = 0;
 
+		/// \brief Returns how many flips ago the back buffer was last drawn into
+		///
+		/// A value of 1 means the back buffer still holds the previous frame, so only what changed since then has to be drawn again.
+		/// A value of 0 means the contents of the back buffer are undefined and everything must be drawn.
+		virtual int back_buffer_age() = 0;
+
 		/// \brief Shows the mouse cursor.
 		virtual void show_cursor() = 0;
 
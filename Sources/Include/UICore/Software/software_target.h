@@ -0,0 +1,64 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include <memory>
+
+namespace uicore
+{
+	class GraphicContext;
+	typedef std::shared_ptr<GraphicContext> GraphicContextPtr;
+	class PixelBuffer;
+	typedef std::shared_ptr<PixelBuffer> PixelBufferPtr;
+
+	/// \brief Rendering target drawing on the CPU into a pixel buffer
+	///
+	/// Useful for offscreen rendering and for systems without a usable GPU. The graphic context supports the
+	/// standard programs, and with them everything Canvas draws, but no custom shaders.
+	class SoftwareTarget
+	{
+	public:
+		/// \brief Creates a graphic context drawing into a pixel buffer
+		///
+		/// The pixel buffer acts as the window frame buffer of the context and must be tf_rgba8, tf_srgb8_alpha8 or tf_bgra8.
+		static GraphicContextPtr create_graphic_context(const PixelBufferPtr &target);
+
+		/// \brief Returns the pixel buffer a software graphic context draws into
+		static PixelBufferPtr pixel_buffer(const GraphicContextPtr &gc);
+
+		/// \brief Replaces the pixel buffer a software graphic context draws into
+		///
+		/// Emits the window resized signal of the context if the size changed.
+		static void set_pixel_buffer(const GraphicContextPtr &gc, const PixelBufferPtr &target);
+
+		/// \brief Sets the number of threads rasterizing for a software graphic context. Zero uses one thread per core
+		static void set_num_threads(const GraphicContextPtr &gc, int num_threads);
+	};
+}
@@ -81,5 +81,8 @@ namespace uicore
 
 	private:
 		std::unique_ptr<StyleImpl> impl;
+
+		friend class StyleCascade;
+		friend class ViewImpl;
 	};
 }
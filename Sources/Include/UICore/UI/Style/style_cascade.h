@@ -31,6 +31,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include "style_get_value.h"
 
 namespace uicore
@@ -75,6 +76,12 @@ namespace uicore
 
 		/// Parent cascade used for inheritance
 		const StyleCascade *parent = nullptr;
+
+		/// Discard cached computed values
+		///
+		/// Computed values are cached until a style in the cascade or an ancestor cascade changes. Call this
+		/// after modifying the cascade or parent members. Descendant cascades only drop their inherited values.
+		void invalidate();
 		
 		/// Find the first declared value in the cascade for the specified property
 		StyleGetValue cascade_value(const char *property_name) const;
@@ -117,5 +124,25 @@ namespace uicore
 		
 		/// Font used by this style cascade
 		FontPtr font() const;
+
+	private:
+		StyleGetValue cascade_value(int property_id) const;
+		StyleGetValue specified_value(int property_id) const;
+		StyleGetValue computed_value(int property_id) const;
+		StyleGetValue resolve_computed_value(int property_id, bool &depends_on_parent) const;
+		void validate_cache() const;
+
+		struct CachedValue
+		{
+			StyleGetValue value;
+			bool depends_on_parent;
+		};
+
+		mutable std::unordered_map<int, CachedValue> cached_values;
+		mutable std::vector<std::pair<const Style *, unsigned int>> style_versions;
+		mutable unsigned int validated_change = 0;
+		mutable const StyleCascade *validated_parent = nullptr;
+		mutable unsigned int validated_parent_version = 0;
+		mutable unsigned int version = 0;
 	};
 }
@@ -111,6 +111,16 @@ namespace uicore
 		StylePropertyDefault(const std::string &name, const StyleGetValue &value, bool inherit);
 	};
 
+	/// Marks properties that only change how a view is painted
+	///
+	/// Views render such changes again without a new layout. Array elements and sub-properties use the
+	/// setting of their base name, so "box-shadow-color" also covers "box-shadow-color[0]".
+	class StylePaintProperties
+	{
+	public:
+		StylePaintProperties(const std::vector<std::string> &names);
+	};
+
 	/// Style property interface used to parse or query properties by name
 	class StyleProperty
 	{
@@ -121,6 +131,9 @@ namespace uicore
 		/// Indicates if this an inherited property or not
 		static bool is_inherited(const char *name);
 
+		/// Indicates if the property only affects painting and never the layout
+		static bool is_paint_only(const char *name);
+
 		/// Parses a string of styles and sets the values
 		static void parse(StylePropertySetter *setter, const std::string &styles);
 	};
@@ -36,6 +36,8 @@ namespace uicore
 	class DisplayWindow;
 	typedef std::shared_ptr<DisplayWindow> DisplayWindowPtr;
 	class Canvas;
+	class Texture2D;
+	typedef std::shared_ptr<Texture2D> Texture2DPtr;
 	class ViewTreeImpl;
 
 	/// Base class for managing a tree of views
@@ -81,11 +83,26 @@ namespace uicore
 			return add_child<View>();
 		}
 
+		/// Number of times the views were laid out since the tree was created
+		int layout_pass_count() const;
+
+		/// Number of times the views were laid out during the last full second of frames
+		int layout_passes_per_second() const;
+
 	protected:
 		/// Set or clears the focus
 		void set_focus_view(View *view);
 
+		/// Lays out the views and returns the area that changed since the last call, in canvas coordinates
+		///
+		/// The area covers views that asked to be rendered again and views that moved, appeared or disappeared.
+		/// After a frame that drew images or glyphs still loading, it covers the whole margin box.
+		/// Render with the canvas clipped to it to only redraw what changed.
+		Rectf update_layout(const CanvasPtr &canvas, const Rectf &margin_box);
+
 		/// Renders view into the specified canvas
+		///
+		/// Only views overlapping the clip rect of the canvas are rendered.
 		void render(const CanvasPtr &canvas, const Rectf &margin_box);
 
 		/// Dispatch activation change event to all views
@@ -107,6 +124,15 @@ namespace uicore
 		ViewTree(const ViewTree &) = delete;
 		ViewTree &operator=(const ViewTree &) = delete;
 
+		/// Adds an area to the damage returned by update_layout
+		void add_damage(const Rectf &box);
+
+		/// Finds the views that moved at the next update_layout, even if no layout is needed
+		void set_render_boxes_dirty();
+
+		/// Returns a canvas drawing into the texture of a view layer, for use in the middle of a frame of canvas
+		const CanvasPtr &layer_canvas(const CanvasPtr &canvas, const Texture2DPtr &layer_texture);
+
 		std::unique_ptr<ViewTreeImpl> impl;
 
 		friend class View;
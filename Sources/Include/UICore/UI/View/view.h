@@ -184,6 +184,17 @@ namespace uicore
 		/// Forces recalculation of view geometry before next rendering
 		void set_needs_layout();
 
+		/// Test if layout changes inside the view stop at the view instead of laying out its parent again
+		///
+		/// True for the root view, views with a width and height given in length units, and views marked by set_layout_boundary.
+		bool is_layout_boundary() const;
+
+		/// Specifies if the view keeps its size when its content changes, making it a layout boundary
+		///
+		/// Only the subtree of the view is laid out again when something inside it changes. The parent does not ask
+		/// for the preferred size of the view again until the parent is laid out for another reason.
+		void set_layout_boundary(bool enable);
+
 		/// Actual view position and size after layout
 		const ViewGeometry &geometry() const;
 
@@ -225,6 +236,26 @@ namespace uicore
 		/// Specifies if content should be clipped during rendering
 		void set_content_clipped(bool clipped);
 
+		/// Layer caching flag
+		///
+		/// Also true if the "layer" style property is set to "cache".
+		bool layer_cached() const;
+
+		/// Specifies if the view and its children should be rendered into an offscreen layer and drawn from there
+		///
+		/// The layer is rendered again when the view or one of its children needs to be rendered again, and is otherwise
+		/// drawn as a single image. Children drawing outside the visual box of the view are clipped by the layer.
+		/// Views are rendered directly if their layer does not fit in the layer memory budget.
+		void set_layer_cached(bool enable);
+
+		/// Memory all layers together may use, in bytes
+		static int layer_memory_budget();
+
+		/// Sets the memory all layers together may use, in bytes
+		///
+		/// Layers not drawn recently are released first when a new layer needs the space. The default is 32 MB.
+		static void set_layer_memory_budget(int bytes);
+
 		/// Calculates the preferred margin box width using simplified layout rules
 		float preferred_margin_width(const CanvasPtr &canvas);
 
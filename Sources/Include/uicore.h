@@ -46,6 +46,7 @@
 #include "UICore/d3d.h"
 #endif
 #include "UICore/gl.h"
+#include "UICore/software.h"
 #include "UICore/ui.h"
 #include "UICore/network.h"
 #include "UICore/application.h"
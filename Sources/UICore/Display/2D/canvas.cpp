@@ -36,4 +36,9 @@ namespace uicore
 	{
 		return std::make_shared<CanvasImpl>(window);
 	}
+
+	std::shared_ptr<Canvas> Canvas::create(const GraphicContextPtr &gc)
+	{
+		return std::make_shared<CanvasImpl>(gc);
+	}
 }
@@ -40,7 +40,7 @@ namespace uicore
 		CanvasBatcher_Impl(const GraphicContextPtr &gc);
 		~CanvasBatcher_Impl();
 
-		void flush();
+		void flush(BatchFlushReason reason);
 		bool set_batcher(const GraphicContextPtr &gc, RenderBatcher *batcher);
 		void update_batcher_matrix(const GraphicContextPtr &gc, const Mat4f &modelview, const Mat4f &projection, TextureImageYAxis image_yaxis);
 
@@ -108,13 +108,15 @@ namespace uicore
 		return &impl->render_batcher_point;
 	}
 
-	void CanvasBatcher_Impl::flush()
+	void CanvasBatcher_Impl::flush(BatchFlushReason reason)
 	{
 		if (active_batcher)
 		{
 			RenderBatcher *batcher = active_batcher;
 			active_batcher = nullptr;
+			render_batcher_buffer.flush_reason = reason;
 			batcher->flush(current_gc);
+			render_batcher_buffer.flush_reason = BatchFlushReason::explicit_flush;
 		}
 	}
 
@@ -122,7 +124,7 @@ namespace uicore
 	{
 		if (gc != current_gc)
 		{
-			flush();
+			flush(BatchFlushReason::explicit_flush);
 			current_gc = gc;
 		}
 
@@ -136,7 +138,7 @@ namespace uicore
 	{
 		if ((active_batcher != batcher) || (gc != current_gc))
 		{
-			flush();
+			flush(gc != current_gc ? BatchFlushReason::explicit_flush : BatchFlushReason::batcher_switch);
 			current_gc = gc;
 			active_batcher = batcher;
 			return true;
@@ -144,9 +146,19 @@ namespace uicore
 		return false;
 	}
 
-	void CanvasBatcher::flush()
+	RenderBatchBuffer *CanvasBatcher::get_batch_buffer()
 	{
-		impl->flush();
+		return &impl->render_batcher_buffer;
+	}
+
+	const RenderBatchBuffer *CanvasBatcher::get_batch_buffer() const
+	{
+		return &impl->render_batcher_buffer;
+	}
+
+	void CanvasBatcher::flush(BatchFlushReason reason)
+	{
+		impl->flush(reason);
 	}
 
 	void CanvasBatcher::update_batcher_matrix(const GraphicContextPtr &gc, const Mat4f &modelview, const Mat4f &projection, TextureImageYAxis image_yaxis)
@@ -53,7 +53,7 @@ namespace uicore
 		/// \brief Returns true if this object is invalid.
 		bool is_null() const { return !impl; }
 
-		void flush();
+		void flush(BatchFlushReason reason = BatchFlushReason::explicit_flush);
 		bool set_batcher(const GraphicContextPtr &gc, RenderBatcher *batcher);
 		void update_batcher_matrix(const GraphicContextPtr &gc, const Mat4f &modelview, const Mat4f &projection, TextureImageYAxis image_yaxis);
 
@@ -62,6 +62,8 @@ namespace uicore
 		RenderBatchLineTexture *get_line_texture_batcher();
 		RenderBatchPoint *get_point_batcher();
 		RenderBatchPath *get_path_batcher();
+		RenderBatchBuffer *get_batch_buffer();
+		const RenderBatchBuffer *get_batch_buffer() const;
 
 	private:
 		std::shared_ptr<CanvasBatcher_Impl> impl;
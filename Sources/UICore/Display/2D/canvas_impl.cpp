@@ -31,14 +31,17 @@
 #include "canvas_impl.h"
 #include "UICore/Display/2D/render_batcher.h"
 #include "UICore/Display/Render/graphic_context_impl.h"
+#include "UICore/Display/Render/texture_upload_queue.h"
 
 namespace uicore
 {
-	CanvasImpl::CanvasImpl(const DisplayWindowPtr &window)
+	CanvasImpl::CanvasImpl(const DisplayWindowPtr &window) : CanvasImpl(window->gc())
 	{
 		current_window = window;
-		_gc = window->gc();
+	}
 
+	CanvasImpl::CanvasImpl(const GraphicContextPtr &gc, const FrameBufferPtr &frame_buffer) : _gc(gc), canvas_frame_buffer(frame_buffer)
+	{
 		rasterizer_state = _gc->create_rasterizer_state(RasterizerStateDescription());
 		depth_stencil_state = _gc->create_depth_stencil_state(DepthStencilStateDescription());
 		opaque_blend = _gc->create_blend_state(BlendStateDescription::opaque());
@@ -49,7 +52,7 @@ namespace uicore
 
 		batcher = CanvasBatcher(_gc);
 
-		if (!_gc->write_frame_buffer())	// No framebuffer attached to canvas
+		if (!canvas_frame_buffer && !_gc->write_frame_buffer())	// No framebuffer attached to canvas
 		{
 			canvas_y_axis = y_axis_top_down;
 		}
@@ -72,26 +75,75 @@ namespace uicore
 
 	void CanvasImpl::begin()
 	{
+		batcher.get_batch_buffer()->stats = CanvasStats();
+
+		GraphicContextImpl *gc_impl = static_cast<GraphicContextImpl*>(gc().get());
+		if (gc_impl->upload_queue)
+			gc_impl->upload_queue->process(gc(), current_window);
+
+		if (canvas_frame_buffer)
+		{
+			prev_write_frame_buffer = gc()->write_frame_buffer();
+			prev_read_frame_buffer = gc()->read_frame_buffer();
+			gc()->set_frame_buffer(canvas_frame_buffer);
+		}
+
 		update_viewport_size();
+		placeholders_drawn = false;
 
+		restore_state();
+	}
+
+	void CanvasImpl::restore_state()
+	{
 		gc()->set_viewport(gc()->size(), gc()->texture_image_y_axis());
 		gc()->set_rasterizer_state(rasterizer_state);
 		gc()->set_depth_stencil_state(depth_stencil_state);
 		gc()->set_blend_state(nullptr);
+
+		// Another canvas may have changed the scissor since it was set
+		scissor_set = false;
 		if (!cliprects.empty())
-			write_clip(cliprects.back());
+			update_scissor(false);
+	}
+
+	void CanvasImpl::draw_premultiplied(const Texture2DPtr &texture, const Rectf &src, const Rectf &dest)
+	{
+		if (!premultiplied_blend)
+		{
+			BlendStateDescription blend_desc;
+			blend_desc.set_blend_function(blend_one, blend_one_minus_src_alpha, blend_one, blend_one_minus_src_alpha);
+			premultiplied_blend = gc()->create_blend_state(blend_desc);
+		}
+
+		batcher.flush();
+		gc()->set_blend_state(premultiplied_blend);
+		batcher.get_triangle_batcher()->draw_image(shared_from_this(), src, dest, StandardColorf::white(), texture);
+		batcher.flush();
+		gc()->set_blend_state(nullptr);
 	}
 
 	void CanvasImpl::end()
 	{
 		batcher.flush();
 
-		if (!cliprects.empty())
+		if (scissor_set)
+		{
 			gc()->reset_scissor();
+			scissor_set = false;
+		}
 		gc()->set_rasterizer_state(nullptr);
 		gc()->set_depth_stencil_state(nullptr);
 		gc()->set_blend_state(nullptr);
 		gc()->set_program_object(nullptr);
+
+		if (canvas_frame_buffer)
+		{
+			gc()->set_frame_buffer(prev_write_frame_buffer, prev_read_frame_buffer);
+			prev_write_frame_buffer.reset();
+			prev_read_frame_buffer.reset();
+		}
+
 		gc()->set_viewport(gc()->size(), gc()->texture_image_y_axis());
 	}
 
@@ -110,12 +162,30 @@ namespace uicore
 		batcher.update_batcher_matrix(_gc, canvas_transform, canvas_projection, canvas_y_axis);
 	}
 
-	void CanvasImpl::set_batcher(RenderBatcher *new_batcher)
+	void CanvasImpl::set_batcher(RenderBatcher *new_batcher, bool clips_itself)
 	{
+		if (!scissor_fits(clips_itself))
+		{
+			batcher.flush(BatchFlushReason::clip_change);
+			update_scissor(clips_itself);
+		}
+
 		if (batcher.set_batcher(gc(), new_batcher))
 			update_batcher_matrix();
 	}
 
+	bool CanvasImpl::batch_clip_rect(Rectf &out_rect) const
+	{
+		if (cliprects.empty())
+			return false;
+
+		// The same pixels as the scissor would keep
+		Rect rect = clip_pixels(cliprects.back());
+		float pixel_ratio = gc()->pixel_ratio();
+		out_rect = Rectf(rect.left / pixel_ratio, rect.top / pixel_ratio, rect.right / pixel_ratio, rect.bottom / pixel_ratio);
+		return true;
+	}
+
 	void CanvasImpl::calculate_map_mode_matrices()
 	{
 		Mat4f matrix;
@@ -216,41 +286,82 @@ namespace uicore
 		else
 		{
 			batcher.flush();
+			update_scissor(false);
 			gc()->clear(color);
 		}
 	}
 
-	void CanvasImpl::write_clip(const Rectf &rect)
+	Rect CanvasImpl::clip_pixels(const Rectf &rect) const
 	{
-		if ((rect.left > rect.right) || (rect.top > rect.bottom))
-			throw Exception("Invalid cliprect");
-
 		// Grid-fitted, display pixel ratio scaled clipping rect
-		Rect recti{
+		return Rect{
 			static_cast<int>(std::round(rect.left * gc()->pixel_ratio())),
 			static_cast<int>(std::round(rect.top * gc()->pixel_ratio())),
 			static_cast<int>(std::round(rect.right * gc()->pixel_ratio())),
 			static_cast<int>(std::round(rect.bottom * gc()->pixel_ratio()))
 		};
+	}
+
+	bool CanvasImpl::scissor_fits(bool clips_itself) const
+	{
+		if (cliprects.empty())
+			return !scissor_set;
+
+		// Geometry clipped by its batcher only needs a scissor that keeps everything inside the clip rect
+		Rect clip = clip_pixels(cliprects.back());
+		if (clips_itself)
+			return !scissor_set || (scissor_rect.left <= clip.left && scissor_rect.top <= clip.top && scissor_rect.right >= clip.right && scissor_rect.bottom >= clip.bottom);
+		else
+			return scissor_set && scissor_rect == clip;
+	}
+
+	void CanvasImpl::update_scissor(bool clips_itself)
+	{
+		if (cliprects.empty() || clips_itself)
+		{
+			if (scissor_set)
+			{
+				gc()->reset_scissor();
+				scissor_set = false;
+			}
+		}
+		else
+		{
+			scissor_rect = clip_pixels(cliprects.back());
+			scissor_set = true;
+			gc()->set_scissor(scissor_rect, canvas_y_axis ? y_axis_top_down : y_axis_bottom_up);
+		}
+	}
+
+	void CanvasImpl::clip_changed()
+	{
+		// Without batched clipping every clip change is applied right away, as the scissor is the only clipping
+		if (!canvas_batched_clipping)
+		{
+			batcher.flush(BatchFlushReason::clip_change);
+			update_scissor(false);
+		}
+	}
 
-		gc()->set_scissor(recti, canvas_y_axis ? y_axis_top_down : y_axis_bottom_up);
+	void CanvasImpl::check_clip(const Rectf &rect)
+	{
+		if ((rect.left > rect.right) || (rect.top > rect.bottom))
+			throw Exception("Invalid cliprect");
 	}
 
 	void CanvasImpl::set_clip(const Rectf &rect)
 	{
-		batcher.flush();
+		check_clip(rect);
 
 		if (!cliprects.empty())
 			cliprects.back() = rect;
 		else
 			cliprects.push_back(rect);
-		write_clip(rect);
+		clip_changed();
 	}
 
 	void CanvasImpl::push_clip(const Rectf &rect)
 	{
-		batcher.flush();
-
 		if (!cliprects.empty())
 		{
 			Rectf r = cliprects.back();
@@ -262,13 +373,12 @@ namespace uicore
 			cliprects.push_back(rect);
 		}
 
-		write_clip(cliprects.back());
+		check_clip(cliprects.back());
+		clip_changed();
 	}
 
 	void CanvasImpl::push_clip()
 	{
-		batcher.flush();
-
 		if (cliprects.empty())
 		{
 			cliprects.push_back(gc()->size());
@@ -278,21 +388,15 @@ namespace uicore
 			cliprects.push_back(cliprects.back());
 		}
 
-		write_clip(cliprects.back());
+		clip_changed();
 	}
 
 	void CanvasImpl::pop_clip()
 	{
 		if (!cliprects.empty())
 		{
-			batcher.flush();
-
 			cliprects.pop_back();
-
-			if (cliprects.empty())
-				gc()->reset_scissor();
-			else
-				write_clip(cliprects.back());
+			clip_changed();
 		}
 	}
 
@@ -300,9 +404,8 @@ namespace uicore
 	{
 		if (!cliprects.empty())
 		{
-			batcher.flush();
 			cliprects.clear();
-			gc()->reset_scissor();
+			clip_changed();
 		}
 	}
 
@@ -36,8 +36,10 @@
 #include "UICore/Display/2D/render_batch_line_texture.h"
 #include "UICore/Display/2D/render_batch_point.h"
 #include "UICore/Display/2D/canvas.h"
+#include "UICore/Display/2D/path.h"
 #include "UICore/Display/Window/display_window.h"
 #include "canvas_batcher.h"
+#include "path_mask_cache.h"
 
 namespace uicore
 {
@@ -54,12 +56,13 @@ namespace uicore
 	{
 	public:
 		CanvasImpl(const DisplayWindowPtr &window);
+		CanvasImpl(const GraphicContextPtr &gc, const FrameBufferPtr &frame_buffer = FrameBufferPtr());
 
 		const GraphicContextPtr &gc() const override { return _gc; }
 
-		float width() const override { return gc()->dip_width(); }
-		float height() const override { return gc()->dip_height(); }
-		Sizef size() const override { return gc()->dip_size(); }
+		float width() const override { return size().width; }
+		float height() const override { return size().height; }
+		Sizef size() const override { return canvas_frame_buffer ? Sizef(canvas_frame_buffer->size()) / gc()->pixel_ratio() : gc()->dip_size(); }
 		float pixel_ratio() const override { return gc()->pixel_ratio(); }
 
 		void clear(const Colorf &color) override;
@@ -88,7 +91,48 @@ namespace uicore
 
 		Pointf grid_fit(const Pointf &pos) override;
 
-		void set_batcher(RenderBatcher *batcher);
+		void set_path_rasterizer(PathRasterizer rasterizer) override { canvas_path_rasterizer = rasterizer; }
+		PathRasterizer path_rasterizer() const override { return canvas_path_rasterizer; }
+		void set_path_rasterizer_threads(int num_threads) override { canvas_path_rasterizer_threads = num_threads; }
+		int path_rasterizer_threads() const override { return canvas_path_rasterizer_threads; }
+		void set_path_cache_budget(size_t bytes) override { path_mask_cache.set_budget(bytes); }
+		size_t path_cache_budget() const override { return path_mask_cache.budget(); }
+		PathCacheStats path_cache_stats() const override { return path_mask_cache.stats(); }
+		void set_compact_quads(bool enable) override { canvas_compact_quads = enable; }
+		bool compact_quads() const override { return canvas_compact_quads; }
+		void set_stats_enabled(bool enable) override { batcher.get_batch_buffer()->stats_enabled = enable; }
+		bool stats_enabled() const override { return batcher.get_batch_buffer()->stats_enabled; }
+		const CanvasStats &stats() const override { return batcher.get_batch_buffer()->stats; }
+		void set_batched_clipping(bool enable) override { batcher.flush(); canvas_batched_clipping = enable; update_scissor(false); }
+		bool batched_clipping() const override { return canvas_batched_clipping; }
+
+		/// \brief Makes a batcher active and brings the scissor up to date for the geometry it is about to add
+		///
+		/// clips_itself tells that the geometry was already clipped against batch_clip_rect(). The scissor then
+		/// only has to keep the clip rect, so clip changes do not end the batch.
+		void set_batcher(RenderBatcher *batcher, bool clips_itself = false);
+
+		/// \brief Returns true if batchers may clip their geometry against batch_clip_rect() instead of using the scissor
+		bool can_batch_clip() const { return canvas_batched_clipping && canvas_map_mode == map_2d_upper_left; }
+
+		/// \brief Gets the current clip rect, grid fitted like the scissor. Returns false if nothing is clipped
+		bool batch_clip_rect(Rectf &out_rect) const;
+
+		const DisplayWindowPtr &window() const { return current_window; }
+
+		/// \brief Sets the window repainted when content drawn as a placeholder has finished loading
+		void set_window(const DisplayWindowPtr &window) { current_window = window; }
+
+		/// \brief Sets the graphic context state of the canvas again after another canvas rendered in the middle of its frame
+		///
+		/// The batcher must be flushed before the other canvas begins.
+		void restore_state();
+
+		/// \brief Draws a texture holding premultiplied alpha, such as the result of rendering into a transparent frame buffer
+		void draw_premultiplied(const Texture2DPtr &texture, const Rectf &src, const Rectf &dest);
+
+		/// \brief Set when something still loading was drawn as a placeholder since begin()
+		bool placeholders_drawn = false;
 
 		void set_map_mode(MapMode map_mode);
 		void update_viewport_size();
@@ -99,15 +143,24 @@ namespace uicore
 
 		std::vector<Rectf> cliprects;
 		CanvasBatcher batcher;
+		PathMaskCache path_mask_cache;
 
 	private:
 		void calculate_map_mode_matrices();
 		MapMode top_down_map_mode() const;
 		void update_batcher_matrix();
-		void write_clip(const Rectf &rect);
+		Rect clip_pixels(const Rectf &rect) const;
+		bool scissor_fits(bool clips_itself) const;
+		void update_scissor(bool clips_itself);
+		void clip_changed();
+		static void check_clip(const Rectf &rect);
 
 		GraphicContextPtr _gc;
 
+		FrameBufferPtr canvas_frame_buffer;	// Bound between begin() and end() when the canvas renders offscreen
+		FrameBufferPtr prev_write_frame_buffer;
+		FrameBufferPtr prev_read_frame_buffer;
+
 		Mat4f canvas_transform;
 		mutable bool canvas_inverse_transform_set = false;
 		mutable Mat4f canvas_inverse_transform;
@@ -119,9 +172,17 @@ namespace uicore
 
 		RasterizerStatePtr rasterizer_state;
 		BlendStatePtr opaque_blend;
+		BlendStatePtr premultiplied_blend;
 		DepthStencilStatePtr depth_stencil_state;
 
 		TextureImageYAxis canvas_y_axis;
+		PathRasterizer canvas_path_rasterizer = PathRasterizer::analytic;
+		int canvas_path_rasterizer_threads = 1;
+		bool canvas_compact_quads = true;
+		bool canvas_batched_clipping = true;
+
+		bool scissor_set = false;	// The gc has a scissor rect
+		Rect scissor_rect;	// Scissor rect on the gc, in pixels
 
 		ClipZRange gc_clip_z_range;
 	};
@@ -35,6 +35,7 @@
 #include "UICore/Display/Render/texture_2d.h"
 #include "UICore/Core/Text/text.h"
 #include "UICore/Core/Math/quad.h"
+#include "UICore/Display/Render/texture_upload_queue.h"
 #include "render_batch_triangle.h"
 #include "canvas_impl.h"
 
@@ -48,6 +49,7 @@ namespace uicore
 		ImageImpl(Texture2DPtr texture, const Rect &rect, float _pixel_ratio);
 		ImageImpl(TextureGroupImage &sub_texture, float _pixel_ratio);
 		ImageImpl(const CanvasPtr &canvas, const std::string &filename, const ImageImportDescription &import_desc, float _pixel_ratio);
+		ImageImpl(std::shared_ptr<AsyncTexture> pending, float _pixel_ratio);
 
 		float scale_x() const override { return _scale_x; }
 		float scale_y() const override { return _scale_y; }
@@ -57,6 +59,8 @@ namespace uicore
 		Sizef size() const override;
 		float width() const override;
 		float height() const override;
+		bool is_ready() const override;
+		Signal<void()> &sig_ready() override;
 		std::shared_ptr<Image> clone() const override;
 		void draw(const CanvasPtr &canvas, float x, float y) const override;
 		void draw(const CanvasPtr &canvas, const Rectf &src, const Rectf &dest) const override;
@@ -70,7 +74,9 @@ namespace uicore
 		void set_linear_filter(bool linear_filter = true) override;
 
 	private:
-		void calc_hotspot();
+		bool update_texture() const;
+		bool prepare_draw(const CanvasPtr &canvas) const;
+		void calc_hotspot() const;
 
 		Colorf _color = StandardColorf::white();
 
@@ -80,11 +86,14 @@ namespace uicore
 		Pointf _translation_hotspot;
 		Origin _translation_origin = origin_top_left;
 
-		Pointf _translated_hotspot;	// Precalculated from calc_hotspot()
+		mutable Pointf _translated_hotspot;	// Precalculated from calc_hotspot()
 
-		Texture2DPtr _texture;
-		Rect _texture_rect;
+		mutable Texture2DPtr _texture;
+		mutable Rect _texture_rect;
 		float _pixel_ratio = 1.0f;
+
+		mutable std::shared_ptr<AsyncTexture> _pending;	// Texture still loading, moved to _texture by update_texture()
+		Signal<void()> _sig_ready;	// Never emitted, for images that were ready from the start
 	};
 
 	std::shared_ptr<Image> Image::create(Texture2DPtr texture, const Rect &rect, float pixel_ratio)
@@ -107,6 +116,11 @@ namespace uicore
 		return std::make_shared<ImageImpl>(canvas, filename, import_desc, pixel_ratio);
 	}
 
+	std::shared_ptr<Image> Image::create_async(const CanvasPtr &canvas, const std::string &filename, const ImageImportDescription &import_desc, float pixel_ratio)
+	{
+		return std::make_shared<ImageImpl>(TextureUploadQueue::get(canvas->gc())->load(filename, import_desc), pixel_ratio);
+	}
+
 	ImageImpl::ImageImpl(const CanvasPtr &canvas, const PixelBufferPtr &pb, const Rect &rect, float pixel_ratio)
 	{
 		_texture = Texture2D::create(canvas->gc(), pb->width(), pb->height(), pb->format());
@@ -136,13 +150,54 @@ namespace uicore
 		_pixel_ratio = pixel_ratio;
 	}
 
+	ImageImpl::ImageImpl(std::shared_ptr<AsyncTexture> pending, float pixel_ratio)
+	{
+		_pending = std::move(pending);
+		_pixel_ratio = pixel_ratio;
+	}
+
 	std::shared_ptr<Image> ImageImpl::clone() const
 	{
 		return std::make_shared<ImageImpl>(*this);
 	}
 
+	bool ImageImpl::is_ready() const
+	{
+		update_texture();
+		return !_pending;
+	}
+
+	Signal<void()> &ImageImpl::sig_ready()
+	{
+		return _pending ? _pending->sig_ready : _sig_ready;
+	}
+
+	bool ImageImpl::update_texture() const
+	{
+		if (_pending && _pending->ready)
+		{
+			_texture = _pending->texture;
+			_texture_rect = _texture ? Rect(_texture->size()) : Rect();
+			_pending.reset();
+			calc_hotspot();
+		}
+		return _texture != nullptr;
+	}
+
+	bool ImageImpl::prepare_draw(const CanvasPtr &canvas) const
+	{
+		if (update_texture())
+			return true;
+
+		// Images still loading draw nothing. Tell the canvas, so that layers holding the result are drawn again later
+		if (_pending)
+			static_cast<CanvasImpl*>(canvas.get())->placeholders_drawn = true;
+		return false;
+	}
+
 	TextureGroupImage ImageImpl::texture() const
 	{
+		update_texture();
 		return TextureGroupImage(_texture, _texture_rect);
 	}
 
@@ -155,6 +210,7 @@ namespace uicore
 
 	float ImageImpl::width() const
 	{
+		update_texture();
 		if (_pixel_ratio != 0.0f)
 			return _texture_rect.width() / _pixel_ratio;
 		else
@@ -163,6 +219,7 @@ namespace uicore
 
 	float ImageImpl::height() const
 	{
+		update_texture();
 		if (_pixel_ratio != 0.0f)
 			return _texture_rect.height() / _pixel_ratio;
 		else
@@ -176,6 +233,9 @@ namespace uicore
 
 	void ImageImpl::draw(const CanvasPtr &canvas, float x, float y) const
 	{
+		if (!prepare_draw(canvas))
+			return;
+
 		Rectf dest(
 			x + _translated_hotspot.x, y + _translated_hotspot.y,
 			Sizef(width() * _scale_x, height() * _scale_y));
@@ -186,6 +246,9 @@ namespace uicore
 
 	void ImageImpl::draw(const CanvasPtr &canvas, const Rectf &src, const Rectf &dest) const
 	{
+		if (!prepare_draw(canvas))
+			return;
+
 		Rectf new_src = src;
 		new_src.translate(_texture_rect.left, _texture_rect.top);
 
@@ -198,6 +261,9 @@ namespace uicore
 
 	void ImageImpl::draw(const CanvasPtr &canvas, const Rectf &dest) const
 	{
+		if (!prepare_draw(canvas))
+			return;
+
 		Rectf new_dest = dest;
 		new_dest.translate(_translated_hotspot);
 
@@ -207,6 +273,9 @@ namespace uicore
 
 	void ImageImpl::draw(const CanvasPtr &canvas, const Rectf &src, const Quadf &dest) const
 	{
+		if (!prepare_draw(canvas))
+			return;
+
 		Rectf new_src = src;
 		new_src.translate(_texture_rect.left, _texture_rect.top);
 
@@ -222,6 +291,9 @@ namespace uicore
 
 	void ImageImpl::draw(const CanvasPtr &canvas, const Quadf &dest) const
 	{
+		if (!prepare_draw(canvas))
+			return;
+
 		Quadf new_dest = dest;
 		new_dest.p += _translated_hotspot;
 		new_dest.q += _translated_hotspot;
@@ -254,16 +326,35 @@ namespace uicore
 
 	void ImageImpl::set_wrap_mode(TextureWrapMode wrap_s, TextureWrapMode wrap_t)
 	{
-		_texture->set_wrap_mode(wrap_s, wrap_t);
+		update_texture();
+		if (_pending)
+		{
+			_pending->set_wrap_mode = true;
+			_pending->wrap_s = wrap_s;
+			_pending->wrap_t = wrap_t;
+		}
+		else if (_texture)
+		{
+			_texture->set_wrap_mode(wrap_s, wrap_t);
+		}
 	}
 
 	void ImageImpl::set_linear_filter(bool linear_filter)
 	{
-		_texture->set_mag_filter(linear_filter ? filter_linear : filter_nearest);
-		_texture->set_min_filter(linear_filter ? filter_linear : filter_nearest);
+		update_texture();
+		if (_pending)
+		{
+			_pending->set_filter = true;
+			_pending->linear_filter = linear_filter;
+		}
+		else if (_texture)
+		{
+			_texture->set_mag_filter(linear_filter ? filter_linear : filter_nearest);
+			_texture->set_min_filter(linear_filter ? filter_linear : filter_nearest);
+		}
 	}
 
-	void ImageImpl::calc_hotspot()
+	void ImageImpl::calc_hotspot() const
 	{
 		switch (_translation_origin)
 		{
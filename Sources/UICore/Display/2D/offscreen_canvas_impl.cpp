@@ -0,0 +1,119 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "UICore/Display/2D/canvas.h"
+#include "UICore/Display/Render/texture_2d.h"
+#include "UICore/Software/software_target.h"
+#include "UICore/Display/Render/graphic_context_impl.h"
+#include "offscreen_canvas_impl.h"
+#include "canvas_impl.h"
+#include <cstring>
+
+namespace uicore
+{
+	std::shared_ptr<OffscreenCanvas> OffscreenCanvas::create(const GraphicContextPtr &gc, const Size &size)
+	{
+		return std::make_shared<OffscreenCanvasImpl>(gc, size);
+	}
+
+	std::shared_ptr<OffscreenCanvas> OffscreenCanvas::create(const Size &size, float pixel_ratio)
+	{
+		return std::make_shared<OffscreenCanvasImpl>(size, pixel_ratio);
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	OffscreenCanvasImpl::OffscreenCanvasImpl(const GraphicContextPtr &gc, const Size &size) : _size(size), gc(gc)
+	{
+		_texture = Texture2D::create(gc, size, tf_rgba8);
+		frame_buffer = FrameBuffer::create(gc);
+		frame_buffer->attach_color(0, _texture);
+		_canvas = std::make_shared<CanvasImpl>(gc, frame_buffer);
+	}
+
+	OffscreenCanvasImpl::OffscreenCanvasImpl(const Size &size, float pixel_ratio) : _size(size)
+	{
+		software_pixels = PixelBuffer::create(size.width, size.height, tf_rgba8);
+		software_pixels->set_pixel_ratio(pixel_ratio);
+		gc = SoftwareTarget::create_graphic_context(software_pixels);
+		_canvas = Canvas::create(gc);
+	}
+
+	void OffscreenCanvasImpl::start_readback()
+	{
+		if (software_pixels || !async_readback)
+			return;
+
+		if (!staging)
+			staging = StagingTexture::create(gc, _size.width, _size.height, StagingDirection::from_gpu, tf_rgba8, nullptr, usage_stream_read);
+
+		FrameBufferPtr prev_write_frame_buffer = gc->write_frame_buffer();
+		FrameBufferPtr prev_read_frame_buffer = gc->read_frame_buffer();
+		gc->set_frame_buffer(frame_buffer);
+
+		async_readback = static_cast<GraphicContextImpl*>(gc.get())->read_pixels_async(_size, staging);
+
+		gc->set_frame_buffer(prev_write_frame_buffer, prev_read_frame_buffer);
+
+		_readback_pending = async_readback;
+	}
+
+	PixelBufferPtr OffscreenCanvasImpl::pixels()
+	{
+		if (!_readback_pending)
+			start_readback();
+
+		PixelBufferPtr result;
+		if (software_pixels)
+			result = software_pixels->copy();
+		else if (_readback_pending)
+			result = read_staging();
+		else
+			result = _texture->pixeldata(gc, tf_rgba8);
+
+		result->set_pixel_ratio(gc->pixel_ratio());
+		return result;
+	}
+
+	PixelBufferPtr OffscreenCanvasImpl::read_staging()
+	{
+		_readback_pending = false;
+
+		auto result = PixelBuffer::create(_size.width, _size.height, tf_rgba8);
+		size_t row_size = _size.width * 4;
+
+		staging->lock(gc, access_read_only);
+		for (int y = 0; y < _size.height; y++)
+			memcpy(result->line_uint8(y), staging->line_uint8(y), row_size);
+		staging->unlock();
+
+		return result;
+	}
+}
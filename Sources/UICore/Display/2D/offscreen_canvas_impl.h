@@ -0,0 +1,67 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include "UICore/Display/2D/offscreen_canvas.h"
+#include "UICore/Display/Render/graphic_context.h"
+#include "UICore/Display/Render/staging_texture.h"
+#include "UICore/Display/Render/frame_buffer.h"
+#include "UICore/Display/Image/pixel_buffer.h"
+
+namespace uicore
+{
+	class OffscreenCanvasImpl : public OffscreenCanvas
+	{
+	public:
+		OffscreenCanvasImpl(const GraphicContextPtr &gc, const Size &size);
+		OffscreenCanvasImpl(const Size &size, float pixel_ratio);
+
+		const CanvasPtr &canvas() const override { return _canvas; }
+		const Texture2DPtr &texture() const override { return _texture; }
+		Size size() const override { return _size; }
+
+		void start_readback() override;
+		bool readback_pending() const override { return _readback_pending; }
+		PixelBufferPtr pixels() override;
+
+	private:
+		PixelBufferPtr read_staging();
+
+		Size _size;
+		GraphicContextPtr gc;
+		CanvasPtr _canvas;
+		Texture2DPtr _texture;
+		FrameBufferPtr frame_buffer;
+		StagingTexturePtr staging;
+		PixelBufferPtr software_pixels;	// Target of the software graphic context
+		bool _readback_pending = false;
+		bool async_readback = true;	// Cleared if the graphic context cannot read into a staging texture
+	};
+}
@@ -55,6 +55,7 @@ namespace uicore
 
 	void PathImpl::move_to(const Pointf &point)
 	{
+		geometry_changed();
 		if (!_subpaths.back().commands.empty())
 			_subpaths.push_back(PathSubpath());
 
@@ -63,12 +64,14 @@ namespace uicore
 
 	void PathImpl::line_to(const Pointf &point)
 	{
+		geometry_changed();
 		_subpaths.back().points.push_back(point);
 		_subpaths.back().commands.push_back(PathCommand::line);
 	}
 
 	void PathImpl::bezier_to(const Pointf &control, const Pointf &point)
 	{
+		geometry_changed();
 		_subpaths.back().points.push_back(control);
 		_subpaths.back().points.push_back(point);
 		_subpaths.back().commands.push_back(PathCommand::quadradic);
@@ -76,6 +79,7 @@ namespace uicore
 
 	void PathImpl::bezier_to(const Pointf &control1, const Pointf &control2, const Pointf &point)
 	{
+		geometry_changed();
 		_subpaths.back().points.push_back(control1);
 		_subpaths.back().points.push_back(control2);
 		_subpaths.back().points.push_back(point);
@@ -84,6 +88,7 @@ namespace uicore
 
 	void PathImpl::close()
 	{
+		geometry_changed();
 		if (!_subpaths.back().commands.empty())
 		{
 			_subpaths.back().closed = true;
@@ -160,6 +165,7 @@ namespace uicore
 		PathImpl *other = static_cast<PathImpl*>(path.get());
 		if (other != this && !other->_subpaths.empty())
 		{
+			geometry_changed();
 			_subpaths.reserve(_subpaths.size() + other->_subpaths.size());
 			_subpaths.insert(_subpaths.end(), other->_subpaths.begin(), other->_subpaths.end());
 		}
@@ -167,6 +173,7 @@ namespace uicore
 
 	void PathImpl::apply_transform(const Mat3f &transform)
 	{
+		geometry_changed();
 		for (auto & elem : _subpaths)
 		{
 			std::vector<Pointf> &points = elem.points;
@@ -182,6 +189,33 @@ namespace uicore
 		return std::make_shared<PathImpl>(*this);
 	}
 
+	uint64_t PathImpl::geometry_hash() const
+	{
+		if (!_geometry_hash_valid)
+		{
+			// FNV-1a over the points, commands and subpath boundaries
+			uint64_t hash = 14695981039346656037ULL;
+			auto add_bytes = [&](const void *data, size_t size)
+			{
+				const unsigned char *bytes = static_cast<const unsigned char *>(data);
+				for (size_t i = 0; i < size; i++)
+					hash = (hash ^ bytes[i]) * 1099511628211ULL;
+			};
+
+			for (const auto &subpath : _subpaths)
+			{
+				uint32_t sizes[3] = { static_cast<uint32_t>(subpath.points.size()), static_cast<uint32_t>(subpath.commands.size()), subpath.closed ? 1u : 0u };
+				add_bytes(sizes, sizeof(sizes));
+				add_bytes(subpath.points.data(), subpath.points.size() * sizeof(Pointf));
+				add_bytes(subpath.commands.data(), subpath.commands.size() * sizeof(PathCommand));
+			}
+
+			_geometry_hash = hash;
+			_geometry_hash_valid = true;
+		}
+		return _geometry_hash;
+	}
+
 	void PathImpl::stroke(const CanvasPtr &canvas, const Pen &pen)
 	{
 		RenderBatchPath *batcher = static_cast<CanvasImpl*>(canvas.get())->batcher.get_path_batcher();
@@ -190,10 +224,68 @@ namespace uicore
 
 	void PathImpl::fill(const CanvasPtr &canvas, const Brush &brush)
 	{
+		// Backgrounds and borders of views need no coverage mask. As quads they stay in the batch of the text and images around them
+		Rectf box;
+		if (brush.type == BrushType::solid && pixel_aligned_rect(canvas, box))
+		{
+			static_cast<CanvasImpl*>(canvas.get())->batcher.get_triangle_batcher()->fill(canvas, box.left, box.top, box.right, box.bottom, brush.color);
+			return;
+		}
+
 		RenderBatchPath *batcher = static_cast<CanvasImpl*>(canvas.get())->batcher.get_path_batcher();
 		batcher->fill(canvas, *this, brush);
 	}
 
+	bool PathImpl::pixel_aligned_rect(const CanvasPtr &canvas, Rectf &out_box) const
+	{
+		// close() leaves an empty subpath behind
+		size_t num_subpaths = _subpaths.size();
+		while (num_subpaths > 1 && _subpaths[num_subpaths - 1].commands.empty())
+			num_subpaths--;
+		if (num_subpaths != 1)
+			return false;
+
+		// Four corners connected by lines, as added by add_rect. Border area paths also draw the line back to the first corner
+		const PathSubpath &subpath = _subpaths.front();
+		size_t num_lines = subpath.commands.size();
+		if (num_lines != 3 && num_lines != 4)
+			return false;
+		for (PathCommand command : subpath.commands)
+		{
+			if (command != PathCommand::line)
+				return false;
+		}
+
+		const auto &p = subpath.points;
+		if (num_lines == 4 && p[4] != p[0])
+			return false;
+
+		bool horizontal_first = p[0].y == p[1].y && p[1].x == p[2].x && p[2].y == p[3].y && p[3].x == p[0].x;
+		bool vertical_first = p[0].x == p[1].x && p[1].y == p[2].y && p[2].x == p[3].x && p[3].y == p[0].y;
+		if (!horizontal_first && !vertical_first)
+			return false;
+
+		// Only a scale and translation keeps the rectangle axis aligned
+		const float *m = canvas->transform().matrix;
+		if (m[0 * 4 + 1] != 0.0f || m[1 * 4 + 0] != 0.0f || m[0 * 4 + 3] != 0.0f || m[1 * 4 + 3] != 0.0f || m[3 * 4 + 3] != 1.0f)
+			return false;
+
+		float scale_x = m[0 * 4 + 0] * canvas->pixel_ratio();
+		float scale_y = m[1 * 4 + 1] * canvas->pixel_ratio();
+		float offset_x = m[3 * 4 + 0] * canvas->pixel_ratio();
+		float offset_y = m[3 * 4 + 1] * canvas->pixel_ratio();
+		for (int i = 0; i < 4; i += 2)
+		{
+			float x = scale_x * p[i].x + offset_x;
+			float y = scale_y * p[i].y + offset_y;
+			if (x != std::round(x) || y != std::round(y))
+				return false;
+		}
+
+		out_box = Rectf(std::min(p[0].x, p[2].x), std::min(p[0].y, p[2].y), std::max(p[0].x, p[2].x), std::max(p[0].y, p[2].y));
+		return true;
+	}
+
 	void PathImpl::fill_and_stroke(const CanvasPtr &canvas, const Pen &pen, const Brush &brush)
 	{
 		RenderBatchPath *batcher = static_cast<CanvasImpl*>(canvas.get())->batcher.get_path_batcher();
@@ -0,0 +1,388 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+**    Mark Page
+*/
+
+#include "UICore/precomp.h"
+#include "path_area_rasterizer.h"
+#include "UICore/Core/System/system.h"
+#include "path_raster_threads.h"
+#include <algorithm>
+#include <cmath>
+
+#if !defined __ANDROID__ && ! defined CL_DISABLE_SSE2
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#endif
+
+namespace uicore
+{
+	void PathAreaRasterizer::clear(int new_width, int new_height)
+	{
+		edges.clear();
+		width = new_width;
+		height = new_height;
+	}
+
+	void PathAreaRasterizer::line(float x0, float y0, float x1, float y1)
+	{
+		if (y0 == y1)	// Horizontal edges cover no area
+			return;
+
+		if (y0 < y1)
+			edges.push_back(PathAreaEdge(x0, y0, x1, y1, 1.0f));
+		else
+			edges.push_back(PathAreaEdge(x1, y1, x0, y0, -1.0f));
+	}
+
+	void PathAreaRasterizer::begin(PathFillMode mode, int num_threads)
+	{
+		std::sort(edges.begin(), edges.end(), [](const PathAreaEdge &a, const PathAreaEdge &b) { return a.y0 < b.y0; });
+
+		float bottom = 0.0f;
+		for (const auto &edge : edges)
+			bottom = std::max(bottom, edge.y1);
+
+		int start_y = edges.empty() ? 0 : static_cast<int>(std::max(edges.front().y0, 0.0f)) / block_size * block_size;
+		int end_y = std::min(static_cast<int>(std::ceil(bottom)), height);
+		int num_rows = std::max((end_y - start_y + block_size - 1) / block_size, 0);
+
+		num_threads = std::max(std::min(num_threads, num_rows / min_rows_per_thread), 1);
+		while (scanners.size() < static_cast<size_t>(num_threads))
+			scanners.push_back(std::unique_ptr<PathAreaScanner>(new PathAreaScanner()));
+
+		threaded = num_threads > 1;
+		if (threaded)
+			rasterize_bands(mode, num_threads, start_y, end_y);
+		else
+			scanners[0]->begin(&edges, width, mode, start_y, end_y, nullptr);
+	}
+
+	void PathAreaRasterizer::rasterize_bands(PathFillMode mode, int num_threads, int start_y, int end_y)
+	{
+		int num_rows = (end_y - start_y + block_size - 1) / block_size;
+		int num_bands = std::min(num_rows, num_threads * bands_per_thread);
+
+		row_results.clear();
+		row_results.resize(num_rows);
+		coverage_image.resize(width * height);
+		first_result_y = start_y;
+		next_result = 0;
+
+		PathRasterThreads::instance().run(num_threads, num_bands, [&](int band, int thread_index)
+		{
+			int band_start_y = start_y + num_rows * band / num_bands * block_size;
+			int band_end_y = std::min(start_y + num_rows * (band + 1) / num_bands * block_size, end_y);
+
+			PathAreaScanner &scanner = *scanners[thread_index];
+			scanner.begin(&edges, width, mode, band_start_y, band_end_y, coverage_image.data());
+			while (scanner.next_row())
+			{
+				RowResult &result = row_results[(scanner.row_y - start_y) / block_size];
+				result.left = scanner.row_left;
+				result.right = scanner.row_right;
+			}
+		});
+	}
+
+	bool PathAreaRasterizer::next_row()
+	{
+		if (threaded)
+		{
+			while (next_result < row_results.size())
+			{
+				const RowResult &result = row_results[next_result];
+				row_y = first_result_y + static_cast<int>(next_result) * block_size;
+				next_result++;
+
+				if (result.left < result.right)
+				{
+					row_left = result.left;
+					row_right = result.right;
+					row_coverage = coverage_image.data() + row_y * width;
+					return true;
+				}
+			}
+			return false;
+		}
+		else
+		{
+			PathAreaScanner &scanner = *scanners[0];
+			if (!scanner.next_row())
+				return false;
+
+			row_y = scanner.row_y;
+			row_left = scanner.row_left;
+			row_right = scanner.row_right;
+			row_coverage = scanner.coverage();
+			return true;
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	PathAreaScanner::PathAreaScanner()
+	{
+	}
+
+	PathAreaScanner::~PathAreaScanner()
+	{
+		System::aligned_free(accumulation);
+	}
+
+	void PathAreaScanner::begin(const std::vector<PathAreaEdge> *new_edges, int new_width, PathFillMode new_mode, int start_y, int end_y, unsigned char *new_image)
+	{
+		edges = new_edges;
+		mode = new_mode;
+		image = new_image;
+
+		if (width != new_width)
+		{
+			width = new_width;
+
+			// Edges at the right border write up to two cells past the last pixel
+			accumulation_pitch = width + 4;
+			System::aligned_free(accumulation);
+			accumulation = (float*)System::aligned_alloc(accumulation_pitch * block_size * sizeof(float));
+			std::fill(accumulation, accumulation + accumulation_pitch * block_size, 0.0f);
+
+			row_coverage.resize(width * block_size);
+		}
+
+		// Edges starting above start_y are picked up by the first row
+		next_edge = 0;
+		active_edges.clear();
+		next_row_y = start_y;
+		end_row_y = end_y;
+	}
+
+	bool PathAreaScanner::next_row()
+	{
+		const std::vector<PathAreaEdge> &edges = *this->edges;
+		while (next_row_y < end_row_y)
+		{
+			int top = next_row_y;
+			int bottom = top + block_size;
+			next_row_y = bottom;
+
+			// Update the active edge table
+			while (next_edge < edges.size() && edges[next_edge].y0 < bottom)
+				active_edges.push_back(next_edge++);
+			active_edges.erase(std::remove_if(active_edges.begin(), active_edges.end(), [&](size_t index) { return edges[index].y1 <= top; }), active_edges.end());
+
+			if (active_edges.empty())
+			{
+				// Skip directly to the row of the next edge
+				if (next_edge < edges.size())
+					next_row_y = std::max(next_row_y, static_cast<int>(edges[next_edge].y0) / block_size * block_size);
+				continue;
+			}
+
+			touched_left = accumulation_pitch;
+			touched_right = 0;
+			for (size_t index : active_edges)
+				accumulate(edges[index], top, bottom);
+
+			if (touched_left >= touched_right)
+				continue;
+
+			row_y = top;
+			row_left = std::min(touched_left / block_size * block_size, width);
+			row_right = std::min((touched_right + block_size - 1) / block_size * block_size, width);
+
+			for (int row = 0; row < block_size; row++)
+				resolve_row(row);
+
+			if (row_left < row_right)
+				return true;
+		}
+		return false;
+	}
+
+	void PathAreaScanner::accumulate(const PathAreaEdge &edge, int top, int bottom)
+	{
+		float ystart = std::max(edge.y0, static_cast<float>(top));
+		float yend = std::min(edge.y1, static_cast<float>(bottom));
+		if (ystart >= yend)
+			return;
+
+		float dxdy = (edge.x1 - edge.x0) / (edge.y1 - edge.y0);
+		float x = edge.x0 + (ystart - edge.y0) * dxdy;
+
+		int last_y = static_cast<int>(std::ceil(yend));
+		for (int y = static_cast<int>(ystart); y < last_y; y++)
+		{
+			float dy = std::min(y + 1.0f, yend) - std::max(static_cast<float>(y), ystart);
+			float xnext = x + dxdy * dy;
+			accumulate_span(accumulation + (y - top) * accumulation_pitch, x, xnext, dy * edge.direction);
+			x = xnext;
+		}
+	}
+
+	void PathAreaScanner::accumulate_span(float *line, float x0, float x1, float delta)
+	{
+		// Split the span at the mask borders. Parts outside the mask become vertical edges on the border,
+		// as they still cover the pixels to their right completely
+		float max_x = static_cast<float>(width);
+		if ((x0 < 0.0f && x1 > 0.0f) || (x0 > 0.0f && x1 < 0.0f))
+		{
+			float t = -x0 / (x1 - x0);
+			accumulate_span(line, x0, 0.0f, delta * t);
+			accumulate_span(line, 0.0f, x1, delta - delta * t);
+		}
+		else if ((x0 < max_x && x1 > max_x) || (x0 > max_x && x1 < max_x))
+		{
+			float t = (max_x - x0) / (x1 - x0);
+			accumulate_span(line, x0, max_x, delta * t);
+			accumulate_span(line, max_x, x1, delta - delta * t);
+		}
+		else
+		{
+			x0 = std::min(std::max(x0, 0.0f), max_x);
+			x1 = std::min(std::max(x1, 0.0f), max_x);
+			if (x0 > x1)
+				std::swap(x0, x1);
+			accumulate_cells(line, x0, x1, delta);
+		}
+	}
+
+	void PathAreaScanner::accumulate_cells(float *line, float x0, float x1, float delta)
+	{
+		float x0_floor = std::floor(x0);
+		float x1_ceil = std::ceil(x1);
+		int x0i = static_cast<int>(x0_floor);
+		int x1i = static_cast<int>(x1_ceil);
+
+		touched_left = std::min(touched_left, x0i);
+
+		if (x1i <= x0i + 1)
+		{
+			// The edge stays within one cell. The area right of it goes to this cell and the rest to the next
+			float xmid = 0.5f * (x0 + x1) - x0_floor;
+			line[x0i] += delta - delta * xmid;
+			line[x0i + 1] += delta * xmid;
+			touched_right = std::max(touched_right, x0i + 2);
+		}
+		else
+		{
+			float rcp_width = 1.0f / (x1 - x0);
+			float x0_frac = x0 - x0_floor;
+			float first_area = 0.5f * rcp_width * (1.0f - x0_frac) * (1.0f - x0_frac);
+			float x1_frac = x1 - x1_ceil + 1.0f;
+			float last_area = 0.5f * rcp_width * x1_frac * x1_frac;
+
+			line[x0i] += delta * first_area;
+			if (x1i == x0i + 2)
+			{
+				line[x0i + 1] += delta * (1.0f - first_area - last_area);
+			}
+			else
+			{
+				float second_area = rcp_width * (1.5f - x0_frac);
+				line[x0i + 1] += delta * (second_area - first_area);
+				for (int x = x0i + 2; x < x1i - 1; x++)
+					line[x] += delta * rcp_width;
+				float covered_area = second_area + (x1i - x0i - 3) * rcp_width;
+				line[x1i - 1] += delta * (1.0f - covered_area - last_area);
+			}
+			line[x1i] += delta * last_area;
+			touched_right = std::max(touched_right, x1i + 1);
+		}
+	}
+
+	void PathAreaScanner::resolve_row(int row)
+	{
+		float *line = accumulation + row * accumulation_pitch;
+		unsigned char *output = coverage() + row * width;
+
+#ifdef __SSE2__
+		const __m128 sign_mask = _mm_set1_ps(-0.0f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 two = _mm_set1_ps(2.0f);
+		const __m128 scale = _mm_set1_ps(255.0f);
+		const __m128 zero = _mm_setzero_ps();
+		bool nonzero = mode == PathFillMode::winding;
+
+		__m128 sum = zero;
+		for (int x = row_left; x < row_right; x += 16)
+		{
+			__m128i values[4];
+			for (int i = 0; i < 4; i++)
+			{
+				// Prefix sum of four cells, plus everything to the left
+				__m128 v = _mm_load_ps(line + x + i * 4);
+				v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)));
+				v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+				v = _mm_add_ps(v, sum);
+				sum = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+				_mm_store_ps(line + x + i * 4, zero);
+
+				__m128 coverage = _mm_andnot_ps(sign_mask, v);
+				if (nonzero)
+				{
+					coverage = _mm_min_ps(coverage, one);
+				}
+				else
+				{
+					// Fold the winding number so odd windings are inside: 1 - |1 - (w mod 2)|
+					__m128 whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(coverage, half)));
+					coverage = _mm_sub_ps(coverage, _mm_mul_ps(whole, two));
+					coverage = _mm_sub_ps(one, _mm_andnot_ps(sign_mask, _mm_sub_ps(one, coverage)));
+				}
+				values[i] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(coverage, scale), half));
+			}
+
+			__m128i packed = _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+			_mm_storeu_si128((__m128i*)(output + x), packed);
+		}
+#else
+		float sum = 0.0f;
+		for (int x = row_left; x < row_right; x++)
+		{
+			sum += line[x];
+			line[x] = 0.0f;
+
+			float coverage = std::abs(sum);
+			if (mode == PathFillMode::winding)
+			{
+				coverage = std::min(coverage, 1.0f);
+			}
+			else
+			{
+				coverage -= 2.0f * std::floor(coverage * 0.5f);
+				coverage = 1.0f - std::abs(1.0f - coverage);
+			}
+			output[x] = static_cast<unsigned char>(coverage * 255.0f + 0.5f);
+		}
+#endif
+
+		// Cells left of row_left are never touched, but edges past the right border may be
+		for (int x = row_right; x < touched_right; x++)
+			line[x] = 0.0f;
+	}
+}
@@ -0,0 +1,165 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+**    Mark Page
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "UICore/Display/2D/path.h"
+
+namespace uicore
+{
+	class PathAreaEdge
+	{
+	public:
+		PathAreaEdge() { }
+		PathAreaEdge(float x0, float y0, float x1, float y1, float direction) : x0(x0), y0(y0), x1(x1), y1(y1), direction(direction) { }
+
+		float x0, y0;	// Top point
+		float x1, y1;	// Bottom point
+		float direction;	// 1 = downwards, -1 = upwards
+	};
+
+	/// \brief Rasterizes a range of block rows from a sorted edge list
+	///
+	/// Edges are kept in an active edge table. Each edge adds the area to its right to an accumulation
+	/// buffer, and a prefix sum along every scanline turns that into the winding number of each pixel.
+	class PathAreaScanner
+	{
+	public:
+		PathAreaScanner();
+		~PathAreaScanner();
+		PathAreaScanner(const PathAreaScanner &) = delete;
+		PathAreaScanner &operator=(const PathAreaScanner &) = delete;
+
+		/// \brief Starts scanning the rows from start_y to end_y
+		///
+		/// \param image Mask sized image the rows are written to. If null, rows are written to an internal row buffer
+		void begin(const std::vector<PathAreaEdge> *edges, int width, PathFillMode mode, int start_y, int end_y, unsigned char *image);
+
+		/// \brief Rasterizes the next row of blocks that has coverage
+		///
+		/// \return False when there are no more rows
+		bool next_row();
+
+		/// \brief Coverage of the current row, with width bytes between each line
+		unsigned char *coverage() { return image ? image + row_y * width : row_coverage.data(); }
+
+		int row_y = 0;	// Top of the current row
+		int row_left = 0;	// Blocks in the current row with coverage (multiples of block_size)
+		int row_right = 0;
+
+		static const int block_size = 16;
+
+	private:
+		void accumulate(const PathAreaEdge &edge, int top, int bottom);
+		void accumulate_span(float *line, float x0, float x1, float delta);
+		void accumulate_cells(float *line, float x0, float x1, float delta);
+		void resolve_row(int row);
+
+		const std::vector<PathAreaEdge> *edges = nullptr;
+		int width = 0;
+		PathFillMode mode = PathFillMode::alternate;
+
+		size_t next_edge = 0;
+		std::vector<size_t> active_edges;
+		int next_row_y = 0;
+		int end_row_y = 0;
+
+		float *accumulation = nullptr;	// block_size lines of accumulation_pitch floats
+		int accumulation_pitch = 0;
+		int touched_left = 0;	// Accumulation cells written in the current row
+		int touched_right = 0;
+
+		unsigned char *image = nullptr;
+		std::vector<unsigned char> row_coverage;	// block_size lines of width bytes
+	};
+
+	/// \brief Computes exact path coverage from the signed area each edge covers
+	///
+	/// Rows of mask blocks are rasterized one at a time. Large paths can be split into bands of
+	/// rows that are rasterized on several threads, and then returned in the same order.
+	class PathAreaRasterizer
+	{
+	public:
+		/// \brief Removes all edges and sets the mask size in pixels (a multiple of block_size)
+		void clear(int width, int height);
+
+		/// \brief Adds an edge, in pixels
+		void line(float x0, float y0, float x1, float y1);
+
+		bool is_empty() const { return edges.empty(); }
+
+		/// \brief Prepares the edges for rasterization, starting at the top
+		///
+		/// \param num_threads Maximum number of threads rasterizing rows, including the calling thread
+		void begin(PathFillMode mode, int num_threads = 1);
+
+		/// \brief Moves to the next row of blocks that has coverage
+		///
+		/// \return False when there are no more rows
+		bool next_row();
+
+		/// \brief Coverage of the current row, starting at x
+		const unsigned char *coverage(int x) const { return row_coverage + x; }
+		int coverage_pitch() const { return width; }
+
+		int row_y = 0;	// Top of the current row
+		int row_left = 0;	// Blocks in the current row with coverage (multiples of block_size)
+		int row_right = 0;
+
+		static const int block_size = PathAreaScanner::block_size;
+
+	private:
+		void rasterize_bands(PathFillMode mode, int num_threads, int start_y, int end_y);
+
+		class RowResult
+		{
+		public:
+			int left = 0;
+			int right = 0;
+		};
+
+		int width = 0;
+		int height = 0;
+
+		std::vector<PathAreaEdge> edges;	// Sorted by y0 in begin()
+		std::vector<std::unique_ptr<PathAreaScanner>> scanners;	// One per thread
+
+		bool threaded = false;
+		std::vector<RowResult> row_results;	// Rows rasterized by rasterize_bands, one per block row
+		int first_result_y = 0;
+		size_t next_result = 0;
+		std::vector<unsigned char> coverage_image;
+		const unsigned char *row_coverage = nullptr;
+
+		static const int min_rows_per_thread = 4;	// Smaller paths are not worth waking up the threads for
+		static const int bands_per_thread = 4;	// Bands are claimed as threads finish, which evens out the load
+	};
+}
@@ -41,6 +41,9 @@
 
 using namespace uicore::PathConstants;
 
+static_assert(uicore::PathAreaRasterizer::block_size == uicore::PathConstants::mask_block_size, "Area rasterizer must produce blocks matching the mask texture");
+static_assert(uicore::PathMask::block_size == uicore::PathConstants::mask_block_size, "Cached masks must use blocks matching the mask texture");
+
 namespace uicore
 {
 	PathFillRenderer::PathFillRenderer(const GraphicContextPtr &gc, RenderBatchBuffer *batch_buffer) : batch_buffer(batch_buffer)
@@ -74,6 +77,16 @@ namespace uicore
 
 		first_scanline = scanlines.size();
 		last_scanline = 0;
+		num_vertices = 0;
+		num_edges = 0;
+
+		area_rasterizer.clear(width, height);
+	}
+
+	void PathFillRenderer::begin(float x, float y)
+	{
+		PathRenderer::begin(x, y);
+		num_vertices++;
 	}
 
 	void PathFillRenderer::end(bool close)
@@ -81,6 +94,7 @@ namespace uicore
 		if (close)
 		{
 			line(start_x, start_y);
+			num_vertices--;	// The closing edge ends on the first point
 		}
 	}
 
@@ -89,9 +103,18 @@ namespace uicore
 		float x0 = last_x;
 		float y0 = last_y;
 
+		num_vertices++;
+		num_edges++;
+
 		last_x = x1;
 		last_y = y1;
 
+		if (rasterizer == PathRasterizer::analytic)
+		{
+			area_rasterizer.line(x0, y0, x1, y1);
+			return;
+		}
+
 		x0 *= static_cast<float>(antialias_level);
 		x1 *= static_cast<float>(antialias_level);
 		y0 *= static_cast<float>(antialias_level);
@@ -123,23 +146,89 @@ namespace uicore
 		}
 	}
 
-	void PathFillRenderer::fill(const CanvasPtr &canvas, PathFillMode mode, const Brush &brush, const Mat4f &transform)
+	void PathFillRenderer::fill(const CanvasPtr &canvas, PathFillMode mode, const Brush &brush, const Mat4f &transform, PathMask *record_mask)
 	{
 		if (scanlines.empty()) return;
 
+		begin_fill(canvas, brush, transform);
+		batch_buffer->count_path_outline(num_vertices, num_edges);
+
+		if (rasterizer == PathRasterizer::analytic)
+			fill_analytic(canvas, mode, brush, transform, record_mask);
+		else
+			fill_supersampled(canvas, mode, brush, transform);
+	}
+
+	void PathFillRenderer::fill(const CanvasPtr &canvas, const PathMask &mask, const Brush &brush, const Mat4f &transform)
+	{
+		begin_fill(canvas, brush, transform);
+
+		for (const auto &block : mask.blocks)
+		{
+			if (vertices.is_full() || mask_blocks.is_full())
+				next_batch(canvas, brush, transform);
+
+			if (block.offset < 0)
+				mask_blocks.fill_full_block();
+			else
+				mask_blocks.store_block(mask.coverage.data() + block.offset, mask_block_size);
+
+			vertices.push(block.x, block.y, current_instance_offset, mask_blocks.block_index);
+		}
+	}
+
+	void PathFillRenderer::begin_fill(const CanvasPtr &canvas, const Brush &brush, const Mat4f &transform)
+	{
 		initialise_buffers(canvas);
 		current_instance_offset = instances.push(canvas, brush, transform);
 		if (!current_instance_offset)
+			next_batch(canvas, brush, transform);
+	}
+
+	void PathFillRenderer::next_batch(const CanvasPtr &canvas, const Brush &brush, const Mat4f &transform)
+	{
+		batch_buffer->flush_reason = BatchFlushReason::buffer_full;
+		flush(canvas->gc());
+		batch_buffer->flush_reason = BatchFlushReason::explicit_flush;
+
+		initialise_buffers(canvas);
+		current_instance_offset = instances.push(canvas, brush, transform);
+	}
+
+	void PathFillRenderer::fill_analytic(const CanvasPtr &canvas, PathFillMode mode, const Brush &brush, const Mat4f &transform, PathMask *record_mask)
+	{
+		int max_width = canvas->gc()->width();
+
+		int num_threads = rasterizer_threads > 0 ? rasterizer_threads : System::num_cores();
+		int num_blocks = 0;
+		area_rasterizer.begin(mode, num_threads);
+		while (area_rasterizer.next_row())
 		{
-			flush(canvas->gc());
-			initialise_buffers(canvas);
-			current_instance_offset = instances.push(canvas, brush, transform);
+			int right = min(area_rasterizer.row_right, max_width);
+			for (int xpos = area_rasterizer.row_left; xpos < right; xpos += mask_block_size)
+			{
+				if (vertices.is_full() || mask_blocks.is_full())
+					next_batch(canvas, brush, transform);
+
+				if (mask_blocks.store_block(area_rasterizer.coverage(xpos), area_rasterizer.coverage_pitch()))
+				{
+					vertices.push(xpos, area_rasterizer.row_y, current_instance_offset, mask_blocks.block_index);
+					num_blocks++;
+					if (record_mask)
+						record_mask->add_block(xpos, area_rasterizer.row_y, area_rasterizer.coverage(xpos), area_rasterizer.coverage_pitch());
+				}
+			}
 		}
+		batch_buffer->count_mask_blocks(num_blocks);
+	}
 
+	void PathFillRenderer::fill_supersampled(const CanvasPtr &canvas, PathFillMode mode, const Brush &brush, const Mat4f &transform)
+	{
 		int max_width = canvas->gc()->width() * antialias_level;
 
 		int start_y = first_scanline / scanline_block_size * scanline_block_size;
 		int end_y = (last_scanline + scanline_block_size - 1) / scanline_block_size * scanline_block_size;
+		int num_blocks = 0;
 
 		for (size_t y = start_y; y < end_y; y += scanline_block_size)
 		{
@@ -149,18 +238,16 @@ namespace uicore
 			for (int xpos = extent.left; xpos < extent.right; xpos += scanline_block_size)
 			{
 				if (vertices.is_full() || mask_blocks.is_full())
-				{
-					flush(canvas->gc());
-					initialise_buffers(canvas);
-					current_instance_offset = instances.push(canvas, brush, transform);
-				}
+					next_batch(canvas, brush, transform);
 
 				if (mask_blocks.fill_block(xpos))
 				{
 					vertices.push(xpos / antialias_level, y / antialias_level, current_instance_offset, mask_blocks.block_index);
+					num_blocks++;
 				}
 			}
 		}
+		batch_buffer->count_mask_blocks(num_blocks);
 	}
 
 	PathFillRenderer::Extent PathFillRenderer::find_extent(const PathScanline *scanline, int max_width)
@@ -205,6 +292,7 @@ namespace uicore
 		}
 
 		gpu_vertices.upload_data(gc, 0, (Vec4ui*)vertices.get_vertices(), vertices.get_position());
+		batch_buffer->count_draw_call(vertices.get_position(), vertices.get_position() * sizeof(Vec4ui));
 
 		int block_y = (((mask_blocks.next_block-1) * mask_block_size) / mask_texture_size)* mask_block_size;
 		mask_texture->set_subimage(gc, 0, 0, mask_buffer, Rect(Point(0, 0), Size(mask_texture_size, block_y + mask_block_size)));
@@ -477,6 +565,38 @@ namespace uicore
 		block_index = filled_block_index;
 	}
 
+	bool PathMaskBuffer::store_block(const unsigned char *coverage, int pitch)
+	{
+		__m128i lines[mask_block_size];
+		__m128i any_set = _mm_setzero_si128();
+		__m128i all_set = _mm_set1_epi32(-1);
+		for (unsigned int cnt = 0; cnt < mask_block_size; cnt++)
+		{
+			lines[cnt] = _mm_loadu_si128((const __m128i*)(coverage + pitch * cnt));
+			any_set = _mm_or_si128(any_set, lines[cnt]);
+			all_set = _mm_and_si128(all_set, lines[cnt]);
+		}
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(any_set, _mm_setzero_si128())) == 0xffff)
+			return false;
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(all_set, _mm_set1_epi32(-1))) == 0xffff)
+		{
+			fill_full_block();
+			return true;
+		}
+
+		int block_x = (next_block * mask_block_size) % mask_texture_size;
+		for (unsigned int cnt = 0; cnt < mask_block_size; cnt++)
+			_mm_store_si128((__m128i*)(mask_row_block_data + cnt * mask_texture_size + block_x), lines[cnt]);
+
+		if (((next_block + 1) % (mask_texture_size / mask_block_size) == 0))
+			flush_block();
+
+		block_index = next_block++;
+		return true;
+	}
+
 #else
 	bool PathMaskBuffer::fill_block(int xpos)
 	{
@@ -552,6 +672,42 @@ namespace uicore
 
 		block_index = filled_block_index;
 	}
+
+	bool PathMaskBuffer::store_block(const unsigned char *coverage, int pitch)
+	{
+		bool empty_block = true;
+		bool full_block = true;
+		for (unsigned int cnt = 0; cnt < mask_block_size; cnt++)
+		{
+			for (unsigned int i = 0; i < mask_block_size; i++)
+			{
+				unsigned char value = coverage[pitch * cnt + i];
+				empty_block = empty_block && value == 0;
+				full_block = full_block && value == 255;
+			}
+		}
+
+		if (empty_block)
+			return false;
+
+		if (full_block)
+		{
+			fill_full_block();
+			return true;
+		}
+
+		int block_x = (next_block * mask_block_size) % mask_texture_size;
+		int block_y = ((next_block * mask_block_size) / mask_texture_size)* mask_block_size;
+
+		for (unsigned int cnt = 0; cnt < mask_block_size; cnt++)
+		{
+			unsigned char *line = mask_buffer_data + mask_buffer_pitch * (block_y + cnt) + block_x;
+			memcpy(line, coverage + pitch * cnt, mask_block_size);
+		}
+
+		block_index = next_block++;
+		return true;
+	}
 #endif
 
 	bool PathMaskBuffer::is_full_block(int xpos) const
@@ -42,6 +42,8 @@
 #include "UICore/Display/Render/program_object.h"
 #include "render_batch_buffer.h"
 #include "path_renderer.h"
+#include "path_area_rasterizer.h"
+#include "path_mask_cache.h"
 
 namespace uicore
 {
@@ -175,12 +177,19 @@ namespace uicore
 		void begin_row(PathScanline *scanlines, PathFillMode mode);
 		bool fill_block(int xpos);
 
+		/// \brief Stores a block of coverage values, with pitch bytes between each line
+		///
+		/// \return False if the block is empty
+		bool store_block(const unsigned char *coverage, int pitch);
+
+		/// \brief Stores a fully covered block
+		void fill_full_block();
+
 		int block_index = 0;
 		int next_block = 0;
 
 	private:
 		bool is_full_block(int xpos) const;
-		void fill_full_block();
 
 		PathRasterRange range[PathConstants::scanline_block_size];
 
@@ -200,13 +209,22 @@ namespace uicore
 
 		void clear(int width, int height);
 
+		void begin(float x, float y) override;
 		void line(float x, float y) override;
 		void end(bool close) override;
 
-		void fill(const CanvasPtr &canvas, PathFillMode mode, const Brush &brush, const Mat4f &transform);
+		/// \brief Fills the path built since clear()
+		///
+		/// \param record_mask If not null, the mask blocks are also added to this mask. Only done by the analytic rasterizer
+		void fill(const CanvasPtr &canvas, PathFillMode mode, const Brush &brush, const Mat4f &transform, PathMask *record_mask = nullptr);
+
+		/// \brief Fills using the blocks of a previously recorded mask
+		void fill(const CanvasPtr &canvas, const PathMask &mask, const Brush &brush, const Mat4f &transform);
 		void flush(const GraphicContextPtr &gc);
 
 		void set_yaxis(TextureImageYAxis yaxis) { image_yaxis = yaxis; }
+		void set_rasterizer(PathRasterizer new_rasterizer) { rasterizer = new_rasterizer; }
+		void set_rasterizer_threads(int num_threads) { rasterizer_threads = num_threads; }
 
 		const float rcp_mask_texture_size = 1.0f / (float)PathConstants::mask_texture_size;
 
@@ -215,6 +233,11 @@ namespace uicore
 
 		void initialise_buffers(const CanvasPtr &canvas);
 
+		void begin_fill(const CanvasPtr &canvas, const Brush &brush, const Mat4f &transform);
+		void next_batch(const CanvasPtr &canvas, const Brush &brush, const Mat4f &transform);
+		void fill_supersampled(const CanvasPtr &canvas, PathFillMode mode, const Brush &brush, const Mat4f &transform);
+		void fill_analytic(const CanvasPtr &canvas, PathFillMode mode, const Brush &brush, const Mat4f &transform, PathMask *record_mask);
+
 		TextureImageYAxis image_yaxis = y_axis_top_down;
 
 		struct Extent
@@ -229,10 +252,17 @@ namespace uicore
 		int first_scanline = 0;
 		int last_scanline = 0;
 
+		int num_vertices = 0;	// Outline added since clear(), for the canvas stats
+		int num_edges = 0;
+
 		int width = 0;
 		int height = 0;
 		std::vector<PathScanline> scanlines;
 
+		PathRasterizer rasterizer = PathRasterizer::analytic;
+		int rasterizer_threads = 1;	// 0 = one per core
+		PathAreaRasterizer area_rasterizer;
+
 		class Block
 		{
 		public:
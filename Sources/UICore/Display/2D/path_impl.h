@@ -27,6 +27,8 @@
 **    Mark Page
 */
 
+#pragma once
+
 #include "UICore/Display/2D/path.h"
 #include <vector>
 
@@ -80,7 +82,19 @@ namespace uicore
 
 		std::shared_ptr<Path> clone() const override;
 
+		/// \brief Hash of the subpaths, used to find cached masks of this path
+		uint64_t geometry_hash() const;
+
 		PathFillMode _fill_mode = PathFillMode::alternate;
 		std::vector<PathSubpath> _subpaths;
+
+	private:
+		void geometry_changed() { _geometry_hash_valid = false; }
+
+		/// \brief Returns true if the path is an axis aligned rectangle that covers whole pixels on the canvas
+		bool pixel_aligned_rect(const CanvasPtr &canvas, Rectf &out_box) const;
+
+		mutable uint64_t _geometry_hash = 0;
+		mutable bool _geometry_hash_valid = false;
 	};
 }
@@ -0,0 +1,222 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "path_mask_cache.h"
+#include <functional>
+
+namespace uicore
+{
+	PathMaskKey::PathMaskKey(uint64_t geometry_hash, const PathImpl &path, const Pen *stroke_pen, PathFillMode mode, const Mat4f &matrix, int width, int height) : geometry_hash(geometry_hash), mode(mode), width(width), height(height), subpaths(&path._subpaths)
+	{
+		if (stroke_pen)
+		{
+			stroked = true;
+			pen = *stroke_pen;
+			pen.color = Colorf();
+		}
+
+		transform[0] = matrix.matrix[0 * 4 + 0];
+		transform[1] = matrix.matrix[0 * 4 + 1];
+		transform[2] = matrix.matrix[1 * 4 + 0];
+		transform[3] = matrix.matrix[1 * 4 + 1];
+		transform[4] = matrix.matrix[3 * 4 + 0];
+		transform[5] = matrix.matrix[3 * 4 + 1];
+	}
+
+	void PathMaskKey::store_geometry()
+	{
+		if (subpaths)
+		{
+			stored_subpaths = *subpaths;
+			subpaths = nullptr;
+		}
+	}
+
+	size_t PathMaskKey::bytes() const
+	{
+		size_t size = pen.dashes.size() * sizeof(float);
+		for (const auto &subpath : geometry())
+			size += sizeof(PathSubpath) + subpath.points.size() * sizeof(Pointf) + subpath.commands.size() * sizeof(PathCommand);
+		return size;
+	}
+
+	bool PathMaskKey::operator==(const PathMaskKey &other) const
+	{
+		if (geometry_hash != other.geometry_hash || mode != other.mode || width != other.width || height != other.height)
+			return false;
+
+		for (int i = 0; i < 6; i++)
+		{
+			if (transform[i] != other.transform[i])
+				return false;
+		}
+
+		if (stroked != other.stroked)
+			return false;
+
+		if (stroked)
+		{
+			if (pen.width != other.pen.width || pen.join != other.pen.join || pen.cap != other.pen.cap || pen.miter_limit != other.pen.miter_limit ||
+				pen.dash_offset != other.pen.dash_offset || pen.dashes != other.pen.dashes)
+				return false;
+		}
+
+		// The hash only makes a match likely. The geometry decides
+		const std::vector<PathSubpath> &a = geometry();
+		const std::vector<PathSubpath> &b = other.geometry();
+		if (&a == &b)
+			return true;
+		if (a.size() != b.size())
+			return false;
+
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			if (a[i].closed != b[i].closed || a[i].points.size() != b[i].points.size() || a[i].commands != b[i].commands)
+				return false;
+
+			if (!a[i].points.empty() && memcmp(a[i].points.data(), b[i].points.data(), a[i].points.size() * sizeof(Pointf)) != 0)
+				return false;
+		}
+		return true;
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	void PathMask::add_block(int x, int y, const unsigned char *block_coverage, int pitch)
+	{
+		bool full_block = true;
+		for (int line = 0; line < block_size && full_block; line++)
+		{
+			for (int i = 0; i < block_size; i++)
+			{
+				if (block_coverage[pitch * line + i] != 255)
+				{
+					full_block = false;
+					break;
+				}
+			}
+		}
+
+		if (full_block)
+		{
+			blocks.push_back(Block(x, y, -1));
+			return;
+		}
+
+		int offset = static_cast<int>(coverage.size());
+		coverage.resize(coverage.size() + block_size * block_size);
+		for (int line = 0; line < block_size; line++)
+			memcpy(coverage.data() + offset + block_size * line, block_coverage + pitch * line, block_size);
+
+		blocks.push_back(Block(x, y, offset));
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	PathMaskPtr PathMaskCache::find(const PathMaskKey &key)
+	{
+		auto it = entry_map.find(hash(key));
+		if (it != entry_map.end() && it->second->key == key)
+		{
+			EntryList::iterator entry = it->second;
+			if (entry != entries.begin())
+				entries.splice(entries.begin(), entries, entry);
+			hits++;
+			return entry->mask;
+		}
+
+		misses++;
+		return PathMaskPtr();
+	}
+
+	void PathMaskCache::insert(const PathMaskKey &key, const PathMaskPtr &mask)
+	{
+		// A mask that takes up a large part of the budget would only push out many smaller ones
+		size_t mask_bytes = mask->bytes() + key.bytes();
+		if (mask_bytes > max_bytes / 4)
+			return;
+
+		size_t key_hash = hash(key);
+		auto it = entry_map.find(key_hash);
+		if (it != entry_map.end())
+		{
+			// Hash collision or a mask that is being replaced
+			bytes -= it->second->bytes();
+			entries.erase(it->second);
+			entry_map.erase(it);
+		}
+
+		evict(mask_bytes);
+
+		entries.push_front(Entry(key, mask));
+		entries.front().key.store_geometry();
+		entry_map[key_hash] = entries.begin();
+		bytes += mask_bytes;
+	}
+
+	void PathMaskCache::evict(size_t new_bytes)
+	{
+		while (!entries.empty() && bytes + new_bytes > max_bytes)
+		{
+			const Entry &oldest = entries.back();
+			bytes -= oldest.bytes();
+			entry_map.erase(hash(oldest.key));
+			entries.pop_back();
+			evictions++;
+		}
+	}
+
+	void PathMaskCache::set_budget(size_t new_max_bytes)
+	{
+		max_bytes = new_max_bytes;
+		evict(0);
+	}
+
+	PathCacheStats PathMaskCache::stats() const
+	{
+		PathCacheStats stats;
+		stats.hits = hits;
+		stats.misses = misses;
+		stats.evictions = evictions;
+		stats.paths = static_cast<int>(entries.size());
+		stats.bytes = bytes;
+		return stats;
+	}
+
+	size_t PathMaskCache::hash(const PathMaskKey &key)
+	{
+		size_t seed = std::hash<uint64_t>()(key.geometry_hash);
+		seed ^= std::hash<int>()(static_cast<int>(key.mode)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		seed ^= std::hash<int>()(key.width) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		seed ^= std::hash<int>()(key.height) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		for (float value : key.transform)
+			seed ^= std::hash<float>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		return seed;
+	}
+}
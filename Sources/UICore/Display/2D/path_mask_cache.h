@@ -0,0 +1,143 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Display/2D/path.h"
+#include "UICore/Display/2D/pen.h"
+#include "UICore/Core/Math/mat4.h"
+#include "path_impl.h"
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace uicore
+{
+	/// \brief Identifies the mask of a path filled or stroked with a specific transform
+	///
+	/// Keys with the same hash are only equal if their geometry and pen match too, so a hash collision never reuses the mask of another path.
+	class PathMaskKey
+	{
+	public:
+		PathMaskKey() { }
+		PathMaskKey(uint64_t geometry_hash, const PathImpl &path, const Pen *pen, PathFillMode mode, const Mat4f &transform, int width, int height);
+
+		uint64_t geometry_hash = 0;	// Hash of the geometry and the pen
+		PathFillMode mode = PathFillMode::alternate;
+		float transform[6] = { 0.0f };	// 2D part of the transform: scale, shear and translation
+		int width = 0;	// Mask size the path was clipped to
+		int height = 0;
+
+		bool stroked = false;
+		Pen pen;	// Stroke shape. The color is not part of the mask
+
+		/// \brief Subpaths of the path, either of the path being looked up or the copy stored in the cache
+		const std::vector<PathSubpath> &geometry() const { return subpaths ? *subpaths : stored_subpaths; }
+
+		/// \brief Copies the geometry into the key, so the key stays valid after the path changes
+		void store_geometry();
+
+		/// \brief Memory used by the stored geometry
+		size_t bytes() const;
+
+		bool operator==(const PathMaskKey &other) const;
+
+	private:
+		const std::vector<PathSubpath> *subpaths = nullptr;	// Not owned, only valid while the path is drawn
+		std::vector<PathSubpath> stored_subpaths;
+	};
+
+	/// \brief Mask blocks computed for a filled path
+	class PathMask
+	{
+	public:
+		class Block
+		{
+		public:
+			Block(int x, int y, int offset) : x(x), y(y), offset(offset) { }
+
+			int x, y;	// Output position in pixels
+			int offset;	// Offset of the block in coverage, or -1 if fully covered
+		};
+
+		/// \brief Adds a block of block_size x block_size coverage values, with pitch bytes between each line
+		void add_block(int x, int y, const unsigned char *block_coverage, int pitch);
+
+		size_t bytes() const { return blocks.size() * sizeof(Block) + coverage.size(); }
+
+		std::vector<Block> blocks;
+		std::vector<unsigned char> coverage;
+
+		static const int block_size = 16;
+	};
+
+	typedef std::shared_ptr<PathMask> PathMaskPtr;
+
+	/// \brief Bounded cache of path masks, so unchanged paths are not rasterized again
+	class PathMaskCache
+	{
+	public:
+		/// \brief Returns the cached mask, or null if the path has to be rasterized
+		PathMaskPtr find(const PathMaskKey &key);
+
+		/// \brief Adds a mask, evicting the least recently used masks to stay within the budget
+		void insert(const PathMaskKey &key, const PathMaskPtr &mask);
+
+		/// \brief Sets the memory the cached masks may use, in bytes. 0 disables the cache
+		void set_budget(size_t bytes);
+		size_t budget() const { return max_bytes; }
+
+		PathCacheStats stats() const;
+
+	private:
+		static size_t hash(const PathMaskKey &key);
+		void evict(size_t new_bytes);
+
+		class Entry
+		{
+		public:
+			Entry(const PathMaskKey &key, const PathMaskPtr &mask) : key(key), mask(mask) { }
+
+			size_t bytes() const { return mask->bytes() + key.bytes(); }
+
+			PathMaskKey key;
+			PathMaskPtr mask;
+		};
+
+		typedef std::list<Entry> EntryList;
+		EntryList entries;	// Most recently used first
+		std::unordered_map<size_t, EntryList::iterator> entry_map;
+
+		size_t max_bytes = 16 * 1024 * 1024;
+		size_t bytes = 0;
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+	};
+}
@@ -0,0 +1,123 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+**    Mark Page
+*/
+
+#include "UICore/precomp.h"
+#include "path_raster_threads.h"
+
+namespace uicore
+{
+	PathRasterThreads &PathRasterThreads::instance()
+	{
+		static PathRasterThreads threads;
+		return threads;
+	}
+
+	PathRasterThreads::PathRasterThreads() : next_task(0)
+	{
+	}
+
+	PathRasterThreads::~PathRasterThreads()
+	{
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			stop_flag = true;
+		}
+		worker_event.notify_all();
+		for (auto &thread : threads)
+			thread.join();
+	}
+
+	void PathRasterThreads::run(int num_threads, int num_tasks, const std::function<void(int task_index, int thread_index)> &task)
+	{
+		std::unique_lock<std::mutex> run_lock(run_mutex);
+
+		num_threads = std::max(std::min(num_threads, num_tasks), 1);
+
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+
+			// Workers are created on first use and then kept around
+			while (static_cast<int>(threads.size()) < num_threads - 1)
+				threads.push_back(std::thread(&PathRasterThreads::worker_main, this, static_cast<int>(threads.size()) + 1));
+
+			current_task = &task;
+			current_num_tasks = num_tasks;
+			current_num_threads = num_threads;
+			busy_workers = num_threads - 1;
+			next_task.store(0);
+			generation++;
+		}
+		worker_event.notify_all();
+
+		run_tasks(0);
+
+		std::unique_lock<std::mutex> mutex_lock(mutex);
+		done_event.wait(mutex_lock, [&]() -> bool { return busy_workers == 0; });
+		current_task = nullptr;
+	}
+
+	void PathRasterThreads::worker_main(int thread_index)
+	{
+		unsigned int last_generation = 0;
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			last_generation = generation - 1;	// The run that created this thread is still waiting for it
+		}
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> mutex_lock(mutex);
+				worker_event.wait(mutex_lock, [&]() -> bool { return stop_flag || (generation != last_generation && thread_index < current_num_threads); });
+				if (stop_flag)
+					break;
+				last_generation = generation;
+			}
+
+			run_tasks(thread_index);
+
+			{
+				std::unique_lock<std::mutex> mutex_lock(mutex);
+				busy_workers--;
+			}
+			done_event.notify_one();
+		}
+	}
+
+	void PathRasterThreads::run_tasks(int thread_index)
+	{
+		while (true)
+		{
+			int task_index = next_task.fetch_add(1);
+			if (task_index >= current_num_tasks)
+				break;
+			(*current_task)(task_index, thread_index);
+		}
+	}
+}
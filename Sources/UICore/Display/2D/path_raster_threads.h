@@ -0,0 +1,74 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+**    Mark Page
+*/
+
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <vector>
+
+namespace uicore
+{
+	/// \brief Worker threads rasterizing path masks, and the tiles of the software target, in parallel
+	class PathRasterThreads
+	{
+	public:
+		static PathRasterThreads &instance();
+
+		/// \brief Runs task(task_index, thread_index) for every task and waits for all of them to finish
+		///
+		/// Tasks are claimed one at a time by whichever thread is idle. The calling thread takes part
+		/// as thread index 0, so at most num_threads threads run the tasks.
+		void run(int num_threads, int num_tasks, const std::function<void(int task_index, int thread_index)> &task);
+
+	private:
+		PathRasterThreads();
+		~PathRasterThreads();
+		void worker_main(int thread_index);
+		void run_tasks(int thread_index);
+
+		std::mutex run_mutex;	// Only one run at a time can use the workers
+
+		std::mutex mutex;
+		std::condition_variable worker_event;
+		std::condition_variable done_event;
+		std::vector<std::thread> threads;
+		bool stop_flag = false;
+
+		const std::function<void(int, int)> *current_task = nullptr;
+		int current_num_tasks = 0;
+		int current_num_threads = 0;
+		unsigned int generation = 0;	// Incremented for each run
+		int busy_workers = 0;
+		std::atomic<int> next_task;
+	};
+}
@@ -60,73 +60,41 @@ namespace uicore
 
 	void PathRenderer::cubic_bezier(float cp1_x, float cp1_y, float cp2_x, float cp2_y, float cp3_x, float cp3_y)
 	{
-		float cp0_x = last_x;
-		float cp0_y = last_y;
-
-		float estimated_length =
-			std::sqrt((cp1_x - cp0_x) * (cp1_x - cp0_x) + (cp1_y - cp0_y) * (cp1_y - cp0_y)) +
-			std::sqrt((cp1_x - cp0_x) * (cp1_x - cp0_x) + (cp1_y - cp0_y) * (cp1_y - cp0_y)) +
-			std::sqrt((cp1_x - cp0_x) * (cp1_x - cp0_x) + (cp1_y - cp0_y) * (cp1_y - cp0_y));
-
-		float min_segs = 10.0f;
-		float segs = estimated_length / 5.0f;
-		int steps = (int)std::ceil(std::sqrt(segs * segs * 0.3f + min_segs));
-		for (int i = 0; i < steps; i++)
-		{
-			//uicore::Pointf sp = point_on_bezier(cp0_x, cp0_y, cp1_x, cp1_y, cp2_x, cp2_y, cp3_x, cp3_y, i / (float)steps);
-			uicore::Pointf ep = point_on_bezier(cp0_x, cp0_y, cp1_x, cp1_y, cp2_x, cp2_y, cp3_x, cp3_y, (i + 1) / (float)steps);
-			line(ep.x, ep.y);
-		}
-
-		// http://ciechanowski.me/blog/2014/02/18/drawing-bezier-curves/
-		// http://antigrain.com/research/adaptive_bezier/  (best method, unfortunately GPL example code)
-	}
-
-	void PathRenderer::subdivide_bezier(int level, float cp0_x, float cp0_y, float cp1_x, float cp1_y, float cp2_x, float cp2_y, float cp3_x, float cp3_y, float t0, float t1)
-	{
-		const float split_angle_cos = 0.99f;
-
-		float tc = (t0 + t1) * 0.5f;
-
-		uicore::Pointf sp = point_on_bezier(cp0_x, cp0_y, cp1_x, cp1_y, cp2_x, cp2_y, cp3_x, cp3_y, t0);
-		uicore::Pointf cp = point_on_bezier(cp0_x, cp0_y, cp1_x, cp1_y, cp2_x, cp2_y, cp3_x, cp3_y, tc);
-		uicore::Pointf ep = point_on_bezier(cp0_x, cp0_y, cp1_x, cp1_y, cp2_x, cp2_y, cp3_x, cp3_y, t1);
-
-		uicore::Vec2f sp2cp(cp.x - sp.x, cp.y - sp.y);
-		uicore::Vec2f cp2ep(ep.x - cp.x, ep.y - cp.y);
-
-		float dot = uicore::Vec2f::dot(sp2cp.normalize(), cp2ep.normalize());
-		if (dot < split_angle_cos && level < 15)
-		{
-			subdivide_bezier(level + 1, cp0_x, cp0_y, cp1_x, cp1_y, cp2_x, cp2_y, cp3_x, cp3_y, t0, tc);
-			subdivide_bezier(level + 1, cp0_x, cp0_y, cp1_x, cp1_y, cp2_x, cp2_y, cp3_x, cp3_y, tc, t1);
-		}
-		else
-		{
-			line(ep.x, ep.y);
-		}
+		// The control points are already in device space, so the flatness tolerance is in device pixels.
+		// A shape drawn small gets few segments while a zoomed one keeps subdividing until it is smooth.
+		subdivide_bezier(0, last_x, last_y, cp1_x, cp1_y, cp2_x, cp2_y, cp3_x, cp3_y);
 	}
 
-	uicore::Pointf PathRenderer::point_on_bezier(float cp0_x, float cp0_y, float cp1_x, float cp1_y, float cp2_x, float cp2_y, float cp3_x, float cp3_y, float t)
+	void PathRenderer::subdivide_bezier(int level, float cp0_x, float cp0_y, float cp1_x, float cp1_y, float cp2_x, float cp2_y, float cp3_x, float cp3_y)
 	{
-		const int num_cp = 4;
-
-		float cp_x[4] = { cp0_x, cp1_x, cp2_x, cp3_x };
-		float cp_y[4] = { cp0_y, cp1_y, cp2_y, cp3_y };
-
-		// Perform deCasteljau iterations:
-		// (linear interpolate between the control points)
-		float a = 1.0f - t;
-		float b = t;
-		for (int j = num_cp - 1; j > 0; j--)
+		// Upper bound of the distance between the curve and its chord (squared and scaled by 16)
+		float ux = 3.0f * cp1_x - 2.0f * cp0_x - cp3_x;
+		float uy = 3.0f * cp1_y - 2.0f * cp0_y - cp3_y;
+		float vx = 3.0f * cp2_x - cp0_x - 2.0f * cp3_x;
+		float vy = 3.0f * cp2_y - cp0_y - 2.0f * cp3_y;
+		float flatness = std::max(ux * ux, vx * vx) + std::max(uy * uy, vy * vy);
+
+		if (flatness <= 16.0f * flatness_tolerance * flatness_tolerance || level == max_subdivide_level)
 		{
-			for (int i = 0; i < j; i++)
-			{
-				cp_x[i] = a * cp_x[i] + b * cp_x[i + 1];
-				cp_y[i] = a * cp_y[i] + b * cp_y[i + 1];
-			}
+			line(cp3_x, cp3_y);
+			return;
 		}
 
-		return uicore::Pointf(cp_x[0], cp_y[0]);
+		// Split the curve in half (de Casteljau)
+		float cp01_x = (cp0_x + cp1_x) * 0.5f;
+		float cp01_y = (cp0_y + cp1_y) * 0.5f;
+		float cp12_x = (cp1_x + cp2_x) * 0.5f;
+		float cp12_y = (cp1_y + cp2_y) * 0.5f;
+		float cp23_x = (cp2_x + cp3_x) * 0.5f;
+		float cp23_y = (cp2_y + cp3_y) * 0.5f;
+		float cp012_x = (cp01_x + cp12_x) * 0.5f;
+		float cp012_y = (cp01_y + cp12_y) * 0.5f;
+		float cp123_x = (cp12_x + cp23_x) * 0.5f;
+		float cp123_y = (cp12_y + cp23_y) * 0.5f;
+		float cp0123_x = (cp012_x + cp123_x) * 0.5f;
+		float cp0123_y = (cp012_y + cp123_y) * 0.5f;
+
+		subdivide_bezier(level + 1, cp0_x, cp0_y, cp01_x, cp01_y, cp012_x, cp012_y, cp0123_x, cp0123_y);
+		subdivide_bezier(level + 1, cp0123_x, cp0123_y, cp123_x, cp123_y, cp23_x, cp23_y, cp3_x, cp3_y);
 	}
 }
@@ -52,8 +52,12 @@ namespace uicore
 		float last_x = 0.0f;
 		float last_y = 0.0f;
 
+		// Maximum distance, in device pixels, between a curve and the lines approximating it
+		float flatness_tolerance = 0.25f;
+
 	private:
-		void subdivide_bezier(int level, float cp0_x, float cp0_y, float cp1_x, float cp1_y, float cp2_x, float cp2_y, float cp3_x, float cp3_y, float t0, float t1);
-		static uicore::Pointf point_on_bezier(float cp0_x, float cp0_y, float cp1_x, float cp1_y, float cp2_x, float cp2_y, float cp3_x, float cp3_y, float t);
+		void subdivide_bezier(int level, float cp0_x, float cp0_y, float cp1_x, float cp1_y, float cp2_x, float cp2_y, float cp3_x, float cp3_y);
+
+		static const int max_subdivide_level = 10;
 	};
 }
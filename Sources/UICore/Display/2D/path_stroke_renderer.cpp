@@ -29,15 +29,69 @@
 
 #include "UICore/precomp.h"
 #include "path_stroke_renderer.h"
+#include <cmath>
 
 namespace uicore
 {
+	namespace
+	{
+		Pointf direction(const Pointf &from, const Pointf &to)
+		{
+			float dx = to.x - from.x;
+			float dy = to.y - from.y;
+			float length = std::sqrt(dx * dx + dy * dy);
+			return length > 0.0f ? Pointf(dx / length, dy / length) : Pointf(0.0f, 0.0f);
+		}
+
+		// Left hand side of the direction, scaled to the half stroke width
+		Pointf normal(const Pointf &dir, float half_width)
+		{
+			return Pointf(-dir.y * half_width, dir.x * half_width);
+		}
+	}
+
 	PathStrokeRenderer::PathStrokeRenderer(const GraphicContextPtr &gc)
 	{
 	}
 
-	void PathStrokeRenderer::set_pen(const CanvasPtr &canvas, const Pen &pen)
+	void PathStrokeRenderer::set_pen(const Pen &pen, float scale)
+	{
+		half_width = pen.width * scale * 0.5f;
+		join = pen.join;
+		cap = pen.cap;
+		miter_limit = pen.miter_limit;
+
+		dashes.clear();
+		float pattern_length = 0.0f;
+		for (float dash : pen.dashes)
+		{
+			dashes.push_back(std::max(dash, 0.0f) * scale);
+			pattern_length += dashes.back();
+		}
+
+		if (dashes.size() % 2 == 1)
+		{
+			std::vector<float> pattern = dashes;
+			dashes.insert(dashes.end(), pattern.begin(), pattern.end());
+		}
+
+		// A pattern without any length draws a solid line. So does one repeating within a pixel, where the dashes blur into one
+		if (!(pattern_length >= min_dash_pattern_length))
+			dashes.clear();
+
+		dash_offset = pen.dash_offset * scale;
+	}
+
+	void PathStrokeRenderer::clear()
+	{
+		polylines.clear();
+	}
+
+	void PathStrokeRenderer::begin(float x, float y)
 	{
+		PathRenderer::begin(x, y);
+		polylines.push_back(Polyline());
+		polylines.back().points.push_back(Pointf(x, y));
 	}
 
 	void PathStrokeRenderer::line(float x, float y)
@@ -45,10 +99,319 @@ namespace uicore
 		last_x = x;
 		last_y = y;
 
-		// https://www.mapbox.com/blog/drawing-antialiased-lines/
+		// Zero length segments have no direction to stroke along
+		const Pointf &prev = polylines.back().points.back();
+		if (prev.x != x || prev.y != y)
+			polylines.back().points.push_back(Pointf(x, y));
 	}
 
 	void PathStrokeRenderer::end(bool close)
 	{
+		Polyline &polyline = polylines.back();
+		polyline.closed = close;
+
+		// The closing segment is implied
+		if (close && polyline.points.size() > 2 && polyline.points.front().x == polyline.points.back().x && polyline.points.front().y == polyline.points.back().y)
+			polyline.points.pop_back();
+	}
+
+	void PathStrokeRenderer::stroke(PathRenderer *new_output)
+	{
+		output = new_output;
+		if (half_width > 0.0f)
+		{
+			for (const auto &polyline : polylines)
+			{
+				if (dashes.empty())
+					stroke_polyline(polyline.points.data(), polyline.points.size(), polyline.closed);
+				else
+					stroke_dashes(polyline);
+			}
+		}
+		output = nullptr;
+	}
+
+	uint64_t PathStrokeRenderer::hash(uint64_t geometry_hash, const Pen &pen)
+	{
+		// FNV-1a over the geometry hash and everything in the pen except its color
+		uint64_t hash = 14695981039346656037ULL;
+		auto add_bytes = [&](const void *data, size_t size)
+		{
+			const unsigned char *bytes = static_cast<const unsigned char *>(data);
+			for (size_t i = 0; i < size; i++)
+				hash = (hash ^ bytes[i]) * 1099511628211ULL;
+		};
+
+		int shape[2] = { static_cast<int>(pen.join), static_cast<int>(pen.cap) };
+		float sizes[3] = { pen.width, pen.miter_limit, pen.dash_offset };
+		add_bytes(&geometry_hash, sizeof(geometry_hash));
+		add_bytes(shape, sizeof(shape));
+		add_bytes(sizes, sizeof(sizes));
+		add_bytes(pen.dashes.data(), pen.dashes.size() * sizeof(float));
+		return hash;
+	}
+
+	void PathStrokeRenderer::stroke_dashes(const Polyline &polyline)
+	{
+		const std::vector<Pointf> &points = polyline.points;
+		size_t num_segments = polyline.closed ? points.size() : points.size() - 1;
+
+		// Find where in the pattern the line starts
+		float pattern_length = 0.0f;
+		for (float dash : dashes)
+			pattern_length += dash;
+
+		// A long line with short dashes would create more outline than the fill can handle in any reasonable time
+		float polyline_length = 0.0f;
+		for (size_t i = 0; i < num_segments; i++)
+		{
+			const Pointf &a = points[i];
+			const Pointf &b = points[(i + 1) % points.size()];
+			polyline_length += std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+		}
+
+		if (polyline_length / pattern_length * (dashes.size() / 2) > max_dashes)
+		{
+			stroke_polyline(points.data(), points.size(), polyline.closed);
+			return;
+		}
+
+		float offset = std::fmod(dash_offset, pattern_length);
+		if (offset < 0.0f)
+			offset += pattern_length;
+
+		// Zero length dashes still get their caps, so a dash ending exactly at the offset is kept
+		size_t dash_index = 0;
+		while (offset > dashes[dash_index])
+		{
+			offset -= dashes[dash_index];
+			dash_index = (dash_index + 1) % dashes.size();
+		}
+		float remaining = dashes[dash_index] - offset;
+		bool on = dash_index % 2 == 0;
+
+		dash_points.clear();
+		if (on)
+			dash_points.push_back(points[0]);
+
+		for (size_t i = 0; i < num_segments; i++)
+		{
+			const Pointf &a = points[i];
+			const Pointf &b = points[(i + 1) % points.size()];
+			float segment_length = std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+
+			float pos = 0.0f;
+			while (segment_length - pos > remaining)
+			{
+				pos += remaining;
+				float t = pos / segment_length;
+				Pointf split(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+
+				dash_points.push_back(split);
+				if (on)
+				{
+					stroke_polyline(dash_points.data(), dash_points.size(), false);
+					dash_points.clear();
+				}
+
+				on = !on;
+				dash_index = (dash_index + 1) % dashes.size();
+				remaining = dashes[dash_index];
+			}
+
+			remaining -= segment_length - pos;
+			if (on)
+				dash_points.push_back(b);
+		}
+
+		if (on && !dash_points.empty())
+			stroke_polyline(dash_points.data(), dash_points.size(), false);
+	}
+
+	void PathStrokeRenderer::stroke_polyline(const Pointf *points, size_t count, bool closed)
+	{
+		if (count == 0)
+			return;
+
+		// Dashes can start and end on the same point
+		while (count > 1 && points[count - 1].x == points[count - 2].x && points[count - 1].y == points[count - 2].y)
+			count--;
+
+		if (count == 1)
+		{
+			stroke_point(points[0]);
+		}
+		else if (closed)
+		{
+			first_point = true;
+			add_side(points, count, true, false);
+			output->end(true);
+
+			// Both sides of a polygon without area trace the same outline in opposite directions and would cancel out
+			if (!is_collinear(points, count))
+			{
+				first_point = true;
+				add_side(points, count, true, true);
+				output->end(true);
+			}
+		}
+		else
+		{
+			first_point = true;
+			add_side(points, count, false, false);
+			add_cap(points[count - 1], direction(points[count - 2], points[count - 1]));
+			add_side(points, count, false, true);
+			add_cap(points[0], direction(points[1], points[0]));
+			output->end(true);
+		}
+	}
+
+	bool PathStrokeRenderer::is_collinear(const Pointf *points, size_t count) const
+	{
+		size_t farthest = 0;
+		float farthest_distance = 0.0f;
+		for (size_t i = 1; i < count; i++)
+		{
+			float dx = points[i].x - points[0].x;
+			float dy = points[i].y - points[0].y;
+			float distance = dx * dx + dy * dy;
+			if (distance > farthest_distance)
+			{
+				farthest = i;
+				farthest_distance = distance;
+			}
+		}
+
+		Pointf dir = direction(points[0], points[farthest]);
+		for (size_t i = 1; i < count; i++)
+		{
+			float distance = (points[i].x - points[0].x) * dir.y - (points[i].y - points[0].y) * dir.x;
+			if (std::abs(distance) > collinear_tolerance)
+				return false;
+		}
+		return true;
+	}
+
+	void PathStrokeRenderer::stroke_point(const Pointf &point)
+	{
+		// A zero length line only shows its caps
+		first_point = true;
+		if (cap == PenCap::round)
+		{
+			add_arc(point, Pointf(half_width, 0.0f), 2.0f * PI);
+			output->end(true);
+		}
+		else if (cap == PenCap::square)
+		{
+			add_point(Pointf(point.x - half_width, point.y - half_width));
+			add_point(Pointf(point.x + half_width, point.y - half_width));
+			add_point(Pointf(point.x + half_width, point.y + half_width));
+			add_point(Pointf(point.x - half_width, point.y + half_width));
+			output->end(true);
+		}
+	}
+
+	void PathStrokeRenderer::add_side(const Pointf *points, size_t count, bool closed, bool reverse)
+	{
+		// Always the left side of the travel direction. Walking in reverse gives the right side
+		auto at = [&](size_t i) -> const Pointf & { return reverse ? points[count - 1 - i] : points[i]; };
+
+		if (closed)
+		{
+			for (size_t i = 0; i < count; i++)
+				add_join(at(i), direction(at((i + count - 1) % count), at(i)), direction(at(i), at((i + 1) % count)));
+		}
+		else
+		{
+			Pointf start_offset = normal(direction(at(0), at(1)), half_width);
+			add_point(Pointf(at(0).x + start_offset.x, at(0).y + start_offset.y));
+
+			for (size_t i = 1; i + 1 < count; i++)
+				add_join(at(i), direction(at(i - 1), at(i)), direction(at(i), at(i + 1)));
+
+			Pointf end_offset = normal(direction(at(count - 2), at(count - 1)), half_width);
+			add_point(Pointf(at(count - 1).x + end_offset.x, at(count - 1).y + end_offset.y));
+		}
+	}
+
+	void PathStrokeRenderer::add_join(const Pointf &point, const Pointf &dir0, const Pointf &dir1)
+	{
+		Pointf offset0 = normal(dir0, half_width);
+		Pointf offset1 = normal(dir1, half_width);
+		float cross = dir0.x * dir1.y - dir0.y * dir1.x;
+		float dot = dir0.x * dir1.x + dir0.y * dir1.y;
+
+		add_point(Pointf(point.x + offset0.x, point.y + offset0.y));
+
+		if (cross > 0.0f)
+		{
+			// Inner side of the turn. Going through the center point keeps the outline valid for the winding fill
+			add_point(point);
+		}
+		else if (dot < 0.9999f)
+		{
+			if (join == PenJoin::round)
+			{
+				// The outer side always turns clockwise, which matters for 180 degree turns where the sign of the angle is lost
+				float sweep = std::atan2(offset0.x * offset1.y - offset0.y * offset1.x, offset0.x * offset1.x + offset0.y * offset1.y);
+				add_arc(point, offset0, -std::abs(sweep));
+			}
+			else if (join == PenJoin::miter)
+			{
+				// The miter length relative to the stroke width is 1 / cos(half the angle between the normals)
+				float cos_half_angle = std::sqrt(std::max((1.0f + dot) * 0.5f, 0.0f));
+				if (cos_half_angle * miter_limit >= 1.0f)
+				{
+					Pointf miter_dir = direction(Pointf(), Pointf(offset0.x + offset1.x, offset0.y + offset1.y));
+					float miter_length = half_width / cos_half_angle;
+					add_point(Pointf(point.x + miter_dir.x * miter_length, point.y + miter_dir.y * miter_length));
+				}
+			}
+		}
+
+		add_point(Pointf(point.x + offset1.x, point.y + offset1.y));
+	}
+
+	void PathStrokeRenderer::add_cap(const Pointf &point, const Pointf &dir)
+	{
+		// The outline is at the left side of dir and continues at the right side
+		Pointf offset = normal(dir, half_width);
+		if (cap == PenCap::square)
+		{
+			add_point(Pointf(point.x + offset.x + dir.x * half_width, point.y + offset.y + dir.y * half_width));
+			add_point(Pointf(point.x - offset.x + dir.x * half_width, point.y - offset.y + dir.y * half_width));
+		}
+		else if (cap == PenCap::round)
+		{
+			add_arc(point, offset, -PI);
+		}
+	}
+
+	void PathStrokeRenderer::add_arc(const Pointf &center, const Pointf &from, float sweep)
+	{
+		// Largest angle step that keeps the chords within the flatness tolerance
+		float max_step = half_width > flatness_tolerance ? 2.0f * std::acos(1.0f - flatness_tolerance / half_width) : 0.5f * PI;
+		int steps = std::max(static_cast<int>(std::ceil(std::abs(sweep) / max_step)), 1);
+
+		for (int i = 0; i <= steps; i++)
+		{
+			float angle = sweep * i / steps;
+			float c = std::cos(angle);
+			float s = std::sin(angle);
+			add_point(Pointf(center.x + from.x * c - from.y * s, center.y + from.x * s + from.y * c));
+		}
+	}
+
+	void PathStrokeRenderer::add_point(const Pointf &point)
+	{
+		if (first_point)
+		{
+			output->begin(point.x, point.y);
+			first_point = false;
+		}
+		else
+		{
+			output->line(point.x, point.y);
+		}
 	}
 }
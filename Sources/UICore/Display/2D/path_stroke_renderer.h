@@ -37,13 +37,66 @@
 
 namespace uicore
 {
+	/// \brief Converts flattened subpaths into the outline of their stroke
+	///
+	/// The subpaths are collected as polylines. stroke() then walks each polyline, split into dashes,
+	/// and sends the left edge, the end cap, the right edge backwards and the start cap as one closed
+	/// outline. Closed polylines give an outer and an inner outline instead. The outlines must be
+	/// filled with PathFillMode::winding, which also merges the places where a stroke overlaps itself.
 	class PathStrokeRenderer : public PathRenderer
 	{
 	public:
 		PathStrokeRenderer(const GraphicContextPtr &gc);
 
-		void set_pen(const CanvasPtr &canvas, const Pen &pen);
+		/// \brief Sets the pen, with scale being the transform scale from pen units to device pixels
+		void set_pen(const Pen &pen, float scale);
+
+		/// \brief Removes all collected polylines
+		void clear();
+
+		void begin(float x, float y) override;
 		void line(float x, float y) override;
 		void end(bool close) override;
+
+		/// \brief Sends the outline of the collected polylines to the output renderer
+		void stroke(PathRenderer *output);
+
+		/// \brief Combines a path geometry hash with the pen properties that affect the outline
+		static uint64_t hash(uint64_t geometry_hash, const Pen &pen);
+
+	private:
+		class Polyline
+		{
+		public:
+			std::vector<Pointf> points;
+			bool closed = false;
+		};
+
+		void stroke_dashes(const Polyline &polyline);
+		void stroke_polyline(const Pointf *points, size_t count, bool closed);
+		void stroke_point(const Pointf &point);
+		bool is_collinear(const Pointf *points, size_t count) const;
+		void add_side(const Pointf *points, size_t count, bool closed, bool reverse);
+		void add_join(const Pointf &point, const Pointf &dir0, const Pointf &dir1);
+		void add_cap(const Pointf &point, const Pointf &dir);
+		void add_arc(const Pointf &center, const Pointf &from, float sweep);
+		void add_point(const Pointf &point);
+
+		std::vector<Polyline> polylines;
+
+		static constexpr float collinear_tolerance = 0.001f;	// In device pixels
+		static constexpr float min_dash_pattern_length = 1.0f;	// In device pixels. Shorter patterns draw a solid line
+		static constexpr float max_dashes = 65536.0f;	// Most dashes drawn along one polyline before it is drawn solid
+
+		float half_width = 0.5f;
+		PenJoin join = PenJoin::miter;
+		PenCap cap = PenCap::butt;
+		float miter_limit = 4.0f;
+		std::vector<float> dashes;	// In device pixels, even number of entries
+		float dash_offset = 0.0f;
+
+		PathRenderer *output = nullptr;
+		bool first_point = true;
+		std::vector<Pointf> dash_points;
 	};
 }
@@ -31,6 +31,7 @@
 #include "render_batch_buffer.h"
 #include "UICore/Display/Render/blend_state_description.h"
 #include "UICore/Display/2D/canvas.h"
+#include "UICore/Display/Render/graphic_context_impl.h"
 
 namespace uicore
 {
@@ -40,6 +41,8 @@ namespace uicore
 		{
 			elem = VertexArrayBuffer::create(gc, vertex_buffer_size, usage_stream_draw);
 		}
+
+		ring_buffer = static_cast<GraphicContextImpl*>(gc.get())->create_vertex_ring_buffer(ring_buffer_size);
 	}
 
 	VertexArrayBufferPtr RenderBatchBuffer::get_vertex_buffer(const GraphicContextPtr &gc, int &out_index)
@@ -53,6 +56,39 @@ namespace uicore
 		return vertex_buffers[out_index];
 	}
 
+	void *RenderBatchBuffer::begin_vertices(const GraphicContextPtr &gc, int vertex_size)
+	{
+		batch_vertex_size = vertex_size;
+		if (!ring_buffer)
+			return buffer;
+
+		// A batcher may start a batch and then be switched away from before writing anything
+		if (ring_offset != -1)
+			ring_buffer->end_write(gc, 0);
+
+		return ring_buffer->begin_write(gc, vertex_buffer_size, vertex_size, ring_offset);
+	}
+
+	VertexArrayBufferPtr RenderBatchBuffer::end_vertices(const GraphicContextPtr &gc, int num_vertices, int &out_first_vertex, int &out_index)
+	{
+		if (!ring_buffer)
+		{
+			VertexArrayBufferPtr gpu_buffer = get_vertex_buffer(gc, out_index);
+			gpu_buffer->upload_data(gc, 0, buffer, num_vertices * batch_vertex_size);
+			out_first_vertex = 0;
+			return gpu_buffer;
+		}
+
+		if (ring_offset == -1)
+			throw Exception("RenderBatchBuffer::end_vertices called without begin_vertices");
+
+		ring_buffer->end_write(gc, num_vertices * batch_vertex_size);
+		out_first_vertex = ring_offset / batch_vertex_size;
+		out_index = num_vertex_buffers;
+		ring_offset = -1;
+		return ring_buffer->buffer();
+	}
+
 	Texture2DPtr RenderBatchBuffer::get_texture_rgba32f(const GraphicContextPtr &gc)
 	{
 		current_rgba32f_texture++;
@@ -111,4 +147,21 @@ namespace uicore
 
 		return transfers_r8[current_r8_transfer];
 	}
+
+	void RenderBatchBuffer::add_draw_call(int num_vertices, uint64_t num_bytes)
+	{
+		stats.draw_calls++;
+		stats.vertices += num_vertices;
+		stats.vertex_bytes += num_bytes;
+
+		switch (flush_reason)
+		{
+		case BatchFlushReason::batcher_switch: stats.batcher_switch_flushes++; break;
+		case BatchFlushReason::texture_slots: stats.texture_slot_flushes++; break;
+		case BatchFlushReason::glyph_program: stats.glyph_program_flushes++; break;
+		case BatchFlushReason::clip_change: stats.clip_change_flushes++; break;
+		case BatchFlushReason::buffer_full: stats.buffer_full_flushes++; break;
+		case BatchFlushReason::explicit_flush: stats.explicit_flushes++; break;
+		}
+	}
 }
@@ -33,16 +33,42 @@
 #include "UICore/Display/Render/graphic_context.h"
 #include "UICore/Display/Render/texture_2d.h"
 #include "UICore/Display/Render/staging_texture.h"
+#include "UICore/Display/Render/vertex_ring_buffer.h"
 #include "UICore/Display/2D/render_batcher.h"
+#include "UICore/Display/2D/canvas.h"
+#include <cstdint>
 
 namespace uicore
 {
+	/// \brief Why the active batcher is being flushed, for the canvas statistics
+	enum class BatchFlushReason
+	{
+		batcher_switch,
+		texture_slots,
+		glyph_program,
+		clip_change,
+		buffer_full,
+		explicit_flush
+	};
+
 	class RenderBatchBuffer
 	{
 	public:
 		RenderBatchBuffer(const GraphicContextPtr &gc);
 
 		VertexArrayBufferPtr get_vertex_buffer(const GraphicContextPtr &gc, int &out_index);
+
+		/// \brief Returns where a batcher writes the vertices of its next batch, room for vertex_buffer_size bytes
+		///
+		/// With a vertex ring buffer this is GPU visible memory. Otherwise it is the CPU buffer, uploaded by end_vertices.
+		void *begin_vertices(const GraphicContextPtr &gc, int vertex_size);
+
+		/// \brief Ends the batch started by begin_vertices and returns the vertex buffer to draw it from
+		///
+		/// \param out_first_vertex Index of the first vertex of the batch in the returned buffer
+		/// \param out_index Identifies the returned buffer, for caching primitives arrays. Less than num_vertex_buffers + 1
+		VertexArrayBufferPtr end_vertices(const GraphicContextPtr &gc, int num_vertices, int &out_first_vertex, int &out_index);
+
 		Texture2DPtr get_texture_rgba32f(const GraphicContextPtr &gc);
 		Texture2DPtr get_texture_r8(const GraphicContextPtr &gc);
 		StagingTexturePtr get_transfer_rgba32f(const GraphicContextPtr &gc);
@@ -50,6 +76,7 @@ namespace uicore
 		StagingTexturePtr get_transfer_r8(const GraphicContextPtr &gc, int &out_index);
 		static const int num_vertex_buffers = 4;
 		enum { vertex_buffer_size = 1024 * 1024 };
+		enum { ring_buffer_size = 4 * vertex_buffer_size };
 		char buffer[vertex_buffer_size];
 
 		static const int rgba32f_width = 512;	// *** If changing this, remember to modify the path shaders ***
@@ -58,10 +85,31 @@ namespace uicore
 		static const int num_rgba32f_buffers = 2;
 		static const int num_r8_buffers = 2;
 
+		/// \brief Counts a draw call made by the batcher being flushed
+		void count_draw_call(int num_vertices, uint64_t num_bytes)
+		{
+			if (stats_enabled)
+				add_draw_call(num_vertices, num_bytes);
+		}
+
+		void count_mask_blocks(int num_blocks) { if (stats_enabled) stats.mask_blocks += num_blocks; }
+		void count_path_outline(int num_vertices, int num_edges) { if (stats_enabled) { stats.path_vertices += num_vertices; stats.path_edges += num_edges; } }
+		void count_glyph_cache_misses(int num_glyphs) { if (stats_enabled) stats.glyph_cache_misses += num_glyphs; }
+
+		bool stats_enabled = false;
+		CanvasStats stats;
+		BatchFlushReason flush_reason = BatchFlushReason::explicit_flush;	// Reason for the flush in progress
+
 	private:
+		void add_draw_call(int num_vertices, uint64_t num_bytes);
+
 		VertexArrayBufferPtr vertex_buffers[num_vertex_buffers];
 		int current_vertex_buffer = 0;
 
+		VertexRingBufferPtr ring_buffer;
+		int ring_offset = -1;	// Offset of the batch being written to the ring buffer, or -1
+		int batch_vertex_size = 0;
+
 		Texture2DPtr textures_rgba32f[num_rgba32f_buffers];
 		int current_rgba32f_texture = 0;
 
@@ -37,7 +37,6 @@ namespace uicore
 	RenderBatchLine::RenderBatchLine(const GraphicContextPtr &gc, RenderBatchBuffer *batch_buffer)
 		: batch_buffer(batch_buffer), position(0)
 	{
-		vertices = (LineVertex *)batch_buffer->buffer;
 	}
 
 	inline Vec4f RenderBatchLine::to_position(float x, float y) const
@@ -100,12 +99,15 @@ namespace uicore
 	void RenderBatchLine::set_batcher_active(const CanvasPtr &canvas, int num_vertices)
 	{
 		if (position + num_vertices > max_vertices)
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::buffer_full);
 
 		if (num_vertices > max_vertices)
 			throw Exception("Too many vertices for RenderBatchLine");
 
 		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this);
+
+		if (position == 0)
+			vertices = (LineVertex *)batch_buffer->begin_vertices(canvas->gc(), sizeof(LineVertex));
 	}
 
 	void RenderBatchLine::flush(const GraphicContextPtr &gc)
@@ -114,8 +116,8 @@ namespace uicore
 		{
 			gc->set_program_object(program_color_only);
 
-			int gpu_index;
-			VertexArrayVector<LineVertex> gpu_vertices(batch_buffer->get_vertex_buffer(gc, gpu_index));
+			int first_vertex, gpu_index;
+			VertexArrayVector<LineVertex> gpu_vertices(batch_buffer->end_vertices(gc, position, first_vertex, gpu_index));
 
 			if (!prim_array[gpu_index])
 			{
@@ -124,9 +126,11 @@ namespace uicore
 				prim_array[gpu_index]->set_attributes(1, gpu_vertices, cl_offsetof(LineVertex, color));
 			}
 
-			gpu_vertices.upload_data(gc, 0, vertices, position);
+			batch_buffer->count_draw_call(position, position * sizeof(LineVertex));
 
-			gc->draw_primitives(type_lines, position, prim_array[gpu_index]);
+			gc->set_primitives_array(prim_array[gpu_index]);
+			gc->draw_primitives_array(type_lines, first_vertex, position);
+			gc->reset_primitives_array();
 
 			gc->reset_program_object();
 
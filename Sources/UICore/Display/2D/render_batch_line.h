@@ -57,9 +57,9 @@ namespace uicore
 		void matrix_changed(const Mat4f &modelview, const Mat4f &projection, TextureImageYAxis image_yaxis, float pixel_ratio) override;
 
 		enum { max_vertices = RenderBatchBuffer::vertex_buffer_size / sizeof(LineVertex) };
-		LineVertex *vertices;
+		LineVertex *vertices = nullptr;
 		RenderBatchBuffer *batch_buffer;
-		PrimitivesArrayPtr prim_array[RenderBatchBuffer::num_vertex_buffers];
+		PrimitivesArrayPtr prim_array[RenderBatchBuffer::num_vertex_buffers + 1];
 		int position;
 		Mat4f modelview_projection_matrix;
 	};
@@ -37,7 +37,6 @@ namespace uicore
 	RenderBatchLineTexture::RenderBatchLineTexture(const GraphicContextPtr &gc, RenderBatchBuffer *batch_buffer)
 		: batch_buffer(batch_buffer)
 	{
-		vertices = (LineTextureVertex *)batch_buffer->buffer;
 	}
 
 	inline Vec4f RenderBatchLineTexture::to_position(float x, float y) const
@@ -76,7 +75,7 @@ namespace uicore
 	void RenderBatchLineTexture::set_batcher_active(const CanvasPtr &canvas, int num_vertices, const Texture2DPtr &texture)
 	{
 		if (position + num_vertices > max_vertices)
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::buffer_full);
 
 		if (num_vertices > max_vertices)
 			throw Exception("Too many vertices for RenderBatchLineTexture");
@@ -85,12 +84,15 @@ namespace uicore
 		if (current_texture)
 		{
 			if (current_texture != texture)
-				static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+				static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::texture_slots);
 		}
 
 		current_texture = texture;
 
 		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this);
+
+		if (position == 0)
+			vertices = (LineTextureVertex *)batch_buffer->begin_vertices(canvas->gc(), sizeof(LineTextureVertex));
 	}
 
 	void RenderBatchLineTexture::flush(const GraphicContextPtr &gc)
@@ -99,8 +101,8 @@ namespace uicore
 		{
 			gc->set_program_object(program_single_texture);
 
-			int gpu_index;
-			VertexArrayVector<LineTextureVertex> gpu_vertices(batch_buffer->get_vertex_buffer(gc, gpu_index));
+			int first_vertex, gpu_index;
+			VertexArrayVector<LineTextureVertex> gpu_vertices(batch_buffer->end_vertices(gc, position, first_vertex, gpu_index));
 
 			if (!prim_array[gpu_index])
 			{
@@ -111,11 +113,13 @@ namespace uicore
 			}
 
 
-			gpu_vertices.upload_data(gc, 0, vertices, position);
+			batch_buffer->count_draw_call(position, position * sizeof(LineTextureVertex));
 
 			gc->set_texture(0, current_texture);
 
-			gc->draw_primitives(type_lines, position, prim_array[gpu_index]);
+			gc->set_primitives_array(prim_array[gpu_index]);
+			gc->draw_primitives_array(type_lines, first_vertex, position);
+			gc->reset_primitives_array();
 
 			gc->reset_program_object();
 
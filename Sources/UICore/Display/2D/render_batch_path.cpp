@@ -51,19 +51,61 @@ namespace uicore
 
 	void RenderBatchPath::fill(const CanvasPtr &canvas, const PathImpl &path, const Brush &brush)
 	{
-		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this);
-
-		fill_renderer.clear(canvas->gc()->width(), canvas->gc()->height());
-		render(path, &fill_renderer);
-		fill_renderer.fill(canvas, path.fill_mode(), brush, modelview_matrix);
+		fill_edges(canvas, path, nullptr, path.fill_mode(), brush, [&]()
+		{
+			render(path, &fill_renderer);
+		});
 	}
 
 	void RenderBatchPath::stroke(const CanvasPtr &canvas, const PathImpl &path, const Pen &pen)
 	{
+		// The modelview matrix is only current while this is the active batcher
 		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this);
 
-		stroke_renderer.set_pen(canvas, pen);
-		render(path, &stroke_renderer);
+		// Pen sizes scale with the transform. A skewed or non-uniform scale uses the average scale
+		float scale = std::sqrt(std::abs(modelview_matrix.matrix[0 * 4 + 0] * modelview_matrix.matrix[1 * 4 + 1] - modelview_matrix.matrix[0 * 4 + 1] * modelview_matrix.matrix[1 * 4 + 0]));
+		stroke_renderer.set_pen(pen, scale);
+
+		fill_edges(canvas, path, &pen, PathFillMode::winding, Brush(pen.color), [&]()
+		{
+			stroke_renderer.clear();
+			render(path, &stroke_renderer);
+			stroke_renderer.stroke(&fill_renderer);
+		});
+	}
+
+	void RenderBatchPath::fill_edges(const CanvasPtr &canvas, const PathImpl &path, const Pen *pen, PathFillMode mode, const Brush &brush, const std::function<void()> &add_edges)
+	{
+		CanvasImpl *canvas_impl = static_cast<CanvasImpl*>(canvas.get());
+		canvas_impl->set_batcher(this);
+
+		fill_renderer.set_rasterizer(canvas_impl->path_rasterizer());
+		fill_renderer.set_rasterizer_threads(canvas_impl->path_rasterizer_threads());
+
+		PathMaskCache &cache = canvas_impl->path_mask_cache;
+		if (cache.budget() > 0 && canvas_impl->path_rasterizer() == PathRasterizer::analytic)
+		{
+			uint64_t geometry_hash = pen ? PathStrokeRenderer::hash(path.geometry_hash(), *pen) : path.geometry_hash();
+			PathMaskKey key(geometry_hash, path, pen, mode, modelview_matrix, canvas->gc()->width(), canvas->gc()->height());
+			PathMaskPtr mask = cache.find(key);
+			if (mask)
+			{
+				fill_renderer.fill(canvas, *mask, brush, modelview_matrix);
+			}
+			else
+			{
+				mask = std::make_shared<PathMask>();
+				fill_renderer.clear(canvas->gc()->width(), canvas->gc()->height());
+				add_edges();
+				fill_renderer.fill(canvas, mode, brush, modelview_matrix, mask.get());
+				cache.insert(key, mask);
+			}
+			return;
+		}
+
+		fill_renderer.clear(canvas->gc()->width(), canvas->gc()->height());
+		add_edges();
+		fill_renderer.fill(canvas, mode, brush, modelview_matrix);
 	}
 
 	void RenderBatchPath::flush(const GraphicContextPtr &gc)
@@ -82,6 +124,10 @@ namespace uicore
 	{
 		for (const auto &subpath : path._subpaths)
 		{
+			// close() leaves an empty subpath behind. A stroke would turn its lone point into a cap dot
+			if (subpath.commands.empty())
+				continue;
+
 			uicore::Pointf start_point = to_position(subpath.points[0]);
 			path_renderer->begin(start_point.x, start_point.y);
 
@@ -39,6 +39,7 @@
 #include "render_batch_buffer.h"
 #include "path_fill_renderer.h"
 #include "path_stroke_renderer.h"
+#include <functional>
 
 namespace uicore
 {
@@ -54,6 +55,7 @@ namespace uicore
 
 	private:
 		void render(const PathImpl &path, PathRenderer *renderer);
+		void fill_edges(const CanvasPtr &canvas, const PathImpl &path, const Pen *pen, PathFillMode mode, const Brush &brush, const std::function<void()> &add_edges);
 
 		int set_batcher_active(const CanvasPtr &canvas);
 		void flush(const GraphicContextPtr &gc) override;
@@ -37,7 +37,6 @@ namespace uicore
 	RenderBatchPoint::RenderBatchPoint(const GraphicContextPtr &gc, RenderBatchBuffer *batch_buffer)
 		: batch_buffer(batch_buffer)
 	{
-		vertices = (PointVertex *)batch_buffer->buffer;
 	}
 
 	void RenderBatchPoint::draw_point(const CanvasPtr &canvas, Vec2f *line_positions, const Vec4f &point_color, int num_vertices)
@@ -65,12 +64,15 @@ namespace uicore
 	void RenderBatchPoint::set_batcher_active(const CanvasPtr &canvas, int num_vertices)
 	{
 		if (position + num_vertices > max_vertices)
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::buffer_full);
 
 		if (num_vertices > max_vertices)
 			throw Exception("Too many vertices for RenderBatchPoint");
 
 		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this);
+
+		if (position == 0)
+			vertices = (PointVertex *)batch_buffer->begin_vertices(canvas->gc(), sizeof(PointVertex));
 	}
 
 	void RenderBatchPoint::flush(const GraphicContextPtr &gc)
@@ -79,8 +81,8 @@ namespace uicore
 		{
 			gc->set_program_object(program_color_only);
 
-			int gpu_index;
-			VertexArrayVector<PointVertex> gpu_vertices(batch_buffer->get_vertex_buffer(gc, gpu_index));
+			int first_vertex, gpu_index;
+			VertexArrayVector<PointVertex> gpu_vertices(batch_buffer->end_vertices(gc, position, first_vertex, gpu_index));
 
 			if (!prim_array[gpu_index])
 			{
@@ -89,9 +91,11 @@ namespace uicore
 				prim_array[gpu_index]->set_attributes(1, gpu_vertices, cl_offsetof(PointVertex, color));
 			}
 
-			gpu_vertices.upload_data(gc, 0, vertices, position);
+			batch_buffer->count_draw_call(position, position * sizeof(PointVertex));
 
-			gc->draw_primitives(type_points, position, prim_array[gpu_index]);
+			gc->set_primitives_array(prim_array[gpu_index]);
+			gc->draw_primitives_array(type_points, first_vertex, position);
+			gc->reset_primitives_array();
 
 			gc->reset_program_object();
 
@@ -56,9 +56,9 @@ namespace uicore
 		void matrix_changed(const Mat4f &modelview, const Mat4f &projection, TextureImageYAxis image_yaxis, float pixel_ratio) override;
 
 		enum { max_vertices = RenderBatchBuffer::vertex_buffer_size / sizeof(PointVertex) };
-		PointVertex *vertices;
+		PointVertex *vertices = nullptr;
 		RenderBatchBuffer *batch_buffer;
-		PrimitivesArrayPtr prim_array[RenderBatchBuffer::num_vertex_buffers];
+		PrimitivesArrayPtr prim_array[RenderBatchBuffer::num_vertex_buffers + 1];
 		int position = 0;
 		Mat4f modelview_projection_matrix;
 	};
@@ -31,6 +31,7 @@
 #include "render_batch_triangle.h"
 #include "canvas_impl.h"
 #include "UICore/Display/Render/blend_state_description.h"
+#include "UICore/Display/Render/graphic_context_impl.h"
 #include "UICore/Display/2D/canvas.h"
 #include "UICore/Core/Math/quad.h"
 
@@ -43,19 +44,18 @@ namespace uicore
 	RenderBatchTriangle::RenderBatchTriangle(const GraphicContextPtr &gc, RenderBatchBuffer *batch_buffer)
 		: batch_buffer(batch_buffer)
 	{
-		vertices = (SpriteVertex *)batch_buffer->buffer;
+		// The fixed function target cannot draw from an index buffer
+		quad_support = gc->shader_language() != shader_fixed_function;
 	}
 
 	void RenderBatchTriangle::draw_sprite(const CanvasPtr &canvas, const Pointf texture_position[4], const Pointf dest_position[4], const Texture2DPtr &texture, const Colorf &color)
 	{
-		int texindex = set_batcher_active(canvas, texture);
+		// Sprite corners are top left, top right, bottom left, bottom right. Quads go around the edge
+		Pointf quad_texture_position[4] = { texture_position[0], texture_position[1], texture_position[3], texture_position[2] };
+		Pointf quad_dest_position[4] = { dest_position[0], dest_position[1], dest_position[3], dest_position[2] };
 
-		to_sprite_vertex(texture_position[0], dest_position[0], vertices[position++], texindex, color);
-		to_sprite_vertex(texture_position[1], dest_position[1], vertices[position++], texindex, color);
-		to_sprite_vertex(texture_position[2], dest_position[2], vertices[position++], texindex, color);
-		to_sprite_vertex(texture_position[1], dest_position[1], vertices[position++], texindex, color);
-		to_sprite_vertex(texture_position[3], dest_position[3], vertices[position++], texindex, color);
-		to_sprite_vertex(texture_position[2], dest_position[2], vertices[position++], texindex, color);
+		int texindex = set_batcher_active(canvas, texture, false, StandardColorf::black(), fits_quad_vertex(quad_texture_position, color));
+		add_quad(quad_dest_position, quad_texture_position, color, texindex);
 	}
 
 	void RenderBatchTriangle::fill_triangle(const CanvasPtr &canvas, const Vec2f *triangle_positions, const Vec4f *triangle_colors, int num_vertices)
@@ -129,107 +129,174 @@ namespace uicore
 		v.texindex = texindex;
 	}
 
-	void RenderBatchTriangle::draw_image(const CanvasPtr &canvas, const Rectf &src, const Rectf &dest, const Colorf &color, const Texture2DPtr &texture)
+	void RenderBatchTriangle::draw_image(const CanvasPtr &canvas, const Rectf &src, const Rectf &image_dest, const Colorf &color, const Texture2DPtr &texture)
 	{
-		int texindex = set_batcher_active(canvas, texture);
+		Pointf texture_position[4];
+		texture_rect_positions(src, texture, texture_position);
 
-		vertices[position + 0].position = to_position(dest.left, dest.top);
-		vertices[position + 1].position = to_position(dest.right, dest.top);
-		vertices[position + 2].position = to_position(dest.left, dest.bottom);
-		vertices[position + 3].position = to_position(dest.right, dest.top);
-		vertices[position + 4].position = to_position(dest.right, dest.bottom);
-		vertices[position + 5].position = to_position(dest.left, dest.bottom);
-		float src_left = (src.left) / tex_sizes[texindex].width;
-		float src_top = (src.top) / tex_sizes[texindex].height;
-		float src_right = (src.right) / tex_sizes[texindex].width;
-		float src_bottom = (src.bottom) / tex_sizes[texindex].height;
-		vertices[position + 0].texcoord = Vec2f(src_left, src_top);
-		vertices[position + 1].texcoord = Vec2f(src_right, src_top);
-		vertices[position + 2].texcoord = Vec2f(src_left, src_bottom);
-		vertices[position + 3].texcoord = Vec2f(src_right, src_top);
-		vertices[position + 4].texcoord = Vec2f(src_right, src_bottom);
-		vertices[position + 5].texcoord = Vec2f(src_left, src_bottom);
-		for (int i = 0; i < 6; i++)
-		{
-			vertices[position + i].color = Vec4f(color.x, color.y, color.z, color.w);
-			vertices[position + i].texindex = texindex;
-		}
-		position += 6;
+		Rectf dest = image_dest;
+		QuadClip clip = clip_quad(canvas, dest, texture_position);
+		if (clip == QuadClip::hidden)
+			return;
+
+		Pointf dest_position[4] = { Pointf(dest.left, dest.top), Pointf(dest.right, dest.top), Pointf(dest.right, dest.bottom), Pointf(dest.left, dest.bottom) };
+
+		int texindex = set_batcher_active(canvas, texture, false, StandardColorf::black(), fits_quad_vertex(texture_position, color), clip == QuadClip::visible);
+		add_quad(dest_position, texture_position, color, texindex);
 	}
 
 	void RenderBatchTriangle::draw_image(const CanvasPtr &canvas, const Rectf &src, const Quadf &dest, const Colorf &color, const Texture2DPtr &texture)
 	{
-		int texindex = set_batcher_active(canvas, texture);
+		Pointf texture_position[4];
+		texture_rect_positions(src, texture, texture_position);
+		Pointf dest_position[4] = { dest.p, dest.q, dest.r, dest.s };
+
+		int texindex = set_batcher_active(canvas, texture, false, StandardColorf::black(), fits_quad_vertex(texture_position, color));
+		add_quad(dest_position, texture_position, color, texindex);
+	}
+
+	void RenderBatchTriangle::draw_glyph_subpixel(const CanvasPtr &canvas, const Rectf &src, const Rectf &glyph_dest, const Colorf &color, const Texture2DPtr &texture)
+	{
+		Pointf texture_position[4];
+		texture_rect_positions(src, texture, texture_position);
+
+		Rectf dest = glyph_dest;
+		QuadClip clip = clip_quad(canvas, dest, texture_position);
+		if (clip == QuadClip::hidden)
+			return;
+
+		Pointf dest_position[4] = { Pointf(dest.left, dest.top), Pointf(dest.right, dest.top), Pointf(dest.right, dest.bottom), Pointf(dest.left, dest.bottom) };
+
+		// The glyph color goes into the blend constant
+		Colorf white(1.0f, 1.0f, 1.0f, 1.0f);
+		int texindex = set_batcher_active(canvas, texture, true, color, fits_quad_vertex(texture_position, white), clip == QuadClip::visible);
+		add_quad(dest_position, texture_position, white, texindex);
+	}
+
+	void RenderBatchTriangle::fill(const CanvasPtr &canvas, float x1, float y1, float x2, float y2, const Colorf &color)
+	{
+		Pointf texture_position[4];
+		Rectf dest(x1, y1, x2, y2);
+		QuadClip clip = clip_quad(canvas, dest, texture_position);
+		if (clip == QuadClip::hidden)
+			return;
+
+		Pointf dest_position[4] = { Pointf(dest.left, dest.top), Pointf(dest.right, dest.top), Pointf(dest.right, dest.bottom), Pointf(dest.left, dest.bottom) };
+
+		int texindex = set_batcher_active(canvas, fits_quad_vertex(texture_position, color), clip == QuadClip::visible);
+		add_quad(dest_position, texture_position, color, texindex);
+	}
+
+	void RenderBatchTriangle::add_quad(const Pointf dest_position[4], const Pointf texture_position[4], const Colorf &color, int texindex)
+	{
+		if (quad_format)
+		{
+			Vec4ub packed_color(
+				(unsigned char)(color.x * 255.0f + 0.5f),
+				(unsigned char)(color.y * 255.0f + 0.5f),
+				(unsigned char)(color.z * 255.0f + 0.5f),
+				(unsigned char)(color.w * 255.0f + 0.5f));
 
-		vertices[position + 0].position = to_position(dest.p.x, dest.p.y);
-		vertices[position + 1].position = to_position(dest.q.x, dest.q.y);
-		vertices[position + 2].position = to_position(dest.s.x, dest.s.y);
-		vertices[position + 3].position = to_position(dest.q.x, dest.q.y);
-		vertices[position + 4].position = to_position(dest.r.x, dest.r.y);
-		vertices[position + 5].position = to_position(dest.s.x, dest.s.y);
-		float src_left = (src.left) / tex_sizes[texindex].width;
-		float src_top = (src.top) / tex_sizes[texindex].height;
-		float src_right = (src.right) / tex_sizes[texindex].width;
-		float src_bottom = (src.bottom) / tex_sizes[texindex].height;
-		vertices[position + 0].texcoord = Vec2f(src_left, src_top);
-		vertices[position + 1].texcoord = Vec2f(src_right, src_top);
-		vertices[position + 2].texcoord = Vec2f(src_left, src_bottom);
-		vertices[position + 3].texcoord = Vec2f(src_right, src_top);
-		vertices[position + 4].texcoord = Vec2f(src_right, src_bottom);
-		vertices[position + 5].texcoord = Vec2f(src_left, src_bottom);
-		for (int i = 0; i < 6; i++)
+			for (int i = 0; i < 4; i++)
+			{
+				QuadVertex &v = quad_vertices[position++];
+				v.position = to_quad_position(dest_position[i].x, dest_position[i].y);
+				v.texcoord = Vec2us((unsigned short)(texture_position[i].x * 65535.0f + 0.5f), (unsigned short)(texture_position[i].y * 65535.0f + 0.5f));
+				v.color = packed_color;
+				v.texindex = texindex;
+			}
+		}
+		else
 		{
-			vertices[position + i].color = Vec4f(color.x, color.y, color.z, color.w);
-			vertices[position + i].texindex = texindex;
+			// Same triangles as the index buffer of the quad format
+			static const int corners[6] = { 0, 1, 3, 1, 2, 3 };
+			for (int corner : corners)
+				to_sprite_vertex(texture_position[corner], dest_position[corner], vertices[position++], texindex, color);
 		}
-		position += 6;
 	}
 
-	void RenderBatchTriangle::draw_glyph_subpixel(const CanvasPtr &canvas, const Rectf &src, const Rectf &dest, const Colorf &color, const Texture2DPtr &texture)
+	bool RenderBatchTriangle::fits_quad_vertex(const Pointf texture_position[4], const Colorf &color)
 	{
-		int texindex = set_batcher_active(canvas, texture, true, color);
-
-		vertices[position + 0].position = to_position(dest.left, dest.top);
-		vertices[position + 1].position = to_position(dest.right, dest.top);
-		vertices[position + 2].position = to_position(dest.left, dest.bottom);
-		vertices[position + 3].position = to_position(dest.right, dest.top);
-		vertices[position + 4].position = to_position(dest.right, dest.bottom);
-		vertices[position + 5].position = to_position(dest.left, dest.bottom);
-		float src_left = (src.left) / tex_sizes[texindex].width;
-		float src_top = (src.top) / tex_sizes[texindex].height;
-		float src_right = (src.right) / tex_sizes[texindex].width;
-		float src_bottom = (src.bottom) / tex_sizes[texindex].height;
-		vertices[position + 0].texcoord = Vec2f(src_left, src_top);
-		vertices[position + 1].texcoord = Vec2f(src_right, src_top);
-		vertices[position + 2].texcoord = Vec2f(src_left, src_bottom);
-		vertices[position + 3].texcoord = Vec2f(src_right, src_top);
-		vertices[position + 4].texcoord = Vec2f(src_right, src_bottom);
-		vertices[position + 5].texcoord = Vec2f(src_left, src_bottom);
-		for (int i = 0; i < 6; i++)
+		// Repeating textures and colors outside 0-1 need the full precision vertex
+		for (int i = 0; i < 4; i++)
 		{
-			vertices[position + i].color = Vec4f(1.0f, 1.0f, 1.0f, 1.0f);
-			vertices[position + i].texindex = texindex;
+			if (texture_position[i].x < 0.0f || texture_position[i].x > 1.0f || texture_position[i].y < 0.0f || texture_position[i].y > 1.0f)
+				return false;
 		}
-		position += 6;
+		return color.x >= 0.0f && color.x <= 1.0f && color.y >= 0.0f && color.y <= 1.0f && color.z >= 0.0f && color.z <= 1.0f && color.w >= 0.0f && color.w <= 1.0f;
 	}
 
-	void RenderBatchTriangle::fill(const CanvasPtr &canvas, float x1, float y1, float x2, float y2, const Colorf &color)
+	RenderBatchTriangle::QuadClip RenderBatchTriangle::clip_quad(const CanvasPtr &canvas, Rectf &dest, Pointf texture_position[4])
 	{
-		int texindex = set_batcher_active(canvas);
-
-		vertices[position + 0].position = to_position(x1, y1);
-		vertices[position + 1].position = to_position(x2, y1);
-		vertices[position + 2].position = to_position(x1, y2);
-		vertices[position + 3].position = to_position(x2, y1);
-		vertices[position + 4].position = to_position(x2, y2);
-		vertices[position + 5].position = to_position(x1, y2);
-		for (int i = 0; i < 6; i++)
+		CanvasImpl *canvas_impl = static_cast<CanvasImpl*>(canvas.get());
+		if (!canvas_impl->can_batch_clip())
+			return QuadClip::scissor;
+
+		Rectf clip;
+		if (!canvas_impl->batch_clip_rect(clip))
+			return QuadClip::visible;
+
+		// Only scales and translations keep the rectangle axis aligned in the clip rect's coordinates
+		const float *m = canvas->transform().matrix;
+		if (m[0 * 4 + 1] != 0.0f || m[1 * 4 + 0] != 0.0f || m[0 * 4 + 3] != 0.0f || m[1 * 4 + 3] != 0.0f || m[3 * 4 + 3] != 1.0f || m[0 * 4 + 0] == 0.0f || m[1 * 4 + 1] == 0.0f)
+			return QuadClip::scissor;
+
+		// Clip rect in the coordinates of dest
+		float clip_x1 = (clip.left - m[3 * 4 + 0]) / m[0 * 4 + 0];
+		float clip_x2 = (clip.right - m[3 * 4 + 0]) / m[0 * 4 + 0];
+		float clip_y1 = (clip.top - m[3 * 4 + 1]) / m[1 * 4 + 1];
+		float clip_y2 = (clip.bottom - m[3 * 4 + 1]) / m[1 * 4 + 1];
+		if (clip_x1 > clip_x2)
+			std::swap(clip_x1, clip_x2);
+		if (clip_y1 > clip_y2)
+			std::swap(clip_y1, clip_y2);
+
+		// Dest may be mirrored, so each edge is clamped on its own
+		Rectf clipped(
+			clamp(dest.left, clip_x1, clip_x2),
+			clamp(dest.top, clip_y1, clip_y2),
+			clamp(dest.right, clip_x1, clip_x2),
+			clamp(dest.bottom, clip_y1, clip_y2));
+
+		if (clipped.left == clipped.right || clipped.top == clipped.bottom)
+			return QuadClip::hidden;
+
+		if (clipped.left != dest.left || clipped.top != dest.top || clipped.right != dest.right || clipped.bottom != dest.bottom)
 		{
-			vertices[position + i].color = Vec4f(color.x, color.y, color.z, color.w);
-			vertices[position + i].texcoord = Vec2f(0.0f, 0.0f);
-			vertices[position + i].texindex = texindex;
+			// Texture coordinates at the new corners, interpolated between the old ones
+			float s0 = (clipped.left - dest.left) / (dest.right - dest.left);
+			float s1 = (clipped.right - dest.left) / (dest.right - dest.left);
+			float t0 = (clipped.top - dest.top) / (dest.bottom - dest.top);
+			float t1 = (clipped.bottom - dest.top) / (dest.bottom - dest.top);
+
+			Pointf top0 = mix(texture_position[0], texture_position[1], s0);
+			Pointf top1 = mix(texture_position[0], texture_position[1], s1);
+			Pointf bottom0 = mix(texture_position[3], texture_position[2], s0);
+			Pointf bottom1 = mix(texture_position[3], texture_position[2], s1);
+
+			texture_position[0] = mix(top0, bottom0, t0);
+			texture_position[1] = mix(top1, bottom1, t0);
+			texture_position[2] = mix(top1, bottom1, t1);
+			texture_position[3] = mix(top0, bottom0, t1);
+
+			dest = clipped;
 		}
-		position += 6;
+
+		return QuadClip::visible;
+	}
+
+	void RenderBatchTriangle::texture_rect_positions(const Rectf &src, const Texture2DPtr &texture, Pointf out_texture_position[4])
+	{
+		float width = (float)texture->width();
+		float height = (float)texture->height();
+		float src_left = src.left / width;
+		float src_top = src.top / height;
+		float src_right = src.right / width;
+		float src_bottom = src.bottom / height;
+		out_texture_position[0] = Pointf(src_left, src_top);
+		out_texture_position[1] = Pointf(src_right, src_top);
+		out_texture_position[2] = Pointf(src_right, src_bottom);
+		out_texture_position[3] = Pointf(src_left, src_bottom);
 	}
 
 	inline Vec4f RenderBatchTriangle::to_position(float x, float y) const
@@ -241,14 +308,24 @@ namespace uicore
 			modelview_projection_matrix.matrix[0 * 4 + 3] * x + modelview_projection_matrix.matrix[1 * 4 + 3] * y + modelview_projection_matrix.matrix[3 * 4 + 3]);
 	}
 
+	inline Vec2f RenderBatchTriangle::to_quad_position(float x, float y) const
+	{
+		// The vertex attribute fills in z = 0 and w = 1
+		return Vec2f(
+			modelview_projection_matrix.matrix[0 * 4 + 0] * x + modelview_projection_matrix.matrix[1 * 4 + 0] * y + modelview_projection_matrix.matrix[3 * 4 + 0],
+			modelview_projection_matrix.matrix[0 * 4 + 1] * x + modelview_projection_matrix.matrix[1 * 4 + 1] * y + modelview_projection_matrix.matrix[3 * 4 + 1]);
+	}
 
-	int RenderBatchTriangle::set_batcher_active(const CanvasPtr &canvas, const Texture2DPtr &texture, bool glyph_program, const Colorf &new_constant_color)
+
+	int RenderBatchTriangle::set_batcher_active(const CanvasPtr &canvas, const Texture2DPtr &texture, bool glyph_program, const Colorf &new_constant_color, bool quad, bool clips_itself)
 	{
-		if (use_glyph_program != glyph_program || constant_color != new_constant_color)
+		quad = use_quad_format(canvas, quad, clips_itself);
+		if (use_glyph_program != glyph_program || constant_color != new_constant_color || quad_format != quad)
 		{
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::glyph_program);
 			use_glyph_program = glyph_program;
 			constant_color = new_constant_color;
+			quad_format = quad;
 		}
 
 		int texindex = -1;
@@ -267,76 +344,102 @@ namespace uicore
 			tex_sizes[texindex] = Sizef((float)current_textures[texindex]->width(), (float)current_textures[texindex]->height());
 		}
 
-		if (position == 0 || position + 6 > max_vertices || texindex == -1)
+		if (position == 0 || !has_room_for_quad() || texindex == -1)
 		{
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(texindex == -1 ? BatchFlushReason::texture_slots : BatchFlushReason::buffer_full);
 			texindex = 0;
 			current_textures[texindex] = texture;
 			num_current_textures = 1;
 			tex_sizes[texindex] = Sizef((float)current_textures[texindex]->width(), (float)current_textures[texindex]->height());
 		}
-		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this);
+		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this, clips_itself);
+		begin_vertices(canvas);
 		return texindex;
 	}
 
-	int RenderBatchTriangle::set_batcher_active(const CanvasPtr &canvas)
+	int RenderBatchTriangle::set_batcher_active(const CanvasPtr &canvas, bool quad, bool clips_itself)
 	{
-		if (use_glyph_program != false)
+		quad = use_quad_format(canvas, quad, clips_itself);
+		if (use_glyph_program != false || quad_format != quad)
 		{
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::glyph_program);
 			use_glyph_program = false;
+			quad_format = quad;
 		}
 
-		if (position == 0 || position + 6 > max_vertices)
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
-		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this);
+		if (position == 0 || !has_room_for_quad())
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::buffer_full);
+		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this, clips_itself);
+		begin_vertices(canvas);
 		return RenderBatchTriangle::max_textures;
 	}
 
 	int RenderBatchTriangle::set_batcher_active(const CanvasPtr &canvas, int num_vertices)
 	{
-		if (use_glyph_program != false)
+		if (use_glyph_program != false || quad_format)
 		{
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::glyph_program);
 			use_glyph_program = false;
+			quad_format = false;
 		}
 
 		if (position + num_vertices > max_vertices)
-			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush(BatchFlushReason::buffer_full);
 
 		if (num_vertices > max_vertices)
 			throw Exception("Too many vertices for RenderBatchTriangle");
 
 		static_cast<CanvasImpl*>(canvas.get())->set_batcher(this);
+		begin_vertices(canvas);
 		return RenderBatchTriangle::max_textures;
 	}
 
+	void RenderBatchTriangle::begin_vertices(const CanvasPtr &canvas)
+	{
+		// The vertex format is settled before a batch starts, as changing it flushes
+		if (position == 0)
+		{
+			void *data = batch_buffer->begin_vertices(canvas->gc(), quad_format ? sizeof(QuadVertex) : sizeof(SpriteVertex));
+			vertices = (SpriteVertex *)data;
+			quad_vertices = (QuadVertex *)data;
+		}
+	}
+
+	bool RenderBatchTriangle::has_room_for_quad() const
+	{
+		if (quad_format)
+			return position + 4 <= (int)max_quad_vertices;
+		else
+			return position + 6 <= (int)max_vertices;
+	}
+
+	bool RenderBatchTriangle::use_quad_format(const CanvasPtr &canvas, bool quad, bool clips_itself)
+	{
+		// Activating the batcher brings the matrix up to date, which decides if positions fit in two floats
+		CanvasImpl *canvas_impl = static_cast<CanvasImpl*>(canvas.get());
+		canvas_impl->set_batcher(this, clips_itself);
+		return quad && quad_support && affine_matrix && canvas_impl->compact_quads();
+	}
+
 	void RenderBatchTriangle::flush(const GraphicContextPtr &gc)
 	{
 		if (position > 0)
 		{
 			gc->set_program_object(program_sprite);
 
-			int gpu_index;
-			VertexArrayVector<SpriteVertex> gpu_vertices(batch_buffer->get_vertex_buffer(gc, gpu_index));
+			int first_vertex, gpu_index;
+			VertexArrayBufferPtr gpu_buffer = batch_buffer->end_vertices(gc, position, first_vertex, gpu_index);
+			const PrimitivesArrayPtr &primitives = get_prim_array(gc, gpu_buffer, gpu_index);
 
-			if (!prim_array[gpu_index])
+			if (!glyph_blend)
 			{
-				prim_array[gpu_index] = PrimitivesArray::create(gc);
-				prim_array[gpu_index]->set_attributes(0, gpu_vertices, cl_offsetof(SpriteVertex, position));
-				prim_array[gpu_index]->set_attributes(1, gpu_vertices, cl_offsetof(SpriteVertex, color));
-				prim_array[gpu_index]->set_attributes(2, gpu_vertices, cl_offsetof(SpriteVertex, texcoord));
-				prim_array[gpu_index]->set_attributes(3, gpu_vertices, cl_offsetof(SpriteVertex, texindex));
-
-				if (!glyph_blend)
-				{
-					BlendStateDescription blend_desc;
-					blend_desc.set_blend_function(blend_constant_color, blend_one_minus_src_color, blend_zero, blend_one);
-					glyph_blend = gc->create_blend_state(blend_desc);
-				}
+				BlendStateDescription blend_desc;
+				blend_desc.set_blend_function(blend_constant_color, blend_one_minus_src_color, blend_zero, blend_one);
+				glyph_blend = gc->create_blend_state(blend_desc);
 			}
 
-			gpu_vertices.upload_data(gc, 0, vertices, position);
+			int vertex_size = quad_format ? sizeof(QuadVertex) : sizeof(SpriteVertex);
+			batch_buffer->count_draw_call(position, position * vertex_size);
 
 			for (int i = 0; i < num_current_textures; i++)
 				gc->set_texture(i, current_textures[i]);
@@ -350,15 +453,17 @@ namespace uicore
 #endif
 
 			if (use_glyph_program)
-			{
 				gc->set_blend_state(glyph_blend, constant_color);
-				gc->draw_primitives(type_triangles, position, prim_array[gpu_index]);
-				gc->reset_blend_state();
-			}
+
+			gc->set_primitives_array(primitives);
+			if (quad_format)
+				static_cast<GraphicContextImpl*>(gc.get())->draw_primitives_elements_base_vertex(type_triangles, position / 4 * 6, quad_indices, type_unsigned_short, 0, first_vertex);
 			else
-			{
-				gc->draw_primitives(type_triangles, position, prim_array[gpu_index]);
-			}
+				gc->draw_primitives_array(type_triangles, first_vertex, position);
+			gc->reset_primitives_array();
+
+			if (use_glyph_program)
+				gc->reset_blend_state();
 
 			for (int i = 0; i < num_current_textures; i++)
 				gc->reset_texture(i);
@@ -381,8 +486,59 @@ namespace uicore
 		}
 	}
 
+	const PrimitivesArrayPtr &RenderBatchTriangle::get_prim_array(const GraphicContextPtr &gc, const VertexArrayBufferPtr &buffer, int gpu_index)
+	{
+		if (quad_format)
+		{
+			if (!quad_prim_array[gpu_index])
+			{
+				VertexArrayVector<QuadVertex> gpu_vertices(buffer);
+				quad_prim_array[gpu_index] = PrimitivesArray::create(gc);
+				quad_prim_array[gpu_index]->set_attributes(0, gpu_vertices, cl_offsetof(QuadVertex, position));
+				quad_prim_array[gpu_index]->set_attributes(1, gpu_vertices, cl_offsetof(QuadVertex, color), true);
+				quad_prim_array[gpu_index]->set_attributes(2, gpu_vertices, cl_offsetof(QuadVertex, texcoord), true);
+				quad_prim_array[gpu_index]->set_attributes(3, gpu_vertices, cl_offsetof(QuadVertex, texindex));
+			}
+
+			if (!quad_indices)
+			{
+				// Two triangles per quad, for as many quads as fit in a vertex buffer
+				std::vector<unsigned short> indices;
+				indices.reserve(max_quad_vertices / 4 * 6);
+				for (int i = 0; i < max_quad_vertices; i += 4)
+				{
+					indices.push_back(i + 0);
+					indices.push_back(i + 1);
+					indices.push_back(i + 3);
+					indices.push_back(i + 1);
+					indices.push_back(i + 2);
+					indices.push_back(i + 3);
+				}
+				quad_indices = ElementArrayBuffer::create(gc, indices.data(), (int)(indices.size() * sizeof(unsigned short)));
+			}
+
+			return quad_prim_array[gpu_index];
+		}
+		else
+		{
+			if (!prim_array[gpu_index])
+			{
+				VertexArrayVector<SpriteVertex> gpu_vertices(buffer);
+				prim_array[gpu_index] = PrimitivesArray::create(gc);
+				prim_array[gpu_index]->set_attributes(0, gpu_vertices, cl_offsetof(SpriteVertex, position));
+				prim_array[gpu_index]->set_attributes(1, gpu_vertices, cl_offsetof(SpriteVertex, color));
+				prim_array[gpu_index]->set_attributes(2, gpu_vertices, cl_offsetof(SpriteVertex, texcoord));
+				prim_array[gpu_index]->set_attributes(3, gpu_vertices, cl_offsetof(SpriteVertex, texindex));
+			}
+			return prim_array[gpu_index];
+		}
+	}
+
 	void RenderBatchTriangle::matrix_changed(const Mat4f &new_modelview, const Mat4f &new_projection, TextureImageYAxis image_yaxis, float pixel_ratio)
 	{
 		modelview_projection_matrix = new_projection * new_modelview;
+
+		const float *m = modelview_projection_matrix.matrix;
+		affine_matrix = m[0 * 4 + 2] == 0.0f && m[1 * 4 + 2] == 0.0f && m[3 * 4 + 2] == 0.0f && m[0 * 4 + 3] == 0.0f && m[1 * 4 + 3] == 0.0f && m[3 * 4 + 3] == 1.0f;
 	}
 }
@@ -33,6 +33,7 @@
 #include "UICore/Display/Render/texture.h"
 #include "UICore/Display/Render/graphic_context.h"
 #include "UICore/Display/Render/texture_2d.h"
+#include "UICore/Display/Render/element_array_buffer.h"
 #include "render_batch_buffer.h"
 
 namespace uicore
@@ -69,23 +70,62 @@ namespace uicore
 			int texindex;
 		};
 
-		int set_batcher_active(const CanvasPtr &canvas, const Texture2DPtr &texture, bool glyph_program = false, const Colorf &constant_color = StandardColorf::black());
-		int set_batcher_active(const CanvasPtr &canvas);
+		/// \brief Vertex used for quads when the transform is 2D and the texture coordinates and color fit 16 and 8 bits
+		///
+		/// Four of these plus a shared index buffer replace six SpriteVertex. The sprite program reads both formats,
+		/// as the attributes expand to the same shader inputs.
+		struct QuadVertex
+		{
+			Vec2f position;
+			Vec2us texcoord;
+			Vec4ub color;
+			int texindex;
+		};
+
+		/// \brief How a rectangle quad relates to the clip rect
+		enum class QuadClip
+		{
+			scissor,	// Cannot be clipped on the CPU, the scissor must clip it
+			visible,	// Clipped on the CPU, or not clipped at all
+			hidden	// Entirely outside the clip rect
+		};
+
+		int set_batcher_active(const CanvasPtr &canvas, const Texture2DPtr &texture, bool glyph_program = false, const Colorf &constant_color = StandardColorf::black(), bool quad = false, bool clips_itself = false);
+		int set_batcher_active(const CanvasPtr &canvas, bool quad = false, bool clips_itself = false);
 		int set_batcher_active(const CanvasPtr &canvas, int num_vertices);
+		bool use_quad_format(const CanvasPtr &canvas, bool quad, bool clips_itself);
+		bool has_room_for_quad() const;
 		void flush(const GraphicContextPtr &gc) override;
 		void matrix_changed(const Mat4f &modelview, const Mat4f &projection, TextureImageYAxis image_yaxis, float pixel_ratio) override;
 
+		void add_quad(const Pointf dest_position[4], const Pointf texture_position[4], const Colorf &color, int texindex);
+		void begin_vertices(const CanvasPtr &canvas);
+		static bool fits_quad_vertex(const Pointf texture_position[4], const Colorf &color);
+		static QuadClip clip_quad(const CanvasPtr &canvas, Rectf &dest, Pointf texture_position[4]);
+		static void texture_rect_positions(const Rectf &src, const Texture2DPtr &texture, Pointf out_texture_position[4]);
+		const PrimitivesArrayPtr &get_prim_array(const GraphicContextPtr &gc, const VertexArrayBufferPtr &buffer, int gpu_index);
+
 		inline void to_sprite_vertex(const Pointf &texture_position, const Pointf &dest_position, RenderBatchTriangle::SpriteVertex &v, int texindex, const Colorf &color) const;
 		inline Vec4f to_position(float x, float y) const;
+		inline Vec2f to_quad_position(float x, float y) const;
 
 		Mat4f modelview_projection_matrix;
 		int position = 0;
 		enum { max_vertices = RenderBatchBuffer::vertex_buffer_size / sizeof(SpriteVertex) };
-		SpriteVertex *vertices;
+		enum { max_quad_vertices = RenderBatchBuffer::vertex_buffer_size / sizeof(QuadVertex) / 4 * 4 };
+		SpriteVertex *vertices = nullptr;
+		QuadVertex *quad_vertices = nullptr;	// Same memory as vertices
+		static_assert(max_quad_vertices <= 65536, "Quad vertices must be reachable with 16 bit indices");
+
+		bool quad_format = false;	// The batched vertices are QuadVertex
+		bool quad_support = false;	// The target can draw indexed primitives
+		bool affine_matrix = true;	// The transform keeps z at 0 and w at 1
 
 		RenderBatchBuffer *batch_buffer;
 
-		PrimitivesArrayPtr prim_array[RenderBatchBuffer::num_vertex_buffers];
+		PrimitivesArrayPtr prim_array[RenderBatchBuffer::num_vertex_buffers + 1];
+		PrimitivesArrayPtr quad_prim_array[RenderBatchBuffer::num_vertex_buffers + 1];
+		ElementArrayBufferPtr quad_indices;
 
 		static const int max_number_of_texture_coords = 32;
 
@@ -101,6 +101,7 @@ namespace uicore
 			node = active_root->node.insert(texture_size, next_id);
 		}
 
+		RootNode *node_root = active_root;
 		if (node == nullptr) // Couldn't find a fit in current active texture
 		{
 			// Search previous textures if policy says so
@@ -112,7 +113,10 @@ namespace uicore
 				{
 					node = root_nodes[index]->node.insert(texture_size, next_id);
 					if (node)	// We found space in a previous texture
+					{
+						node_root = root_nodes[index];
 						break;
+					}
 				}
 			}
 
@@ -121,12 +125,13 @@ namespace uicore
 				if (texture_size.width > initial_texture_size.width || texture_size.height > initial_texture_size.height)
 				{
 					// If the specified size is greater than the initial size,  then create a texture using the specified size
-					node = add_new_root(context, texture_size)->node.insert(texture_size, next_id);
+					node_root = add_new_root(context, texture_size);
 				}
 				else
 				{
-					node = add_new_root(context, initial_texture_size)->node.insert(texture_size, next_id);
+					node_root = add_new_root(context, initial_texture_size);
 				}
+				node = node_root->node.insert(texture_size, next_id);
 			}
 
 			if (node == nullptr)
@@ -135,7 +140,7 @@ namespace uicore
 
 		next_id++;
 
-		return TextureGroupImage(active_root->texture, node->image_rect);
+		return TextureGroupImage(node_root->texture, node->image_rect);
 	}
 
 	TextureGroupImpl::RootNode *TextureGroupImpl::add_new_root(const GraphicContextPtr &context, const Size &texture_size)
@@ -184,6 +189,10 @@ namespace uicore
 		if (node)
 		{
 			node->clear();
+
+			// Merge the freed rectangle with free neighbours so larger images can reuse the space
+			root_nodes[index]->node.merge_free_children();
+
 			if (root_nodes[index]->node.get_subtexture_count() <= 0)
 			{
 				root_nodes[index]->node.clear();
@@ -311,6 +320,18 @@ namespace uicore
 		}
 	}
 
+	void TextureGroupImpl::Node::merge_free_children()
+	{
+		if (child[0] && child[1])
+		{
+			child[0]->merge_free_children();
+			child[1]->merge_free_children();
+
+			if (child[0]->is_free_leaf() && child[1]->is_free_leaf())
+				clear();
+		}
+	}
+
 	TextureGroupImpl::Node *TextureGroupImpl::Node::find_image_rect(const Rect &new_rect)
 	{
 		// Check leaf
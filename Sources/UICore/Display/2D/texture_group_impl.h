@@ -66,6 +66,10 @@ namespace uicore
 			Node *insert(const Size &texture_size, int texture_id);
 			Node *find_image_rect(const Rect &new_rect);
 
+			/// \brief Merges child nodes that no longer hold any images back into this node
+			void merge_free_children();
+			bool is_free_leaf() const { return !child[0] && !child[1] && id == 0; }
+
 			void clear();
 
 			Node *child[2];
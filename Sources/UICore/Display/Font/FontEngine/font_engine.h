@@ -83,5 +83,20 @@ namespace uicore
 		virtual const FontDescription &get_desc() const = 0;
 		virtual void load_glyph_path(unsigned int glyph_index, const PathPtr &out_path, GlyphMetrics &out_metrics) = 0;
 		virtual FontHandle *get_handle() { return nullptr; }
+
+		/// \brief Creates an engine for the same font that can be used on another thread
+		///
+		/// \return The engine copy, or null if the engine does not support background rasterization
+		virtual std::unique_ptr<FontEngine> create_thread_copy() const { return nullptr; }
+
+		/// \brief Gets the glyph metrics without rasterizing the glyph
+		///
+		/// \return False if the glyph is not valid
+		virtual bool get_glyph_metrics(int glyph, GlyphMetrics &out_metrics)
+		{
+			FontPixelBuffer pb = get_font_glyph(glyph);
+			out_metrics = pb.metrics;
+			return pb.glyph != 0;
+		}
 	};
 }
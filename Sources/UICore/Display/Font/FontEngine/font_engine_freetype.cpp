@@ -35,6 +35,7 @@
 #include "font_engine_freetype.h"
 #include "UICore/Core/IOData/iodevice.h"
 #include "UICore/Display/2D/path.h"
+#include <mutex>
 
 namespace uicore
 {
@@ -50,6 +51,9 @@ public:
 
 public:
 	FT_Library library;
+
+	// Face creation and destruction must be serialized when faces are used on several threads
+	std::mutex face_mutex;
 };
 
 FontEngine_Freetype_Library::FontEngine_Freetype_Library()
@@ -85,8 +89,8 @@ FontEngine_Freetype::FontEngine_Freetype(const FontDescription &description, Dat
 {
 	font_description = description.clone();
 
-	float average_width = description.get_average_width();
-	float height = description.get_height();
+	float average_width = description.average_width();
+	float height = description.height();
 
 	// Ensure width and height are positive
 	if (average_width < 0.0f) average_width = -average_width;
@@ -96,7 +100,11 @@ FontEngine_Freetype::FontEngine_Freetype(const FontDescription &description, Dat
 
 	FontEngine_Freetype_Library &library = FontEngine_Freetype_Library::instance();
 
-	FT_Error error = FT_New_Memory_Face( library.library, (FT_Byte*)data_buffer->data(), data_buffer->size(), 0, &face);
+	FT_Error error;
+	{
+		std::unique_lock<std::mutex> face_lock(library.face_mutex);
+		error = FT_New_Memory_Face( library.library, (FT_Byte*)data_buffer->data(), data_buffer->size(), 0, &face);
+	}
 
 	if ( error == FT_Err_Unknown_File_Format )
 	{
@@ -107,7 +115,7 @@ FontEngine_Freetype::FontEngine_Freetype(const FontDescription &description, Dat
 		throw Exception("Freetype error: Font file could not be opened or read, or is corrupted.");
 	}
 
-	int pixel_width = (int)std::round(description.get_average_width() * pixel_ratio);
+	int pixel_width = (int)std::round(description.average_width() * pixel_ratio);
 	int pixel_height = (int)std::round(height * pixel_ratio);
 
 	FT_Set_Pixel_Sizes(face, pixel_width, pixel_height);
@@ -119,6 +127,7 @@ FontEngine_Freetype::~FontEngine_Freetype()
 {
 	if (face)
 	{
+		std::unique_lock<std::mutex> face_lock(FontEngine_Freetype_Library::instance().face_mutex);
 		FT_Done_Face(face);
 	}
 }
@@ -128,16 +137,40 @@ FontEngine_Freetype::~FontEngine_Freetype()
 
 FontPixelBuffer FontEngine_Freetype::get_font_glyph(int glyph)
 {
-	if (font_description.get_subpixel())
+	if (font_description.subpixel())
 	{
 		return get_font_glyph_subpixel(glyph);
 	}
 	else
 	{
-		return get_font_glyph_standard(glyph, font_description.get_anti_alias());
+		return get_font_glyph_standard(glyph, font_description.anti_alias());
 	}
 }
 
+std::unique_ptr<FontEngine> FontEngine_Freetype::create_thread_copy() const
+{
+	DataBufferPtr font_databuffer = data_buffer;
+	return std::unique_ptr<FontEngine>(new FontEngine_Freetype(font_description.clone(), font_databuffer, pixel_ratio));
+}
+
+bool FontEngine_Freetype::get_glyph_metrics(int glyph, GlyphMetrics &out_metrics)
+{
+	FT_Int32 load_flags;
+	if (font_description.subpixel())
+		load_flags = FT_LOAD_TARGET_LCD;
+	else if (font_description.anti_alias())
+		load_flags = FT_LOAD_TARGET_LIGHT;
+	else
+		load_flags = FT_LOAD_TARGET_MONO;
+
+	FT_Error error = FT_Load_Glyph(face, FT_Get_Char_Index(face, glyph), load_flags);
+	if (error)
+		return false;
+
+	out_metrics = get_slot_metrics();
+	return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // FontEngine_Freetype Operations:
 
@@ -257,19 +290,7 @@ FontPixelBuffer FontEngine_Freetype::get_font_glyph_standard(int glyph, bool ant
 
 	font_buffer.glyph = glyph;
 	// Set Increment pen position
-	font_buffer.metrics.bbox_offset.x = slot->metrics.horiBearingX / 64.0f;
-	font_buffer.metrics.bbox_offset.y = -slot->metrics.horiBearingY / 64.0f;
-	font_buffer.metrics.bbox_size.width = slot->metrics.width / 64.0f;
-	font_buffer.metrics.bbox_size.height = slot->metrics.height / 64.0f;
-	font_buffer.metrics.advance.width = slot->advance.x / 64.0f;
-	font_buffer.metrics.advance.height = slot->advance.y / 64.0f;
-
-	font_buffer.metrics.advance.width /= pixel_ratio;
-	font_buffer.metrics.advance.height /= pixel_ratio;
-	font_buffer.metrics.bbox_offset.x /= pixel_ratio;
-	font_buffer.metrics.bbox_offset.y /= pixel_ratio;
-	font_buffer.metrics.bbox_size.width /= pixel_ratio;
-	font_buffer.metrics.bbox_size.height /= pixel_ratio;
+	font_buffer.metrics = get_slot_metrics();
 
 	if (error || slot->bitmap.rows == 0 || slot->bitmap.width == 0)
 		return font_buffer;
@@ -368,19 +389,7 @@ FontPixelBuffer FontEngine_Freetype::get_font_glyph_subpixel(int glyph)
 
 	font_buffer.glyph = glyph;
 	// Set Increment pen position
-	font_buffer.metrics.bbox_offset.x = slot->metrics.horiBearingX / 64.0f;
-	font_buffer.metrics.bbox_offset.y = -slot->metrics.horiBearingY / 64.0f;
-	font_buffer.metrics.bbox_size.width = slot->metrics.width / 64.0f;
-	font_buffer.metrics.bbox_size.height = slot->metrics.height / 64.0f;
-	font_buffer.metrics.advance.width = slot->advance.x / 64.0f;
-	font_buffer.metrics.advance.height = slot->advance.y / 64.0f;
-
-	font_buffer.metrics.advance.width /= pixel_ratio;
-	font_buffer.metrics.advance.height /= pixel_ratio;
-	font_buffer.metrics.bbox_offset.x /= pixel_ratio;
-	font_buffer.metrics.bbox_offset.y /= pixel_ratio;
-	font_buffer.metrics.bbox_size.width /= pixel_ratio;
-	font_buffer.metrics.bbox_size.height /= pixel_ratio;
+	font_buffer.metrics = get_slot_metrics();
 
 	if (error || slot->bitmap.rows == 0 || slot->bitmap.width == 0)
 		return font_buffer;
@@ -428,6 +437,27 @@ FontPixelBuffer FontEngine_Freetype::get_font_glyph_subpixel(int glyph)
 /////////////////////////////////////////////////////////////////////////////
 // FontEngine_Freetype Implementation:
 
+GlyphMetrics FontEngine_Freetype::get_slot_metrics() const
+{
+	FT_GlyphSlot slot = face->glyph;
+
+	GlyphMetrics metrics;
+	metrics.bbox_offset.x = slot->metrics.horiBearingX / 64.0f;
+	metrics.bbox_offset.y = -slot->metrics.horiBearingY / 64.0f;
+	metrics.bbox_size.width = slot->metrics.width / 64.0f;
+	metrics.bbox_size.height = slot->metrics.height / 64.0f;
+	metrics.advance.width = slot->advance.x / 64.0f;
+	metrics.advance.height = slot->advance.y / 64.0f;
+
+	metrics.advance.width /= pixel_ratio;
+	metrics.advance.height /= pixel_ratio;
+	metrics.bbox_offset.x /= pixel_ratio;
+	metrics.bbox_offset.y /= pixel_ratio;
+	metrics.bbox_size.width /= pixel_ratio;
+	metrics.bbox_size.height /= pixel_ratio;
+	return metrics;
+}
+
 Pointf FontEngine_Freetype::FT_Vector_to_Pointf(const FT_Vector &vec)
 {
 	Pointf P;
@@ -548,7 +578,7 @@ void FontEngine_Freetype::calculate_font_metrics()
 		descent / pixel_ratio,
 		internal_leading / pixel_ratio,
 		external_leading / pixel_ratio,
-		font_description.get_line_height(),		// Calculated in FontMetrics as height + metrics.tmExternalLeading if not specified
+		font_description.line_height(),		// Calculated in FontMetrics as height + metrics.tmExternalLeading if not specified
 		pixel_ratio
 		);
 }
@@ -82,6 +82,9 @@ public:
 
 	FontPixelBuffer get_font_glyph_subpixel(int glyph);
 	const FontDescription &get_desc() const override { return font_description; }
+
+	std::unique_ptr<FontEngine> create_thread_copy() const override;
+	bool get_glyph_metrics(int glyph, GlyphMetrics &out_metrics) override;
 	
 /// \}
 /// \name Operations
@@ -96,6 +99,7 @@ public:
 
 private:
 	void calculate_font_metrics();
+	GlyphMetrics get_slot_metrics() const;
 	TagStruct get_tag_struct(int cont, int index, FT_Outline *outline);
 	int get_index_of_next_contour_point(int cont, int index, FT_Outline *outline);
 	int get_index_of_prev_contour_point(int cont, int index, FT_Outline *outline);
@@ -41,6 +41,8 @@
 #include "UICore/Core/IOData/path_help.h"
 #include "UICore/Core/IOData/file.h"
 #include "UICore/Display/2D/canvas_impl.h"
+#include "UICore/Display/Font/font.h"
+#include "UICore/Core/Crypto/hash_functions.h"
 
 #ifdef WIN32
 #include "FontEngine/font_engine_win32.h"
@@ -74,7 +76,7 @@ namespace uicore
 		FontMetrics font_metrics;
 	};
 
-	FontFamily_Impl::FontFamily_Impl(const std::string &family_name) : _family_name(family_name), texture_group(TextureGroup::create(Size(256, 256)))
+	FontFamily_Impl::FontFamily_Impl(const std::string &family_name) : _family_name(family_name), glyph_atlas(std::make_shared<GlyphAtlas>(Size(256, 256)))
 	{
 	}
 
@@ -127,8 +129,10 @@ namespace uicore
 		std::shared_ptr<FontEngine> engine = std::make_shared<FontEngine_Freetype>(desc, font_databuffer, pixel_ratio);
 		font_cache.push_back(Font_Cache(engine));
 #endif
-		font_cache.back().glyph_cache->set_texture_group(texture_group);
+		font_cache.back().glyph_cache->set_atlas(glyph_atlas);
 		font_cache.back().pixel_ratio = pixel_ratio;
+		font_cache.back().font_databuffer = font_databuffer;
+		attach_snapshot(font_cache.back());
 	}
 
 	void FontFamily_Impl::font_face_load(const FontDescription &desc, const std::string &typeface_name, float pixel_ratio)
@@ -136,12 +140,12 @@ namespace uicore
 #if defined(WIN32)
 		std::shared_ptr<FontEngine> engine = std::make_shared<FontEngine_Win32>(desc, typeface_name, pixel_ratio);
 		font_cache.push_back(Font_Cache(engine));
-		font_cache.back().glyph_cache->set_texture_group(texture_group);
+		font_cache.back().glyph_cache->set_atlas(glyph_atlas);
 		font_cache.back().pixel_ratio = pixel_ratio;
 #elif defined(__APPLE__)
 		std::shared_ptr<FontEngine> engine = std::make_shared<FontEngine_Cocoa>(desc, typeface_name, pixel_ratio);
 		font_cache.push_back(Font_Cache(engine));
-		font_cache.back().glyph_cache->set_texture_group(texture_group);
+		font_cache.back().glyph_cache->set_atlas(glyph_atlas);
 		font_cache.back().pixel_ratio = pixel_ratio;
 #elif defined(__ANDROID__)
 		throw Exception("automatic typeface to ttf file selection is not supported on android");
@@ -232,4 +236,77 @@ namespace uicore
 
 		return font_cache.back();
 	}
+
+	void FontFamily_Impl::prewarm(const CanvasPtr &canvas, const std::vector<float> &heights, const std::string &text)
+	{
+		for (float height : heights)
+		{
+			auto font = Font::create(shared_from_this(), height);
+			font->prewarm(canvas, text);
+		}
+	}
+
+	void FontFamily_Impl::load_glyph_cache(const std::string &filename)
+	{
+		glyph_snapshots = GlyphCacheFile::load(filename);
+		for (auto &cache : font_cache)
+			attach_snapshot(cache);
+	}
+
+	void FontFamily_Impl::save_glyph_cache(const std::string &filename)
+	{
+		std::vector<GlyphSnapshotPtr> snapshots;
+		for (auto &cache : font_cache)
+		{
+			GlyphSnapshotKey key;
+			if (!snapshot_key(cache, key))
+				continue;
+
+			GlyphSnapshotPtr snapshot = cache.glyph_cache->create_snapshot(cache.engine.get());
+			snapshot->key = key;
+			if (!snapshot->glyphs.empty())
+				snapshots.push_back(snapshot);
+		}
+		GlyphCacheFile::save(filename, snapshots);
+	}
+
+	bool FontFamily_Impl::snapshot_key(const Font_Cache &cache, GlyphSnapshotKey &out_key)
+	{
+		if (!cache.font_databuffer || !cache.engine->is_automatic_recreation_allowed())
+			return false;
+
+		// Hashing a font file is not free, and all sizes of a typeface share the same data
+		std::string &font_hash = font_hashes[cache.font_databuffer.get()];
+		if (font_hash.empty())
+			font_hash = HashFunctions::sha1(cache.font_databuffer);
+
+		const FontDescription &desc = cache.engine->get_desc();
+		out_key.font_hash = font_hash;
+		out_key.height = desc.height();
+		out_key.pixel_ratio = cache.pixel_ratio;
+		out_key.weight = static_cast<int>(desc.weight());
+		out_key.style = static_cast<int>(desc.style());
+		out_key.subpixel = desc.subpixel();
+		out_key.anti_alias = desc.anti_alias();
+		return true;
+	}
+
+	void FontFamily_Impl::attach_snapshot(const Font_Cache &cache)
+	{
+		if (glyph_snapshots.empty())
+			return;
+
+		GlyphSnapshotKey key;
+		if (!snapshot_key(cache, key))
+			return;
+
+		for (const auto &snapshot : glyph_snapshots)
+		{
+			if (snapshot->key == key)
+			{
+				cache.glyph_cache->set_snapshot(snapshot);
+				break;
+			}
+		}
+	}
 }
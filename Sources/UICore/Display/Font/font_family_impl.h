@@ -40,6 +40,7 @@
 #include <map>
 #include "glyph_cache.h"
 #include "path_cache.h"
+#include "text_run_cache.h"
 
 namespace uicore
 {
@@ -49,11 +50,13 @@ namespace uicore
 	{
 	public:
 		Font_Cache() {}
-		Font_Cache(std::shared_ptr<FontEngine> &new_engine) : engine(new_engine), glyph_cache(std::make_shared<GlyphCache>()), path_cache(std::make_shared<PathCache>()) {}
+		Font_Cache(std::shared_ptr<FontEngine> &new_engine) : engine(new_engine), glyph_cache(std::make_shared<GlyphCache>()), path_cache(std::make_shared<PathCache>()), text_run_cache(std::make_shared<TextRunCache>()) {}
 		std::shared_ptr<FontEngine> engine;
 		std::shared_ptr<GlyphCache> glyph_cache;
 		std::shared_ptr<PathCache> path_cache;
+		std::shared_ptr<TextRunCache> text_run_cache;
 		float pixel_ratio = 1.0f;	// The pixel ratio this font was created for.
+		DataBufferPtr font_databuffer;	// Font file the engine was created from. Null for system fonts
 	};
 
 	class FontFamily_Definition
@@ -64,7 +67,7 @@ namespace uicore
 		DataBufferPtr font_databuffer;	// Empty = use typeface_name instead
 	};
 
-	class FontFamily_Impl : public FontFamily
+	class FontFamily_Impl : public FontFamily, public std::enable_shared_from_this<FontFamily_Impl>
 	{
 	public:
 		FontFamily_Impl(const std::string &family_name);
@@ -76,6 +79,16 @@ namespace uicore
 
 		const std::string &family_name() const override { return _family_name; }
 
+		void set_glyph_cache_budget(size_t bytes) override { glyph_atlas->budget = bytes; }
+		size_t glyph_cache_budget() const override { return glyph_atlas->budget; }
+		GlyphCacheStats glyph_cache_stats() const override { return glyph_atlas->stats(); }
+		void set_async_rasterization(bool enable) override { glyph_atlas->async_rasterization = enable; }
+		bool async_rasterization() const override { return glyph_atlas->async_rasterization; }
+
+		void prewarm(const CanvasPtr &canvas, const std::vector<float> &heights, const std::string &text) override;
+		void load_glyph_cache(const std::string &filename) override;
+		void save_glyph_cache(const std::string &filename) override;
+
 		void add_system(const FontDescription &desc, const std::string &typeface_name);
 		void add(const FontDescription &desc, const DataBufferPtr &font_databuffer);
 
@@ -89,9 +102,15 @@ namespace uicore
 		void font_face_load(const FontDescription &desc, const std::string &typeface_name, float pixel_ratio);
 		void font_face_load(const FontDescription &desc, DataBufferPtr &font_databuffer, float pixel_ratio);
 
+		bool snapshot_key(const Font_Cache &cache, GlyphSnapshotKey &out_key);
+		void attach_snapshot(const Font_Cache &cache);
+
 		std::string _family_name;
-		TextureGroupPtr texture_group;		// Shared texture group between glyph cache's
+		GlyphAtlasPtr glyph_atlas;		// Shared texture atlas between glyph cache's
 		std::vector<Font_Cache> font_cache;
 		std::vector<FontFamily_Definition> font_definitions;
+
+		std::vector<GlyphSnapshotPtr> glyph_snapshots;	// Loaded by load_glyph_cache
+		std::map<const DataBuffer *, std::string> font_hashes;
 	};
 }
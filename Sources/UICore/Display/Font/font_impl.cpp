@@ -72,7 +72,8 @@ namespace uicore
 				font_cache = font_family->copy_font(new_selected, pixel_ratio);
 
 			font_engine = font_cache.engine.get();
-			GlyphCache *glyph_cache = font_cache.glyph_cache.get();
+			glyph_cache = font_cache.glyph_cache.get();
+			text_run_cache = font_cache.text_run_cache.get();
 			PathCache *path_cache = font_cache.path_cache.get();
 
 			const FontMetrics &metrics = font_engine->get_metrics();
@@ -186,6 +187,21 @@ namespace uicore
 	std::vector<Rectf> Font_Impl::character_indices(const CanvasPtr &canvas, const std::string &text)
 	{
 		select_font_family(canvas);
+
+		TextRun *run = find_text_run(text);
+		if (!run)
+			return measure_character_indices(canvas, text);
+
+		if (!run->has_character_rects)
+		{
+			run->character_rects = measure_character_indices(canvas, text);
+			run->has_character_rects = true;
+		}
+		return run->character_rects;
+	}
+
+	std::vector<Rectf> Font_Impl::measure_character_indices(const CanvasPtr &canvas, const std::string &text)
+	{
 		std::vector<Rectf> index_store;
 
 		float dest_x = 0;
@@ -249,6 +265,13 @@ namespace uicore
 		return nullptr;
 	}
 
+	void Font_Impl::prewarm(const CanvasPtr &canvas, const std::string &text)
+	{
+		select_font_family(canvas);
+		if (!selected_pathfont)
+			glyph_cache->prewarm(canvas, font_engine, text);
+	}
+
 	void Font_Impl::draw_text(const CanvasPtr &canvas, const Pointf &position, const std::string &text, const Colorf &color)
 	{
 		select_font_family(canvas);
@@ -272,6 +295,42 @@ namespace uicore
 	GlyphMetrics Font_Impl::measure_text(const CanvasPtr &canvas, const std::string &string)
 	{
 		select_font_family(canvas);
+		return measure_cached(canvas, string);
+	}
+
+	std::vector<GlyphMetrics> Font_Impl::measure_texts(const CanvasPtr &canvas, const std::vector<std::string> &strings)
+	{
+		select_font_family(canvas);
+
+		std::vector<GlyphMetrics> metrics;
+		metrics.reserve(strings.size());
+		for (const auto &string : strings)
+			metrics.push_back(measure_cached(canvas, string));
+		return metrics;
+	}
+
+	GlyphMetrics Font_Impl::measure_cached(const CanvasPtr &canvas, const std::string &string)
+	{
+		TextRun *run = find_text_run(string);
+		if (!run)
+			return measure_run(canvas, string);
+
+		if (!run->has_metrics)
+		{
+			run->metrics = measure_run(canvas, string);
+			run->has_metrics = true;
+		}
+		return run->metrics;
+	}
+
+	TextRun *Font_Impl::find_text_run(const std::string &text)
+	{
+		float line_spacing = std::round(selected_line_height);
+		return text_run_cache->get(text, line_spacing, selected_metrics.height(), selected_metrics.ascent());
+	}
+
+	GlyphMetrics Font_Impl::measure_run(const CanvasPtr &canvas, const std::string &string)
+	{
 		GlyphMetrics total_metrics;
 
 		float line_spacing = std::round(selected_line_height); // TBD: do we want to round this?
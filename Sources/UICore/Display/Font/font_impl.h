@@ -66,16 +66,23 @@ namespace uicore
 		void draw_text(const CanvasPtr &canvas, const Pointf &position, const std::string &text, const Colorf &color) override;
 		GlyphMetrics metrics(const CanvasPtr &canvas, unsigned int glyph) override;
 		GlyphMetrics measure_text(const CanvasPtr &canvas, const std::string &string) override;
+		std::vector<GlyphMetrics> measure_texts(const CanvasPtr &canvas, const std::vector<std::string> &strings) override;
 		const FontMetrics &font_metrics(const CanvasPtr &canvas) override;
 		int character_index(const CanvasPtr &canvas, const std::string &text, const Pointf &point) override;
 		std::vector<Rectf> character_indices(const CanvasPtr &canvas, const std::string &text) override;
 		FontHandle *handle(const CanvasPtr &canvas) override;
+		void prewarm(const CanvasPtr &canvas, const std::string &text) override;
 
 		void glyph_path(const CanvasPtr &canvas, unsigned int glyph_index, const PathPtr &out_path, GlyphMetrics &out_metrics);
 
 	private:
 		void select_font_family(const CanvasPtr &canvas);
 
+		TextRun *find_text_run(const std::string &text);
+		GlyphMetrics measure_cached(const CanvasPtr &canvas, const std::string &string);
+		GlyphMetrics measure_run(const CanvasPtr &canvas, const std::string &string);
+		std::vector<Rectf> measure_character_indices(const CanvasPtr &canvas, const std::string &text);
+
 		FontDescription selected_description;
 		float selected_line_height = 0.0f;
 		float selected_pixel_ratio = 1.0f;
@@ -86,6 +93,8 @@ namespace uicore
 		FontMetrics selected_metrics;
 
 		FontEngine *font_engine = nullptr;	// If null, use select_font_family() to update
+		GlyphCache *glyph_cache = nullptr;
+		TextRunCache *text_run_cache = nullptr;
 		std::shared_ptr<FontFamily_Impl> font_family;
 
 		Font_Draw *font_draw = nullptr;
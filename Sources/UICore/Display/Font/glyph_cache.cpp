@@ -42,46 +42,259 @@
 #include "UICore/Core/Text/text.h"
 #include "UICore/Core/Text/utf8_reader.h"
 #include "UICore/Display/2D/render_batch_triangle.h"
+#include "UICore/Display/2D/canvas_impl.h"
+#include "glyph_rasterizer.h"
+#include <algorithm>
 
 namespace uicore
 {
+	GlyphAtlas::GlyphAtlas(const Size &texture_size) : texture_group(TextureGroup::create(texture_size))
+	{
+		// Evicted glyphs leave holes in older textures that should be reused
+		texture_group->set_allocation_policy(TextureGroupAllocationPolicy::search_previous_textures);
+	}
+
+	bool GlyphAtlas::make_room(const Size &size)
+	{
+		if (budget == 0)
+			return false;
+
+		bool evicted = false;
+		size_t bytes = bytes_used(size);
+		while (glyph_bytes + bytes > budget && !lru.empty())
+		{
+			Font_TextureGlyph *glyph = lru.back();
+			glyph->cache->evict_glyph(glyph);
+			evictions++;
+			evicted = true;
+		}
+		return evicted;
+	}
+
+	void GlyphAtlas::add(Font_TextureGlyph *glyph)
+	{
+		glyph->evictable = true;
+		glyph->lru_position = lru.insert(lru.begin(), glyph);
+		glyph_bytes += bytes_used(glyph->atlas_rect.size());
+	}
+
+	void GlyphAtlas::release(Font_TextureGlyph *glyph)
+	{
+		if (glyph->evictable)
+		{
+			lru.erase(glyph->lru_position);
+			glyph_bytes -= bytes_used(glyph->atlas_rect.size());
+			texture_group->remove(TextureGroupImage(glyph->texture, glyph->atlas_rect));
+			glyph->evictable = false;
+		}
+	}
+
+	GlyphCacheStats GlyphAtlas::stats() const
+	{
+		GlyphCacheStats stats;
+		stats.hits = hits;
+		stats.misses = misses;
+		stats.evictions = evictions;
+		stats.glyphs = glyphs;
+		stats.glyph_bytes = glyph_bytes;
+		for (const auto &texture : texture_group->textures())
+			stats.atlas_bytes += bytes_used(texture->size());
+		stats.atlas_textures = texture_group->texture_count();
+		return stats;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+
 	GlyphCache::GlyphCache()
 	{
-		glyph_list.reserve(256);
+		glyph_list.reserve(dense_glyph_count);
 	}
 
 	GlyphCache::~GlyphCache()
 	{
+		if (async_source)
+			async_source->func_completed = nullptr;
+
+		if (atlas)
+		{
+			for (auto &it : glyph_list)
+				atlas->release(it.second.get());
+			atlas->glyphs -= glyph_list.size();
+		}
 	}
 
 	Font_TextureGlyph *GlyphCache::get_glyph(const CanvasPtr &canvas, FontEngine *font_engine, unsigned int glyph)
 	{
-		auto size = glyph_list.size();
-		for (int cnt = 0; cnt < size; cnt++)
+		if (async_source && async_source->has_completed())
+			upload_completed(canvas);
+
+		Font_TextureGlyph *font_glyph = find_glyph(glyph);
+		if (font_glyph)
 		{
-			if (glyph_list[cnt]->glyph == glyph)
-				return &(*glyph_list[cnt]);
+			atlas->hits++;
+			if (font_glyph->evictable)
+				atlas->touch(font_glyph);
+			else if (font_glyph->pending)
+				add_waiting_window(canvas);
+			return font_glyph;
 		}
 
+		atlas->misses++;
+		static_cast<CanvasImpl*>(canvas.get())->batcher.get_batch_buffer()->count_glyph_cache_misses(1);
+
+		// Images from a glyph cache file are cheaper to upload than to rasterize in the background
+		if (snapshot)
+		{
+			auto it = snapshot->glyphs.find(glyph);
+			if (it != snapshot->glyphs.end())
+			{
+				insert_glyph(canvas, it->second);
+				return find_glyph(glyph);
+			}
+		}
+
+		// Let a worker thread rasterize the glyph, drawing nothing for it until it is ready
+		if (atlas->async_rasterization && queue_glyph(canvas, font_engine, glyph))
+			return find_glyph(glyph);
+
 		// If glyph does not exist, create one automatically
 		FontPixelBuffer pb = font_engine->get_font_glyph(glyph);
 		if (pb.glyph)	// Ignore invalid glyphs
 			insert_glyph(canvas, pb);
 
-		// Search for the glyph again
-		size = glyph_list.size();
-		for (int cnt = 0; cnt < size; cnt++)
+		return find_glyph(glyph);
+	}
+
+	Font_TextureGlyph *GlyphCache::find_glyph(unsigned int glyph) const
+	{
+		if (glyph < dense_glyph_count)
+			return dense_glyphs[glyph];
+
+		auto it = glyph_list.find(glyph);
+		if (it != glyph_list.end())
+			return it->second.get();
+		return nullptr;
+	}
+
+	void GlyphCache::add_glyph(std::unique_ptr<Font_TextureGlyph> font_glyph)
+	{
+		unsigned int glyph = font_glyph->glyph;
+
+		// The first glyph inserted wins, same as when the cache was a list searched from the front
+		auto &slot = glyph_list[glyph];
+		if (slot)
 		{
-			if (glyph_list[cnt]->glyph == glyph)
-				return &(*glyph_list[cnt]);
+			if (font_glyph->atlas_rect.width() > 0)
+				atlas->texture_group->remove(TextureGroupImage(font_glyph->texture, font_glyph->atlas_rect));
+			return;
 		}
 
-		return nullptr;
+		slot = std::move(font_glyph);
+		slot->cache = this;
+		if (glyph < dense_glyph_count)
+			dense_glyphs[glyph] = slot.get();
+
+		atlas->glyphs++;
+		if (slot->atlas_rect.width() > 0)
+			atlas->add(slot.get());
+	}
+
+	void GlyphCache::evict_glyph(Font_TextureGlyph *font_glyph)
+	{
+		unsigned int glyph = font_glyph->glyph;
+		atlas->release(font_glyph);
+		atlas->glyphs--;
+
+		if (glyph < dense_glyph_count)
+			dense_glyphs[glyph] = nullptr;
+		glyph_list.erase(glyph);
 	}
 
-	void GlyphCache::set_texture_group(const TextureGroupPtr &new_texture_group)
+	bool GlyphCache::queue_glyph(const CanvasPtr &canvas, FontEngine *font_engine, unsigned int glyph)
 	{
-		texture_group = new_texture_group;
+		if (!async_source)
+		{
+			if (async_unsupported)
+				return false;
+
+			std::unique_ptr<FontEngine> prototype = font_engine->create_thread_copy();
+			if (!prototype)
+			{
+				async_unsupported = true;
+				return false;
+			}
+
+			async_source = std::make_shared<AsyncGlyphSource>(std::move(prototype));
+			async_source->func_completed = [this]() { repaint_waiting_windows(); };
+		}
+
+		// Measuring is cheap compared to rasterizing, and lets layout use the correct metrics right away
+		auto font_glyph = std::unique_ptr<Font_TextureGlyph>(new Font_TextureGlyph());
+		font_glyph->glyph = glyph;
+		font_glyph->pending = true;
+		if (!font_engine->get_glyph_metrics(glyph, font_glyph->metrics))
+			return false;
+
+		add_glyph(std::move(font_glyph));
+		async_source->queue(glyph);
+		add_waiting_window(canvas);
+		return true;
+	}
+
+	void GlyphCache::upload_completed(const CanvasPtr &canvas)
+	{
+		for (auto &completed : async_source->take_completed())
+		{
+			Font_TextureGlyph *placeholder = find_glyph(completed.glyph);
+			if (!placeholder || !placeholder->pending)
+				continue;
+
+			if (completed.pb.glyph)
+			{
+				evict_glyph(placeholder);
+				insert_glyph(canvas, completed.pb);
+			}
+			else
+			{
+				// Keep the metrics, but stop waiting for an image that will never arrive
+				placeholder->pending = false;
+			}
+		}
+	}
+
+	void GlyphCache::add_waiting_window(const CanvasPtr &canvas)
+	{
+		CanvasImpl *canvas_impl = static_cast<CanvasImpl*>(canvas.get());
+		canvas_impl->placeholders_drawn = true;
+
+		const DisplayWindowPtr &window = canvas_impl->window();
+		if (!window)
+			return;
+
+		for (const auto &waiting_window : waiting_windows)
+		{
+			if (waiting_window.lock() == window)
+				return;
+		}
+		waiting_windows.push_back(window);
+	}
+
+	void GlyphCache::repaint_waiting_windows()
+	{
+		std::vector<std::weak_ptr<DisplayWindow>> windows;
+		windows.swap(waiting_windows);
+
+		for (const auto &weak_window : windows)
+		{
+			DisplayWindowPtr window = weak_window.lock();
+			if (window)
+				window->request_repaint();
+		}
+	}
+
+	void GlyphCache::set_atlas(const GlyphAtlasPtr &new_atlas)
+	{
+		atlas = new_atlas;
 	}
 
 	GlyphMetrics GlyphCache::get_metrics(FontEngine *font_engine, const CanvasPtr &canvas, unsigned int glyph)
@@ -98,22 +311,158 @@ namespace uicore
 	{
 		auto font_glyph = std::unique_ptr<Font_TextureGlyph>(new Font_TextureGlyph());
 
+		PixelBufferPtr buffer_with_border = allocate_glyph(canvas, pb, font_glyph.get());
+		if (buffer_with_border)
+			font_glyph->texture->set_subimage(canvas->gc(), font_glyph->atlas_rect.left, font_glyph->atlas_rect.top, buffer_with_border, buffer_with_border->size());
+
+		add_glyph(std::move(font_glyph));
+	}
+
+	PixelBufferPtr GlyphCache::allocate_glyph(const CanvasPtr &canvas, const FontPixelBuffer &pb, Font_TextureGlyph *font_glyph)
+	{
 		font_glyph->glyph = pb.glyph;
 		font_glyph->offset = pb.offset;
 		font_glyph->metrics = pb.metrics;
 
-		if (!pb.empty_buffer)
+		if (pb.empty_buffer)
+			return nullptr;
+
+		PixelBufferPtr buffer_with_border = PixelBuffer::add_border(pb.buffer, glyph_border_size, pb.buffer_rect);
+		GraphicContextPtr gc = canvas->gc();
+
+		// Batched glyphs may still refer to the atlas space of evicted glyphs
+		if (atlas->make_room(buffer_with_border->size()))
+			static_cast<CanvasImpl*>(canvas.get())->batcher.flush();
+
+		TextureGroupImage sub_texture = atlas->texture_group->add(gc, buffer_with_border->size());
+		font_glyph->texture = sub_texture.texture();
+		font_glyph->atlas_rect = sub_texture.geometry();
+		font_glyph->geometry = Rect(sub_texture.geometry().left + glyph_border_size, sub_texture.geometry().top + glyph_border_size, pb.buffer_rect.size());
+		font_glyph->size = pb.size;
+		return buffer_with_border;
+	}
+
+	void GlyphCache::insert_glyphs(const CanvasPtr &canvas, std::vector<FontPixelBuffer> &pbs)
+	{
+		// Placing the tallest glyphs first packs the atlas rows tighter
+		std::sort(pbs.begin(), pbs.end(), [](const FontPixelBuffer &a, const FontPixelBuffer &b) { return a.buffer_rect.height() > b.buffer_rect.height(); });
+
+		std::vector<Texture2DPtr> old_textures = atlas->texture_group->textures();
+
+		struct GlyphUpload
 		{
-			PixelBufferPtr buffer_with_border = PixelBuffer::add_border(pb.buffer, glyph_border_size, pb.buffer_rect);
-			GraphicContextPtr gc = canvas->gc();
-			TextureGroupImage sub_texture = texture_group->add(gc, buffer_with_border->size());
-			font_glyph->texture = sub_texture.texture();
-			font_glyph->geometry = Rect(sub_texture.geometry().left + glyph_border_size, sub_texture.geometry().top + glyph_border_size, pb.buffer_rect.size());
-			font_glyph->size = pb.size;
-			sub_texture.texture()->set_subimage(gc, sub_texture.geometry().left, sub_texture.geometry().top, buffer_with_border, buffer_with_border->size());
+			Texture2DPtr texture;
+			Point position;
+			PixelBufferPtr image;
+		};
+		std::vector<GlyphUpload> uploads;
+
+		for (auto &pb : pbs)
+		{
+			auto font_glyph = std::unique_ptr<Font_TextureGlyph>(new Font_TextureGlyph());
+			PixelBufferPtr buffer_with_border = allocate_glyph(canvas, pb, font_glyph.get());
+			if (buffer_with_border)
+				uploads.push_back({ font_glyph->texture, font_glyph->atlas_rect.top_left(), buffer_with_border });
+			add_glyph(std::move(font_glyph));
+		}
+
+		GraphicContextPtr gc = canvas->gc();
+		for (const auto &texture : atlas->texture_group->textures())
+		{
+			bool new_texture = std::find(old_textures.begin(), old_textures.end(), texture) == old_textures.end();
+			if (new_texture)
+			{
+				// Nothing else lives in a texture created by this batch, so compose its glyphs and upload them at once
+				auto staging = PixelBuffer::create(texture->width(), texture->height(), tf_rgba8);
+				memset(staging->data(), 0, staging->data_size());
+
+				Rect bounds;
+				bool empty_bounds = true;
+				for (const auto &upload : uploads)
+				{
+					if (upload.texture != texture)
+						continue;
+
+					Rect dest(upload.position, upload.image->size());
+					staging->set_subimage(upload.image, upload.position, upload.image->size());
+					if (empty_bounds)
+						bounds = dest;
+					else
+						bounds.bounding_rect(dest);
+					empty_bounds = false;
+				}
+
+				if (!empty_bounds)
+					texture->set_subimage(gc, bounds.left, bounds.top, staging, bounds);
+			}
+			else
+			{
+				// Other glyphs may live between the new ones
+				for (const auto &upload : uploads)
+				{
+					if (upload.texture == texture)
+						texture->set_subimage(gc, upload.position.x, upload.position.y, upload.image, upload.image->size());
+				}
+			}
+		}
+	}
+
+	void GlyphCache::prewarm(const CanvasPtr &canvas, FontEngine *font_engine, const std::string &text)
+	{
+		if (async_source && async_source->has_completed())
+			upload_completed(canvas);
+
+		std::vector<unsigned int> glyphs;
+		UTF8_Reader reader(text.data(), text.length());
+		while (!reader.is_end())
+		{
+			unsigned int glyph = reader.character();
+			reader.next();
+
+			if (!find_glyph(glyph) && std::find(glyphs.begin(), glyphs.end(), glyph) == glyphs.end())
+				glyphs.push_back(glyph);
 		}
 
-		glyph_list.push_back(std::move(font_glyph));
+		std::vector<FontPixelBuffer> pbs;
+		pbs.reserve(glyphs.size());
+		for (unsigned int glyph : glyphs)
+		{
+			FontPixelBuffer pb = rasterize_glyph(font_engine, glyph);
+			if (pb.glyph)	// Ignore invalid glyphs
+				pbs.push_back(std::move(pb));
+		}
+
+		atlas->misses += glyphs.size();
+		static_cast<CanvasImpl*>(canvas.get())->batcher.get_batch_buffer()->count_glyph_cache_misses((int)glyphs.size());
+		insert_glyphs(canvas, pbs);
+	}
+
+	FontPixelBuffer GlyphCache::rasterize_glyph(FontEngine *font_engine, unsigned int glyph) const
+	{
+		if (snapshot)
+		{
+			auto it = snapshot->glyphs.find(glyph);
+			if (it != snapshot->glyphs.end())
+				return it->second;
+		}
+		return font_engine->get_font_glyph(glyph);
+	}
+
+	GlyphSnapshotPtr GlyphCache::create_snapshot(FontEngine *font_engine) const
+	{
+		auto new_snapshot = std::make_shared<GlyphSnapshot>();
+		for (const auto &it : glyph_list)
+		{
+			const Font_TextureGlyph *font_glyph = it.second.get();
+			if (font_glyph->pending)
+				continue;
+
+			// The atlas only keeps the images on the GPU, so they are rasterized again
+			FontPixelBuffer pb = rasterize_glyph(font_engine, font_glyph->glyph);
+			if (pb.glyph)
+				new_snapshot->glyphs[pb.glyph] = pb;
+		}
+		return new_snapshot;
 	}
 
 	void GlyphCache::insert_glyph(const CanvasPtr &canvas, unsigned int glyph, TextureGroupImage &sub_texture, const Pointf &offset, const Sizef &size, const GlyphMetrics &glyph_metrics)
@@ -131,6 +480,6 @@ namespace uicore
 			font_glyph->geometry = sub_texture.geometry();
 		}
 
-		glyph_list.push_back(std::move(font_glyph));
+		add_glyph(std::move(font_glyph));
 	}
 }
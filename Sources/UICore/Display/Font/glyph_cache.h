@@ -31,11 +31,14 @@
 #include "UICore/Display/Font/font.h"
 #include "UICore/Display/Font/glyph_metrics.h"
 #include "UICore/Display/Font/font_metrics.h"
+#include "UICore/Display/Font/font_family.h"
 #include "UICore/Display/Render/texture.h"
 #include "UICore/Display/2D/texture_group.h"
 #include "UICore/Display/Render/texture_2d.h"
+#include "glyph_cache_file.h"
 #include <list>
 #include <map>
+#include <unordered_map>
 
 namespace uicore
 {
@@ -47,6 +50,9 @@ namespace uicore
 	class FontPixelBuffer;
 	class Path;
 	class RenderBatchTriangle;
+	class GlyphCache;
+	class AsyncGlyphSource;
+	class DisplayWindow;
 
 	/// \brief Font texture format (holds a pixel buffer containing a glyph)
 	class Font_TextureGlyph
@@ -75,8 +81,69 @@ namespace uicore
 		Sizef size;
 
 		GlyphMetrics metrics;
+
+		/// \brief Glyph cache owning this glyph
+		GlyphCache *cache = nullptr;
+
+		/// \brief Rectangle allocated in the glyph atlas, including the border
+		Rect atlas_rect;
+
+		/// \brief True if the glyph owns atlas space and can be evicted
+		bool evictable = false;
+
+		/// \brief True while the glyph is rasterized in the background (only the metrics are valid)
+		bool pending = false;
+
+		/// \brief Position in the atlas least recently used list (only valid when evictable)
+		std::list<Font_TextureGlyph *>::iterator lru_position;
 	};
 
+	/// \brief Texture atlas shared by the glyph caches of a font family
+	class GlyphAtlas
+	{
+	public:
+		GlyphAtlas(const Size &texture_size);
+
+		/// \brief Marks a glyph as the most recently used
+		void touch(Font_TextureGlyph *glyph)
+		{
+			if (glyph->lru_position != lru.begin())
+				lru.splice(lru.begin(), lru, glyph->lru_position);
+		}
+
+		/// \brief Evicts least recently used glyphs until an image of the specified size fits within the budget
+		///
+		/// \return True if any glyphs were evicted
+		bool make_room(const Size &size);
+
+		/// \brief Starts tracking a glyph that owns atlas space
+		void add(Font_TextureGlyph *glyph);
+
+		/// \brief Stops tracking a glyph and frees its atlas space
+		void release(Font_TextureGlyph *glyph);
+
+		GlyphCacheStats stats() const;
+
+		TextureGroupPtr texture_group;
+		size_t budget = 0;	// In bytes. 0 = unbounded
+		bool async_rasterization = false;
+
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+		int glyphs = 0;
+
+	private:
+		static size_t bytes_used(const Size &size) { return (size_t)size.width * size.height * bytes_per_pixel; }
+
+		std::list<Font_TextureGlyph *> lru;	// Most recently used first
+		size_t glyph_bytes = 0;
+
+		static const int bytes_per_pixel = 4;
+	};
+
+	typedef std::shared_ptr<GlyphAtlas> GlyphAtlasPtr;
+
 	class GlyphCache
 	{
 	public:
@@ -91,12 +158,45 @@ namespace uicore
 		void insert_glyph(const CanvasPtr &canvas, unsigned int glyph, TextureGroupImage &sub_texture, const Pointf &offset, const Sizef &size, const GlyphMetrics &glyph_metrics);
 		void insert_glyph(const CanvasPtr &canvas, FontPixelBuffer &pb);
 
-		void set_texture_group(const TextureGroupPtr &new_texture_group);
+		/// \brief Rasterizes the glyphs of a text not yet cached and uploads them in one batch
+		void prewarm(const CanvasPtr &canvas, FontEngine *font_engine, const std::string &text);
+
+		void set_atlas(const GlyphAtlasPtr &new_atlas);
+
+		/// \brief Sets previously rasterized glyphs to use instead of rasterizing with the font engine
+		void set_snapshot(const GlyphSnapshotPtr &new_snapshot) { snapshot = new_snapshot; }
+
+		/// \brief Creates a snapshot of the rasterized glyphs in this cache
+		GlyphSnapshotPtr create_snapshot(FontEngine *font_engine) const;
+
+		/// \brief Removes a glyph from the cache and frees its atlas space
+		void evict_glyph(Font_TextureGlyph *glyph);
 
 	private:
-		std::vector<std::unique_ptr<Font_TextureGlyph>> glyph_list;
-		TextureGroupPtr texture_group;
+		Font_TextureGlyph *find_glyph(unsigned int glyph) const;
+		void add_glyph(std::unique_ptr<Font_TextureGlyph> font_glyph);
+
+		FontPixelBuffer rasterize_glyph(FontEngine *font_engine, unsigned int glyph) const;
+		void insert_glyphs(const CanvasPtr &canvas, std::vector<FontPixelBuffer> &pbs);
+		PixelBufferPtr allocate_glyph(const CanvasPtr &canvas, const FontPixelBuffer &pb, Font_TextureGlyph *font_glyph);
+
+		bool queue_glyph(const CanvasPtr &canvas, FontEngine *font_engine, unsigned int glyph);
+		void upload_completed(const CanvasPtr &canvas);
+		void add_waiting_window(const CanvasPtr &canvas);
+		void repaint_waiting_windows();
+
+		std::shared_ptr<AsyncGlyphSource> async_source;
+		bool async_unsupported = false;
+		std::vector<std::weak_ptr<DisplayWindow>> waiting_windows;	// Windows that drew pending glyphs
+
+		std::unordered_map<unsigned int, std::unique_ptr<Font_TextureGlyph>> glyph_list;
+		GlyphAtlasPtr atlas;
+		GlyphSnapshotPtr snapshot;
 
 		static const int glyph_border_size = 1;
+
+		// Direct lookup table for the most common code points, avoiding hashing for latin text
+		static const unsigned int dense_glyph_count = 256;
+		Font_TextureGlyph *dense_glyphs[dense_glyph_count] = {};
 	};
 }
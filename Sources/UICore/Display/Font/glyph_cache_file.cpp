@@ -0,0 +1,230 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "glyph_cache_file.h"
+#include "UICore/Core/IOData/file.h"
+#include <cstring>
+
+namespace uicore
+{
+	struct GlyphCacheFileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t section_count;
+	};
+
+	struct GlyphCacheFileSection
+	{
+		char font_hash[40];
+		float height;
+		float pixel_ratio;
+		int32_t weight;
+		int32_t style;
+		uint32_t render_flags;
+		uint32_t glyph_count;
+		uint64_t glyphs_offset;
+	};
+
+	struct GlyphCacheFileGlyph
+	{
+		uint32_t glyph;
+		uint32_t flags;
+		uint32_t width;
+		uint32_t height;
+		float offset_x, offset_y;
+		float size_width, size_height;
+		float bbox_x, bbox_y;
+		float bbox_width, bbox_height;
+		float advance_width, advance_height;
+		uint64_t pixels_offset;
+	};
+
+	static const char glyph_cache_file_magic[8] = { 'U', 'I', 'C', 'G', 'L', 'Y', 'P', 'H' };
+
+	// GlyphCacheFileSection::render_flags
+	static const uint32_t glyph_cache_file_subpixel = 1;
+	static const uint32_t glyph_cache_file_anti_alias = 2;
+
+	// GlyphCacheFileGlyph::flags
+	static const uint32_t glyph_cache_file_empty_buffer = 1;
+
+	std::vector<GlyphSnapshotPtr> GlyphCacheFile::load(const std::string &filename)
+	{
+		std::vector<GlyphSnapshotPtr> snapshots;
+		if (!File::exists(filename))
+			return snapshots;
+
+		DataBufferPtr file_data = File::read_all_bytes(filename);
+		const char *data = file_data->data();
+		uint64_t size = file_data->size();
+
+		if (size < sizeof(GlyphCacheFileHeader))
+			return snapshots;
+
+		auto header = reinterpret_cast<const GlyphCacheFileHeader *>(data);
+		if (memcmp(header->magic, glyph_cache_file_magic, sizeof(glyph_cache_file_magic)) != 0 || header->version != file_version)
+			return snapshots;
+
+		if (header->section_count > (size - sizeof(GlyphCacheFileHeader)) / sizeof(GlyphCacheFileSection))
+			return snapshots;
+
+		auto sections = reinterpret_cast<const GlyphCacheFileSection *>(data + sizeof(GlyphCacheFileHeader));
+		for (uint32_t section_index = 0; section_index < header->section_count; section_index++)
+		{
+			const GlyphCacheFileSection &section = sections[section_index];
+			if (section.glyphs_offset > size || section.glyph_count > (size - section.glyphs_offset) / sizeof(GlyphCacheFileGlyph))
+				return std::vector<GlyphSnapshotPtr>();
+
+			auto snapshot = std::make_shared<GlyphSnapshot>();
+			snapshot->key.font_hash = std::string(section.font_hash, sizeof(section.font_hash));
+			snapshot->key.height = section.height;
+			snapshot->key.pixel_ratio = section.pixel_ratio;
+			snapshot->key.weight = section.weight;
+			snapshot->key.style = section.style;
+			snapshot->key.subpixel = (section.render_flags & glyph_cache_file_subpixel) != 0;
+			snapshot->key.anti_alias = (section.render_flags & glyph_cache_file_anti_alias) != 0;
+			snapshot->file_data = file_data;
+
+			auto records = reinterpret_cast<const GlyphCacheFileGlyph *>(data + section.glyphs_offset);
+			for (uint32_t i = 0; i < section.glyph_count; i++)
+			{
+				const GlyphCacheFileGlyph &record = records[i];
+
+				FontPixelBuffer pb;
+				pb.glyph = record.glyph;
+				pb.empty_buffer = (record.flags & glyph_cache_file_empty_buffer) != 0;
+				pb.offset = Pointf(record.offset_x, record.offset_y);
+				pb.size = Sizef(record.size_width, record.size_height);
+				pb.metrics = GlyphMetrics(Pointf(record.bbox_x, record.bbox_y), Sizef(record.bbox_width, record.bbox_height), Sizef(record.advance_width, record.advance_height));
+
+				if (!pb.empty_buffer)
+				{
+					uint64_t pixels_size = uint64_t(record.width) * record.height * 4;
+					if (record.width == 0 || record.height == 0 || record.pixels_offset > size || pixels_size > size - record.pixels_offset)
+						return std::vector<GlyphSnapshotPtr>();
+
+					// Reference the image in the file data instead of copying it
+					pb.buffer = PixelBuffer::create(record.width, record.height, tf_rgba8, data + record.pixels_offset, true);
+					pb.buffer_rect = Rect(0, 0, record.width, record.height);
+				}
+
+				snapshot->glyphs[pb.glyph] = pb;
+			}
+
+			snapshots.push_back(snapshot);
+		}
+
+		return snapshots;
+	}
+
+	void GlyphCacheFile::save(const std::string &filename, const std::vector<GlyphSnapshotPtr> &snapshots)
+	{
+		// Calculate the file layout: header, sections, glyph records and then the glyph images
+		uint64_t glyph_count = 0;
+		for (const auto &snapshot : snapshots)
+			glyph_count += snapshot->glyphs.size();
+
+		uint64_t records_offset = sizeof(GlyphCacheFileHeader) + snapshots.size() * sizeof(GlyphCacheFileSection);
+		uint64_t pixels_offset = records_offset + glyph_count * sizeof(GlyphCacheFileGlyph);
+
+		uint64_t file_size = pixels_offset;
+		for (const auto &snapshot : snapshots)
+		{
+			for (const auto &it : snapshot->glyphs)
+			{
+				const FontPixelBuffer &pb = it.second;
+				if (!pb.empty_buffer)
+					file_size += uint64_t(pb.buffer_rect.width()) * pb.buffer_rect.height() * 4;
+			}
+		}
+
+		DataBufferPtr file_data = DataBuffer::create(file_size);
+		char *data = file_data->data();
+		memset(data, 0, file_size);
+
+		auto header = reinterpret_cast<GlyphCacheFileHeader *>(data);
+		memcpy(header->magic, glyph_cache_file_magic, sizeof(glyph_cache_file_magic));
+		header->version = file_version;
+		header->section_count = snapshots.size();
+
+		auto sections = reinterpret_cast<GlyphCacheFileSection *>(data + sizeof(GlyphCacheFileHeader));
+		auto records = reinterpret_cast<GlyphCacheFileGlyph *>(data + records_offset);
+		uint64_t next_pixels = pixels_offset;
+
+		for (size_t section_index = 0; section_index < snapshots.size(); section_index++)
+		{
+			const GlyphSnapshot &snapshot = *snapshots[section_index];
+			GlyphCacheFileSection &section = sections[section_index];
+			memcpy(section.font_hash, snapshot.key.font_hash.data(), std::min(snapshot.key.font_hash.size(), sizeof(section.font_hash)));
+			section.height = snapshot.key.height;
+			section.pixel_ratio = snapshot.key.pixel_ratio;
+			section.weight = snapshot.key.weight;
+			section.style = snapshot.key.style;
+			section.render_flags = (snapshot.key.subpixel ? glyph_cache_file_subpixel : 0) | (snapshot.key.anti_alias ? glyph_cache_file_anti_alias : 0);
+			section.glyph_count = snapshot.glyphs.size();
+			section.glyphs_offset = reinterpret_cast<char *>(records) - data;
+
+			for (const auto &it : snapshot.glyphs)
+			{
+				const FontPixelBuffer &pb = it.second;
+				GlyphCacheFileGlyph &record = *(records++);
+				record.glyph = pb.glyph;
+				record.flags = pb.empty_buffer ? glyph_cache_file_empty_buffer : 0;
+				record.offset_x = pb.offset.x;
+				record.offset_y = pb.offset.y;
+				record.size_width = pb.size.width;
+				record.size_height = pb.size.height;
+				record.bbox_x = pb.metrics.bbox_offset.x;
+				record.bbox_y = pb.metrics.bbox_offset.y;
+				record.bbox_width = pb.metrics.bbox_size.width;
+				record.bbox_height = pb.metrics.bbox_size.height;
+				record.advance_width = pb.metrics.advance.width;
+				record.advance_height = pb.metrics.advance.height;
+
+				if (!pb.empty_buffer)
+				{
+					PixelBufferPtr buffer = pb.buffer->format() == tf_rgba8 ? pb.buffer : pb.buffer->to_format(tf_rgba8);
+					record.width = pb.buffer_rect.width();
+					record.height = pb.buffer_rect.height();
+					record.pixels_offset = next_pixels;
+
+					for (int y = 0; y < pb.buffer_rect.height(); y++)
+					{
+						const uint32_t *src = buffer->line_uint32(pb.buffer_rect.top + y) + pb.buffer_rect.left;
+						memcpy(data + next_pixels, src, record.width * 4);
+						next_pixels += record.width * 4;
+					}
+				}
+			}
+		}
+
+		File::write_all_bytes(filename, file_data);
+	}
+}
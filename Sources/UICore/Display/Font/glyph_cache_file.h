@@ -0,0 +1,88 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "FontEngine/font_engine.h"
+#include "UICore/Core/System/databuffer.h"
+
+namespace uicore
+{
+	/// \brief Identifies the font engine a set of rasterized glyphs was created with
+	class GlyphSnapshotKey
+	{
+	public:
+		std::string font_hash;	// SHA-1 of the font file
+		float height = 0.0f;
+		float pixel_ratio = 1.0f;
+		int weight = 0;
+		int style = 0;
+		bool subpixel = false;
+		bool anti_alias = false;
+
+		bool operator==(const GlyphSnapshotKey &other) const
+		{
+			return font_hash == other.font_hash && height == other.height && pixel_ratio == other.pixel_ratio &&
+				weight == other.weight && style == other.style && subpixel == other.subpixel && anti_alias == other.anti_alias;
+		}
+	};
+
+	/// \brief Rasterized glyphs of one font engine
+	class GlyphSnapshot
+	{
+	public:
+		GlyphSnapshotKey key;
+		std::unordered_map<unsigned int, FontPixelBuffer> glyphs;
+		DataBufferPtr file_data;	// Glyph images loaded from a file refer to this data
+	};
+
+	typedef std::shared_ptr<GlyphSnapshot> GlyphSnapshotPtr;
+
+	/// \brief Reads and writes glyph cache files
+	///
+	/// All records have a fixed size and the glyph images are stored as rgba8 rows without padding,
+	/// so a loaded file is used in place instead of being unpacked.
+	class GlyphCacheFile
+	{
+	public:
+		/// \brief Loads the snapshots in a glyph cache file
+		///
+		/// Returns no snapshots if the file is missing, was written by another version or is damaged.
+		static std::vector<GlyphSnapshotPtr> load(const std::string &filename);
+
+		/// \brief Saves snapshots to a glyph cache file
+		static void save(const std::string &filename, const std::vector<GlyphSnapshotPtr> &snapshots);
+
+	private:
+		static const uint32_t file_version = 1;
+	};
+}
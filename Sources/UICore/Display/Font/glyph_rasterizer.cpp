@@ -0,0 +1,160 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "glyph_rasterizer.h"
+#include "UICore/Core/System/system.h"
+#include "UICore/Display/System/run_loop.h"
+
+namespace uicore
+{
+	GlyphRasterizer &GlyphRasterizer::instance()
+	{
+		static GlyphRasterizer rasterizer;
+		return rasterizer;
+	}
+
+	GlyphRasterizer::GlyphRasterizer()
+	{
+		// Leave a core for the UI thread
+		int num_threads = std::max(std::min(System::num_cores() - 1, max_threads), 1);
+		for (int i = 0; i < num_threads; i++)
+			threads.push_back(std::thread(&GlyphRasterizer::worker_main, this));
+	}
+
+	GlyphRasterizer::~GlyphRasterizer()
+	{
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			stop_flag = true;
+			jobs.clear();
+		}
+		worker_event.notify_all();
+		for (auto &thread : threads)
+			thread.join();
+	}
+
+	void GlyphRasterizer::queue(std::function<void()> job)
+	{
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			jobs.push_back(std::move(job));
+		}
+		worker_event.notify_one();
+	}
+
+	void GlyphRasterizer::worker_main()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> mutex_lock(mutex);
+				worker_event.wait(mutex_lock, [&]() -> bool { return stop_flag || !jobs.empty(); });
+				if (stop_flag)
+					break;
+
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+
+	AsyncGlyphSource::AsyncGlyphSource(std::unique_ptr<FontEngine> prototype) : prototype(std::move(prototype)), completed_flag(false)
+	{
+	}
+
+	void AsyncGlyphSource::queue(unsigned int glyph)
+	{
+		auto self = shared_from_this();
+		GlyphRasterizer::instance().queue([self, glyph]() { self->rasterize(glyph); });
+	}
+
+	std::vector<AsyncGlyph> AsyncGlyphSource::take_completed()
+	{
+		std::unique_lock<std::mutex> mutex_lock(mutex);
+		completed_flag.store(false, std::memory_order_release);
+		std::vector<AsyncGlyph> glyphs;
+		glyphs.swap(completed);
+		return glyphs;
+	}
+
+	std::unique_ptr<FontEngine> AsyncGlyphSource::acquire_engine()
+	{
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			if (!idle_engines.empty())
+			{
+				std::unique_ptr<FontEngine> engine = std::move(idle_engines.back());
+				idle_engines.pop_back();
+				return engine;
+			}
+		}
+		return prototype->create_thread_copy();
+	}
+
+	void AsyncGlyphSource::rasterize(unsigned int glyph)
+	{
+		FontPixelBuffer pb;
+		std::unique_ptr<FontEngine> engine;
+		try
+		{
+			engine = acquire_engine();
+			if (engine)
+				pb = engine->get_font_glyph(glyph);
+		}
+		catch (...)
+		{
+			pb = FontPixelBuffer();
+		}
+
+		bool was_completed;
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			if (engine)
+				idle_engines.push_back(std::move(engine));
+			completed.push_back(AsyncGlyph(glyph, std::move(pb)));
+			was_completed = completed_flag.exchange(true, std::memory_order_acq_rel);
+		}
+
+		// Notify the UI thread once per batch of completed glyphs
+		if (!was_completed)
+		{
+			std::weak_ptr<AsyncGlyphSource> weak_self = shared_from_this();
+			RunLoop::main_thread_async([weak_self]()
+			{
+				auto self = weak_self.lock();
+				if (self && self->func_completed)
+					self->func_completed();
+			});
+		}
+	}
+}
@@ -0,0 +1,107 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include "FontEngine/font_engine.h"
+
+namespace uicore
+{
+	/// \brief Worker threads rasterizing glyphs in the background
+	class GlyphRasterizer
+	{
+	public:
+		static GlyphRasterizer &instance();
+
+		/// \brief Queues a job to be run on one of the worker threads
+		void queue(std::function<void()> job);
+
+	private:
+		GlyphRasterizer();
+		~GlyphRasterizer();
+		void worker_main();
+
+		std::mutex mutex;
+		std::condition_variable worker_event;
+		std::deque<std::function<void()>> jobs;
+		bool stop_flag = false;
+		std::vector<std::thread> threads;
+
+		static const int max_threads = 4;
+	};
+
+	/// \brief Rasterized glyph returned by an AsyncGlyphSource
+	class AsyncGlyph
+	{
+	public:
+		AsyncGlyph(unsigned int glyph, FontPixelBuffer pb) : glyph(glyph), pb(std::move(pb)) { }
+
+		unsigned int glyph;
+		FontPixelBuffer pb;	// pb.glyph is 0 if the glyph could not be rasterized
+	};
+
+	/// \brief Rasterizes glyphs of a font engine on the glyph rasterizer threads
+	///
+	/// Each worker uses its own font engine copy, so the font engine used on the UI thread is never shared.
+	class AsyncGlyphSource : public std::enable_shared_from_this<AsyncGlyphSource>
+	{
+	public:
+		AsyncGlyphSource(std::unique_ptr<FontEngine> prototype);
+
+		/// \brief Queues a glyph for rasterization (UI thread)
+		void queue(unsigned int glyph);
+
+		/// \brief Returns true if rasterized glyphs are waiting to be uploaded
+		bool has_completed() const { return completed_flag.load(std::memory_order_acquire); }
+
+		/// \brief Takes all rasterized glyphs (UI thread)
+		std::vector<AsyncGlyph> take_completed();
+
+		/// \brief Called on the UI thread when rasterized glyphs become available
+		std::function<void()> func_completed;
+
+	private:
+		void rasterize(unsigned int glyph);
+		std::unique_ptr<FontEngine> acquire_engine();
+
+		std::unique_ptr<FontEngine> prototype;
+
+		std::mutex mutex;
+		std::vector<std::unique_ptr<FontEngine>> idle_engines;
+		std::vector<AsyncGlyph> completed;
+		std::atomic<bool> completed_flag;
+	};
+}
@@ -0,0 +1,81 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "text_run_cache.h"
+#include <functional>
+
+namespace uicore
+{
+	TextRun *TextRunCache::get(const std::string &text, float line_spacing, float font_height, float font_ascent)
+	{
+		if (text.length() > max_text_length)
+			return nullptr;
+
+		size_t key = hash(text, line_spacing, font_height, font_ascent);
+		auto it = run_map.find(key);
+		if (it != run_map.end())
+		{
+			RunList::iterator run = it->second;
+			if (run->text == text && run->line_spacing == line_spacing && run->font_height == font_height && run->font_ascent == font_ascent)
+			{
+				if (run != runs.begin())
+					runs.splice(runs.begin(), runs, run);
+				return &*run;
+			}
+
+			// Hash collision. The newer text takes over the slot
+			runs.erase(run);
+			run_map.erase(it);
+		}
+
+		if (runs.size() >= max_runs)
+		{
+			const TextRun &oldest = runs.back();
+			run_map.erase(hash(oldest.text, oldest.line_spacing, oldest.font_height, oldest.font_ascent));
+			runs.pop_back();
+		}
+
+		runs.emplace_front();
+		TextRun &run = runs.front();
+		run.text = text;
+		run.line_spacing = line_spacing;
+		run.font_height = font_height;
+		run.font_ascent = font_ascent;
+		run_map[key] = runs.begin();
+		return &run;
+	}
+
+	size_t TextRunCache::hash(const std::string &text, float line_spacing, float font_height, float font_ascent)
+	{
+		size_t seed = std::hash<std::string>()(text);
+		for (float value : { line_spacing, font_height, font_ascent })
+			seed ^= std::hash<float>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		return seed;
+	}
+}
@@ -0,0 +1,75 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Display/Font/glyph_metrics.h"
+#include "UICore/Core/Math/rect.h"
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace uicore
+{
+	/// \brief Measurements of a text with a specific font
+	class TextRun
+	{
+	public:
+		std::string text;
+		float line_spacing = 0.0f;
+		float font_height = 0.0f;
+		float font_ascent = 0.0f;
+
+		bool has_metrics = false;
+		GlyphMetrics metrics;	// Font::measure_text result
+
+		bool has_character_rects = false;
+		std::vector<Rectf> character_rects;	// Font::character_indices result
+	};
+
+	/// \brief Bounded cache of measured texts for a font engine
+	class TextRunCache
+	{
+	public:
+		/// \brief Returns the run for a text, creating an unmeasured one if it is not cached
+		///
+		/// \return Null if the text is too long to be worth caching
+		TextRun *get(const std::string &text, float line_spacing, float font_height, float font_ascent);
+
+	private:
+		static size_t hash(const std::string &text, float line_spacing, float font_height, float font_ascent);
+
+		typedef std::list<TextRun> RunList;
+		RunList runs;	// Most recently used first
+		std::unordered_map<size_t, RunList::iterator> run_map;
+
+		static const size_t max_runs = 512;
+		static const size_t max_text_length = 1024;
+	};
+}
@@ -37,7 +37,9 @@
 #include "UICore/Display/Render/depth_stencil_state_description.h"
 #include "UICore/Core/Math/mat4.h"
 #include "UICore/Core/Signals/signal.h"
+#include "UICore/Core/System/exception.h"
 #include "UICore/Display/Render/staging_texture.h"
+#include "UICore/Display/Render/vertex_ring_buffer.h"
 
 namespace uicore
 {
@@ -63,8 +65,21 @@ namespace uicore
 	class BlendStateDescription;
 	class DepthStencilStateDescription;
 	class StagingTexture;
+	class TextureUploadQueue;
 	enum class ShaderType;
 
+	/// \brief Marks a point in the command stream and tells when the GPU has passed it
+	class GraphicFence
+	{
+	public:
+		virtual ~GraphicFence() { }
+
+		/// \brief Returns true once all commands issued before the fence was created have completed. Never waits.
+		virtual bool is_signaled() = 0;
+	};
+
+	typedef std::shared_ptr<GraphicFence> GraphicFencePtr;
+
 	class GraphicContextImpl : public GraphicContext
 	{
 	public:
@@ -100,6 +115,27 @@ namespace uicore
 
 		virtual int max_attributes() = 0;
 
+		/// \brief Starts copying pixels of the read frame buffer into a staging texture created with StagingDirection::from_gpu
+		///
+		/// Rows are copied in frame buffer memory order, so for a texture frame buffer the first row of the texture comes first.
+		/// The copy may still be in progress when this returns; locking the staging texture waits for it to finish.
+		/// \return False if the target cannot copy into a staging texture, in which case nothing was copied
+		virtual bool read_pixels_async(const Rect &rect, const StagingTexturePtr &dest) { return false; }
+
+		/// \brief Creates a vertex ring buffer of the given size, or null if the target cannot write to buffers in use by the GPU
+		virtual VertexRingBufferPtr create_vertex_ring_buffer(int size) { return VertexRingBufferPtr(); }
+
+		/// \brief Creates a fence after the commands issued so far, or null if the target completes all commands immediately
+		virtual GraphicFencePtr create_fence() { return GraphicFencePtr(); }
+
+		/// \brief Draws indexed primitives with base_vertex added to every index
+		virtual void draw_primitives_elements_base_vertex(PrimitivesType type, int count, const ElementArrayBufferPtr &element_array, VertexAttributeDataType indices_type, size_t offset, int base_vertex)
+		{
+			if (base_vertex != 0)
+				throw Exception("Base vertex not supported by this graphic context");
+			draw_primitives_elements(type, count, element_array, indices_type, offset);
+		}
+
 		void set_viewport(const Rectf &rect, TextureImageYAxis y_axis) override
 		{
 			Rectf rect2 = rect;
@@ -168,6 +204,15 @@ namespace uicore
 			return _default_depth_stencil_state;
 		}
 
+		const GraphicContextStateStats &state_stats() const override { return _state_stats; }
+		void reset_state_stats() override { _state_stats = GraphicContextStateStats(); }
+
+		int upload_budget() const override { return _upload_budget; }
+		void set_upload_budget(int bytes_per_frame) override { _upload_budget = bytes_per_frame; }
+
+		/// \brief Uploads images decoded by Image::create_async. Created by the first such image
+		std::shared_ptr<TextureUploadQueue> upload_queue;
+
 		void set_default_state()
 		{
 			set_rasterizer_state(default_rasterizer_state());
@@ -177,10 +222,14 @@ namespace uicore
 			resize_slot = sig_window_resized().connect([this](const Size &window_size) { if (!write_frame_buffer()) set_viewport(-1, size(), y_axis_top_down); });
 		}
 
+	protected:
+		GraphicContextStateStats _state_stats;
+
 	private:
 		RasterizerStatePtr _default_rasterizer_state;
 		BlendStatePtr _default_blend_state;
 		DepthStencilStatePtr _default_depth_stencil_state;
+		int _upload_budget = 4 * 1024 * 1024;
 
 		Slot resize_slot;
 	};
@@ -0,0 +1,300 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "texture_upload_queue.h"
+#include "UICore/Core/System/system.h"
+#include "UICore/Display/System/run_loop.h"
+#include "UICore/Display/Window/display_window.h"
+#include "UICore/Display/ImageFormats/image_file.h"
+#include <algorithm>
+
+namespace uicore
+{
+	TextureDecoder &TextureDecoder::instance()
+	{
+		static TextureDecoder decoder;
+		return decoder;
+	}
+
+	TextureDecoder::TextureDecoder()
+	{
+		// Leave a core for the UI thread
+		int num_threads = std::max(std::min(System::num_cores() - 1, max_threads), 1);
+		for (int i = 0; i < num_threads; i++)
+			threads.push_back(std::thread(&TextureDecoder::worker_main, this));
+	}
+
+	TextureDecoder::~TextureDecoder()
+	{
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			stop_flag = true;
+			jobs.clear();
+		}
+		worker_event.notify_all();
+		for (auto &thread : threads)
+			thread.join();
+	}
+
+	void TextureDecoder::queue(std::function<void()> job)
+	{
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			jobs.push_back(std::move(job));
+		}
+		worker_event.notify_one();
+	}
+
+	void TextureDecoder::worker_main()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> mutex_lock(mutex);
+				worker_event.wait(mutex_lock, [&]() -> bool { return stop_flag || !jobs.empty(); });
+				if (stop_flag)
+					break;
+
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<TextureUploadQueue> TextureUploadQueue::get(const GraphicContextPtr &gc)
+	{
+		GraphicContextImpl *gc_impl = static_cast<GraphicContextImpl*>(gc.get());
+		if (!gc_impl->upload_queue)
+			gc_impl->upload_queue = std::make_shared<TextureUploadQueue>();
+		return gc_impl->upload_queue;
+	}
+
+	std::shared_ptr<AsyncTexture> TextureUploadQueue::load(const std::string &filename, const ImageImportDescription &import_desc)
+	{
+		auto texture = std::make_shared<AsyncTexture>();
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			num_decoding++;
+		}
+
+		std::weak_ptr<TextureUploadQueue> weak_self = shared_from_this();
+		std::weak_ptr<AsyncTexture> target = texture;
+		TextureDecoder::instance().queue([weak_self, target, filename, import_desc]()
+		{
+			auto self = weak_self.lock();
+			if (self)
+				self->decode(target, filename, import_desc);
+		});
+		return texture;
+	}
+
+	void TextureUploadQueue::decode(const std::weak_ptr<AsyncTexture> &target, const std::string &filename, const ImageImportDescription &import_desc)
+	{
+		DecodedImage image;
+		image.target = target;
+		image.srgb = import_desc.is_srgb();
+
+		// Images no longer in use are not worth decoding
+		if (!target.expired())
+		{
+			try
+			{
+				PixelBufferPtr pixels = ImageFile::load(filename, std::string());
+				pixels = import_desc.process(pixels);
+
+				// Convert here so the render thread only has to copy the pixels into the staging texture
+				if (pixels->format() != tf_rgba8 || pixels->pitch() != pixels->width() * 4)
+					pixels = pixels->to_format(tf_rgba8);
+
+				image.pixels = pixels;
+			}
+			catch (...)
+			{
+				image.pixels = PixelBufferPtr();
+			}
+		}
+
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			decoded.push_back(std::move(image));
+			num_decoding--;
+		}
+		notify_windows();
+	}
+
+	void TextureUploadQueue::process(const GraphicContextPtr &gc, const DisplayWindowPtr &window)
+	{
+		int budget = gc->upload_budget();
+		int bytes_uploaded = 0;
+		while (true)
+		{
+			DecodedImage image;
+			{
+				std::unique_lock<std::mutex> mutex_lock(mutex);
+				if (decoded.empty())
+					break;
+
+				if (decoded.front().target.expired())
+				{
+					decoded.pop_front();
+					continue;
+				}
+
+				// Always upload at least one image per frame, even if it alone exceeds the budget
+				int size = decoded.front().pixels ? decoded.front().pixels->data_size() : 0;
+				if (bytes_uploaded > 0 && bytes_uploaded + size > budget)
+					break;
+				bytes_uploaded += size;
+
+				image = std::move(decoded.front());
+				decoded.pop_front();
+			}
+			start_upload(gc, image);
+		}
+
+		bool textures_completed = false;
+		std::vector<std::shared_ptr<AsyncTexture>> completed;
+		for (size_t i = 0; i < uploads.size();)
+		{
+			Upload &upload = uploads[i];
+			if (!upload.fence || upload.fence->is_signaled())
+			{
+				auto target = upload.target.lock();
+				if (target)
+				{
+					target->texture = upload.texture;
+					target->ready = true;
+					completed.push_back(target);
+				}
+				uploads.erase(uploads.begin() + i);
+				textures_completed = true;
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		// A repaint of the window does not redraw anything by itself. The users of the textures mark their views as changed
+		for (const auto &target : completed)
+			target->sig_ready();
+
+		bool uploads_left = !uploads.empty();
+		{
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			uploads_left = uploads_left || !decoded.empty();
+			bool work_left = uploads_left || num_decoding > 0;
+			if (work_left && window)
+			{
+				auto it = std::find_if(waiting_windows.begin(), waiting_windows.end(), [&](const std::weak_ptr<DisplayWindow> &waiting) { return waiting.lock() == window; });
+				if (it == waiting_windows.end())
+					waiting_windows.push_back(window);
+			}
+		}
+
+		// Finished decodes notify by themselves. Uploads need another frame to continue or to check their fences.
+		if (textures_completed || uploads_left)
+			notify_windows();
+	}
+
+	void TextureUploadQueue::start_upload(const GraphicContextPtr &gc, DecodedImage &image)
+	{
+		auto target = image.target.lock();
+		if (!target)
+			return;
+
+		Upload upload;
+		upload.target = target;
+		if (image.pixels)
+		{
+			try
+			{
+				const PixelBufferPtr &pixels = image.pixels;
+				upload.staging = StagingTexture::create(gc, pixels->width(), pixels->height(), StagingDirection::to_gpu, tf_rgba8, pixels->data(), usage_stream_draw);
+				upload.texture = Texture2D::create(gc, pixels->width(), pixels->height(), image.srgb ? tf_srgb8_alpha8 : tf_rgba8);
+
+				if (target->set_wrap_mode)
+					upload.texture->set_wrap_mode(target->wrap_s, target->wrap_t);
+				if (target->set_filter)
+				{
+					upload.texture->set_mag_filter(target->linear_filter ? filter_linear : filter_nearest);
+					upload.texture->set_min_filter(target->linear_filter ? filter_linear : filter_nearest);
+				}
+
+				upload.texture->set_subimage(gc, 0, 0, upload.staging, Rect(pixels->size()));
+				upload.fence = static_cast<GraphicContextImpl*>(gc.get())->create_fence();
+			}
+			catch (...)
+			{
+				upload.texture = Texture2DPtr();
+				upload.fence = GraphicFencePtr();
+			}
+		}
+		uploads.push_back(std::move(upload));
+	}
+
+	void TextureUploadQueue::notify_windows()
+	{
+		{
+			// Canvases without a window are not repainted, they pick up new textures at their next begin
+			std::unique_lock<std::mutex> mutex_lock(mutex);
+			if (notify_pending || waiting_windows.empty())
+				return;
+			notify_pending = true;
+		}
+
+		// Repaint after the current frame, as this may be called while a window paints or from a worker thread
+		std::weak_ptr<TextureUploadQueue> weak_self = shared_from_this();
+		RunLoop::main_thread_async([weak_self]()
+		{
+			auto self = weak_self.lock();
+			if (!self)
+				return;
+
+			std::vector<std::weak_ptr<DisplayWindow>> windows;
+			{
+				std::unique_lock<std::mutex> mutex_lock(self->mutex);
+				self->notify_pending = false;
+				windows.swap(self->waiting_windows);
+			}
+
+			for (auto &weak_window : windows)
+			{
+				auto window = weak_window.lock();
+				if (window)
+					window->request_repaint();
+			}
+		});
+	}
+}
@@ -0,0 +1,141 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+#include "UICore/Display/Render/texture_2d.h"
+#include "UICore/Display/Image/image_import_description.h"
+#include "UICore/Core/Signals/signal.h"
+#include "graphic_context_impl.h"
+
+namespace uicore
+{
+	class DisplayWindow;
+	typedef std::shared_ptr<DisplayWindow> DisplayWindowPtr;
+
+	/// \brief Worker threads decoding image files in the background
+	class TextureDecoder
+	{
+	public:
+		static TextureDecoder &instance();
+
+		/// \brief Queues a job to be run on one of the worker threads
+		void queue(std::function<void()> job);
+
+	private:
+		TextureDecoder();
+		~TextureDecoder();
+		void worker_main();
+
+		std::mutex mutex;
+		std::condition_variable worker_event;
+		std::deque<std::function<void()>> jobs;
+		bool stop_flag = false;
+		std::vector<std::thread> threads;
+
+		static const int max_threads = 2;
+	};
+
+	/// \brief Texture loaded by a TextureUploadQueue
+	///
+	/// Only accessed on the render thread.
+	class AsyncTexture
+	{
+	public:
+		/// \brief True once the texture can be drawn, or once loading failed
+		bool ready = false;
+
+		/// \brief The uploaded texture. Null until ready, or if the image could not be loaded
+		Texture2DPtr texture;
+
+		/// \brief Texture settings requested before the texture existed
+		bool set_wrap_mode = false;
+		TextureWrapMode wrap_s = wrap_clamp_to_edge;
+		TextureWrapMode wrap_t = wrap_clamp_to_edge;
+		bool set_filter = false;
+		bool linear_filter = true;
+
+		/// \brief Emitted when ready becomes true, so that users of the texture can be drawn and laid out again
+		Signal<void()> sig_ready;
+	};
+
+	/// \brief Decodes image files on worker threads and uploads them through staging textures a few at a time
+	///
+	/// The render thread uploads at most GraphicContext::upload_budget() bytes per frame. A texture only becomes ready once
+	/// the GPU has passed a fence inserted after its upload, so drawing it never waits for the transfer.
+	class TextureUploadQueue : public std::enable_shared_from_this<TextureUploadQueue>
+	{
+	public:
+		/// \brief Returns the upload queue of a graphic context, creating it if needed
+		static std::shared_ptr<TextureUploadQueue> get(const GraphicContextPtr &gc);
+
+		/// \brief Starts decoding an image file on a worker thread
+		std::shared_ptr<AsyncTexture> load(const std::string &filename, const ImageImportDescription &import_desc);
+
+		/// \brief Completes finished uploads and starts new ones within the budget. Called once per frame by the canvas
+		///
+		/// \param window Window being rendered. It is repainted when more textures become ready
+		void process(const GraphicContextPtr &gc, const DisplayWindowPtr &window);
+
+	private:
+		struct DecodedImage
+		{
+			std::weak_ptr<AsyncTexture> target;
+			PixelBufferPtr pixels;	// Null if the image could not be loaded
+			bool srgb = false;
+		};
+
+		struct Upload
+		{
+			std::weak_ptr<AsyncTexture> target;
+			Texture2DPtr texture;
+			StagingTexturePtr staging;
+			GraphicFencePtr fence;
+		};
+
+		void decode(const std::weak_ptr<AsyncTexture> &target, const std::string &filename, const ImageImportDescription &import_desc);
+		void start_upload(const GraphicContextPtr &gc, DecodedImage &image);
+		void notify_windows();
+
+		std::mutex mutex;
+		std::deque<DecodedImage> decoded;
+		int num_decoding = 0;
+		bool notify_pending = false;
+		std::vector<std::weak_ptr<DisplayWindow>> waiting_windows;	// Windows to repaint when loading progresses
+
+		std::vector<Upload> uploads;
+	};
+}
@@ -0,0 +1,63 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include "UICore/Display/Render/vertex_array_buffer.h"
+#include "UICore/Display/Render/graphic_context.h"
+
+namespace uicore
+{
+	/// \brief Streams vertices through one large vertex buffer that is written while the GPU still reads earlier parts of it
+	///
+	/// Writes advance through the buffer and wrap around at the end. Ranges still in use by the GPU are protected by fences,
+	/// so a write only waits when it catches up with a draw that has not finished yet.
+	class VertexRingBuffer
+	{
+	public:
+		virtual ~VertexRingBuffer() { }
+
+		/// \brief The vertex buffer the written ranges belong to
+		virtual const VertexArrayBufferPtr &buffer() const = 0;
+
+		/// \brief Reserves up to max_size bytes of GPU visible memory
+		///
+		/// \param alignment Returned offset is a multiple of this, so that offset / alignment can be used as the first vertex of a draw
+		/// \param out_offset Offset of the reserved range in buffer()
+		/// \return Pointer to write the vertices to. Only valid until end_write is called
+		virtual void *begin_write(const GraphicContextPtr &gc, int max_size, int alignment, int &out_offset) = 0;
+
+		/// \brief Ends the write started by begin_write, keeping the first used_size bytes for drawing
+		///
+		/// Draw calls reading the range must be issued after this call.
+		virtual void end_write(const GraphicContextPtr &gc, int used_size) = 0;
+	};
+
+	typedef std::shared_ptr<VertexRingBuffer> VertexRingBufferPtr;
+}
@@ -219,6 +219,9 @@ namespace uicore
 			backing_flip(interval);
 		}
 
+		// Platforms that can tell which frame the back buffer holds override this
+		int back_buffer_age() override { return 0; }
+
 	private:
 		Signal<void()> _sig_lost_focus;
 		Signal<void()> _sig_got_focus;
@@ -80,6 +80,24 @@ namespace uicore
 		glBindBuffer(target, last_buffer);
 	}
 
+	void GL3BufferObject::create_storage(int new_size, GLbitfield storage_flags, GLenum new_binding, GLenum new_target)
+	{
+		throw_if_disposed();
+
+		binding = new_binding;
+		target = new_target;
+		size = new_size;
+
+		OpenGL::set_active();
+
+		GLint last_buffer = 0;
+		if (binding)
+			glGetIntegerv(binding, &last_buffer);
+		glBindBuffer(target, handle);
+		glBufferStorage(target, size, nullptr, storage_flags);
+		glBindBuffer(target, last_buffer);
+	}
+
 	void *GL3BufferObject::get_data()
 	{
 		if (data_ptr == nullptr)
@@ -47,6 +47,9 @@ namespace uicore
 		~GL3BufferObject();
 		void create(const void *data, int size, BufferUsage usage, GLenum new_binding, GLenum new_target);
 
+		/// \brief Creates immutable storage with explicit glBufferStorage flags (requires GL_ARB_buffer_storage)
+		void create_storage(int size, GLbitfield storage_flags, GLenum new_binding, GLenum new_target);
+
 		void *get_data();
 		const void *get_data() const;
 
@@ -0,0 +1,76 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "gl3_fence.h"
+#include "UICore/GL/opengl_wrap.h"
+
+namespace uicore
+{
+	GL3Fence::GL3Fence()
+	{
+		OpenGL::set_active();
+		sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	GL3Fence::~GL3Fence()
+	{
+		dispose();
+	}
+
+	bool GL3Fence::is_supported()
+	{
+		return glFenceSync && glClientWaitSync && glDeleteSync;
+	}
+
+	bool GL3Fence::is_signaled()
+	{
+		if (!sync)
+			return true;
+
+		OpenGL::set_active();
+
+		// A zero timeout only polls. The flush makes sure the fence reaches the GPU so it eventually signals.
+		GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+		{
+			glDeleteSync(sync);
+			sync = nullptr;
+			return true;
+		}
+		return false;
+	}
+
+	void GL3Fence::on_dispose()
+	{
+		if (sync && OpenGL::set_active())
+			glDeleteSync(sync);
+		sync = nullptr;
+	}
+}
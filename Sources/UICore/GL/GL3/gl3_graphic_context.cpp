@@ -46,6 +46,8 @@
 #include "gl3_staging_buffer.h"
 #include "gl3_staging_texture.h"
 #include "gl3_primitives_array.h"
+#include "gl3_vertex_ring_buffer.h"
+#include "gl3_fence.h"
 #include "UICore/Core/System/databuffer.h"
 #include "UICore/Core/Math/cl_math.h"
 #include "UICore/Core/Math/vec3.h"
@@ -456,6 +458,8 @@ namespace uicore
 				OpenGL::set_active(this);
 				selected_rasterizer_state.apply();
 				scissor_enabled = gl3_state->desc.enable_scissor();
+				if (!scissor_enabled)
+					scissor_test_enabled = false;
 			}
 		}
 		else
@@ -468,12 +472,21 @@ namespace uicore
 	{
 		if (state)
 		{
+			if (state == bound_blend_state && blend_color == bound_blend_color)
+			{
+				_state_stats.blend_states_elided++;
+				return;
+			}
+
 			OpenGLBlendState *gl3_state = static_cast<OpenGLBlendState*>(state.get());
 			if (gl3_state)
 			{
 				selected_blend_state.set(gl3_state->desc, blend_color);
 				OpenGL::set_active(this);
 				selected_blend_state.apply();
+				bound_blend_state = state;
+				bound_blend_color = blend_color;
+				_state_stats.blend_states++;
 			}
 		}
 		else
@@ -526,6 +539,49 @@ namespace uicore
 		return pbuf;
 	}
 
+	bool GL3GraphicContext::read_pixels_async(const Rect &rect, const StagingTexturePtr &dest)
+	{
+		TextureFormat_GL tf = OpenGL::textureformat(dest->format());
+		if (!tf.valid)
+			throw Exception("Unsupported texture format passed to GraphicContext::read_pixels_async");
+
+		GL3StagingTexture *staging = dynamic_cast<GL3StagingTexture*>(dest.get());
+		if (!staging || staging->get_target() != GL_PIXEL_PACK_BUFFER)
+			throw Exception("Staging texture must be created with StagingDirection::from_gpu");
+
+		OpenGL::set_active(this);
+		if (!framebuffer_bound)
+		{
+			render_window->is_double_buffered() ? glReadBuffer(GL_BACK) : glReadBuffer(GL_FRONT);
+		}
+
+		// With a pixel pack buffer bound, glReadPixels returns right away and the buffer is filled when the GPU gets there
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, staging->get_handle());
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glPixelStorei(GL_PACK_ROW_LENGTH, dest->pitch() / dest->bytes_per_pixel());
+		glPixelStorei(GL_PACK_SKIP_PIXELS, 0);
+		glPixelStorei(GL_PACK_SKIP_ROWS, 0);
+		glReadPixels(rect.left, rect.top, rect.width(), rect.height(), tf.pixel_format, tf.pixel_datatype, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		return true;
+	}
+
+	VertexRingBufferPtr GL3GraphicContext::create_vertex_ring_buffer(int size)
+	{
+		OpenGL::set_active(this);
+		if (!GL3VertexRingBuffer::is_supported())
+			return VertexRingBufferPtr();
+		return std::make_shared<GL3VertexRingBuffer>(size);
+	}
+
+	GraphicFencePtr GL3GraphicContext::create_fence()
+	{
+		OpenGL::set_active(this);
+		if (!GL3Fence::is_supported())
+			return GraphicFencePtr();
+		return std::make_shared<GL3Fence>();
+	}
+
 	void GL3GraphicContext::set_uniform_buffer(int index, const UniformBufferPtr &buffer)
 	{
 		if (buffer)
@@ -556,39 +612,65 @@ namespace uicore
 
 	void GL3GraphicContext::set_texture(int unit_index, const TexturePtr &texture)
 	{
-		if (texture)
+		if (unit_index >= (int)bound_textures.size())
+			bound_textures.resize(unit_index + 1);
+
+		BoundTexture &bound = bound_textures[unit_index];
+		if (!texture)
 		{
-			OpenGL::set_active(this);
+			// Whatever is bound stays bound until the unit is needed again or a frame buffer is bound
+			bound.released = true;
+			_state_stats.texture_binds_elided++;
+			return;
+		}
 
-			if (glActiveTexture != nullptr)
-			{
-				glActiveTexture(GL_TEXTURE0 + unit_index);
-			}
-			else if (unit_index > 0)
-			{
-				return;
-			}
+		if (bound.texture.lock() == texture)
+		{
+			bound.released = false;
+			_state_stats.texture_binds_elided++;
+			return;
+		}
+
+		OpenGL::set_active(this);
 
-			if (texture)
+		if (glActiveTexture != nullptr)
+		{
+			if (active_texture_unit != unit_index)
 			{
-				GL3TextureObject *provider = static_cast<GL3TextureObject*>(texture->texture_object());
-				glBindTexture(provider->get_texture_type(), provider->get_handle());
+				glActiveTexture(GL_TEXTURE0 + unit_index);
+				active_texture_unit = unit_index;
 			}
 		}
-		else
+		else if (unit_index > 0)
 		{
-			OpenGL::set_active(this);
+			return;
+		}
 
-			if (glActiveTexture != nullptr)
+		GL3TextureObject *provider = static_cast<GL3TextureObject*>(texture->texture_object());
+		glBindTexture(provider->get_texture_type(), provider->get_handle());
+		bound.texture = texture;
+		bound.target = provider->get_texture_type();
+		bound.released = false;
+		_state_stats.texture_binds++;
+	}
+
+	void GL3GraphicContext::unbind_released_textures()
+	{
+		// A texture left bound could be sampled while it is also a render target of the new frame buffer
+		for (int unit_index = 0; unit_index < (int)bound_textures.size(); unit_index++)
+		{
+			BoundTexture &bound = bound_textures[unit_index];
+			if (bound.released && bound.target != 0)
 			{
-				glActiveTexture(GL_TEXTURE0 + unit_index);
+				if (glActiveTexture != nullptr && active_texture_unit != unit_index)
+				{
+					glActiveTexture(GL_TEXTURE0 + unit_index);
+					active_texture_unit = unit_index;
+				}
+				glBindTexture(bound.target, 0);
+				bound = BoundTexture();
+				_state_stats.texture_binds++;
 			}
-			else if (unit_index > 0)
-			{
-				return;
-			}
-			// Set the texture to the default state
-			glBindTexture(GL_TEXTURE_2D, 0);
 		}
 	}
 
@@ -630,6 +712,7 @@ namespace uicore
 				throw Exception("FrameBuffer objects cannot be shared between multiple GraphicContext objects");
 
 			OpenGL::set_active(this);
+			unbind_released_textures();
 
 			draw_buffer_provider->bind_framebuffer(true);
 			if (draw_buffer_provider != read_buffer_provider)		// You cannot read and write to the same framebuffer
@@ -674,18 +757,19 @@ namespace uicore
 	{
 		_program_object = program;
 
+		if (!program || bound_program.lock() == program)
+		{
+			_state_stats.program_binds_elided++;
+			return;
+		}
+
 		OpenGL::set_active(this);
 		if (glUseProgram == nullptr)
 			return;
 
-		if (program)
-		{
-			glUseProgram(static_cast<GL3ProgramObject*>(program.get())->get_handle());
-		}
-		else
-		{
-			glUseProgram(0);
-		}
+		glUseProgram(static_cast<GL3ProgramObject*>(program.get())->get_handle());
+		bound_program = program;
+		_state_stats.program_binds++;
 	}
 
 	bool GL3GraphicContext::is_primitives_array_owner(const PrimitivesArrayPtr &prim_array)
@@ -706,18 +790,18 @@ namespace uicore
 
 	void GL3GraphicContext::set_primitives_array(const PrimitivesArrayPtr &primitives_array)
 	{
-		if (primitives_array)
-		{
-			GL3PrimitivesArray *prim_array = static_cast<GL3PrimitivesArray *>(primitives_array.get());
-
-			OpenGL::set_active(this);
-			glBindVertexArray(prim_array->handle);
-		}
-		else
+		if (!primitives_array || bound_primitives_array.lock() == primitives_array)
 		{
-			OpenGL::set_active(this);
-			glBindVertexArray(0);
+			_state_stats.primitives_array_binds_elided++;
+			return;
 		}
+
+		GL3PrimitivesArray *prim_array = static_cast<GL3PrimitivesArray *>(primitives_array.get());
+
+		OpenGL::set_active(this);
+		glBindVertexArray(prim_array->handle);
+		bound_primitives_array = primitives_array;
+		_state_stats.primitives_array_binds++;
 	}
 
 	void GL3GraphicContext::draw_primitives_array(PrimitivesType type, int offset, int num_vertices)
@@ -785,25 +869,60 @@ namespace uicore
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
-	void GL3GraphicContext::set_scissor(const Rect &rect)
+	void GL3GraphicContext::draw_primitives_elements_base_vertex(PrimitivesType type, int count, const ElementArrayBufferPtr &array_provider, VertexAttributeDataType indices_type, size_t offset, int base_vertex)
 	{
 		OpenGL::set_active(this);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_cast<GL3ElementArrayBuffer *>(array_provider.get())->get_handle());
+		glDrawElementsBaseVertex(OpenGL::to_enum(type), count, OpenGL::to_enum(indices_type), reinterpret_cast<void*>(offset), base_vertex);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
 
+	void GL3GraphicContext::set_scissor(const Rect &rect)
+	{
 		if (!scissor_enabled)
 			throw Exception("RasterizerState must be set with enable_scissor() for clipping to work");
 
-		glEnable(GL_SCISSOR_TEST);
-		glScissor(
-			rect.x(),
-			rect.y(),
-			rect.width(),
-			rect.height());
+		bool move = !scissor_rect_set || scissor_rect != rect;
+		if (scissor_test_enabled && !move)
+		{
+			_state_stats.scissor_changes_elided++;
+			return;
+		}
+
+		OpenGL::set_active(this);
+
+		if (!scissor_test_enabled)
+		{
+			glEnable(GL_SCISSOR_TEST);
+			scissor_test_enabled = true;
+		}
+
+		if (move)
+		{
+			glScissor(
+				rect.x(),
+				rect.y(),
+				rect.width(),
+				rect.height());
+			scissor_rect = rect;
+			scissor_rect_set = true;
+		}
+
+		_state_stats.scissor_changes++;
 	}
 
 	void GL3GraphicContext::reset_scissor()
 	{
+		if (!scissor_test_enabled)
+		{
+			_state_stats.scissor_changes_elided++;
+			return;
+		}
+
 		OpenGL::set_active(this);
 		glDisable(GL_SCISSOR_TEST);
+		scissor_test_enabled = false;
+		_state_stats.scissor_changes++;
 	}
 
 	void GL3GraphicContext::dispatch(int x, int y, int z)
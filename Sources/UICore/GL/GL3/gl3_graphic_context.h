@@ -132,6 +132,9 @@ namespace uicore
 		void set_blend_state(const BlendStatePtr &state, const Colorf &blend_color, unsigned int sample_mask) override;
 		void set_depth_stencil_state(const DepthStencilStatePtr &state, int stencil_ref) override;
 		std::shared_ptr<PixelBuffer> pixeldata(const Rect& rect, TextureFormat texture_format, bool clamp) const override;
+		bool read_pixels_async(const Rect &rect, const StagingTexturePtr &dest) override;
+		VertexRingBufferPtr create_vertex_ring_buffer(int size) override;
+		GraphicFencePtr create_fence() override;
 		void set_uniform_buffer(int index, const UniformBufferPtr &buffer) override;
 		void set_storage_buffer(int index, const StorageBufferPtr &buffer) override;
 		void set_texture(int unit_index, const TexturePtr &texture) override;
@@ -153,6 +156,7 @@ namespace uicore
 		void draw_primitives_elements_instanced(PrimitivesType type, int count, VertexAttributeDataType indices_type, size_t offset, int instance_count) override;
 		void draw_primitives_elements(PrimitivesType type, int count, const ElementArrayBufferPtr &array_provider, VertexAttributeDataType indices_type, size_t offset) override;
 		void draw_primitives_elements_instanced(PrimitivesType type, int count, const ElementArrayBufferPtr &array_provider, VertexAttributeDataType indices_type, size_t offset, int instance_count) override;
+		void draw_primitives_elements_base_vertex(PrimitivesType type, int count, const ElementArrayBufferPtr &array_provider, VertexAttributeDataType indices_type, size_t offset, int base_vertex) override;
 		void set_scissor(const Rect &rect) override;
 		void reset_scissor() override;
 		void dispatch(int x, int y, int z) override;
@@ -177,6 +181,7 @@ namespace uicore
 	private:
 		void on_dispose() override;
 		void create_standard_programs();
+		void unbind_released_textures();
 
 		void check_opengl_version();
 		void calculate_shading_language_version();
@@ -211,5 +216,24 @@ namespace uicore
 		FrameBufferPtr _read_frame_buffer;
 		FrameBufferPtr _write_frame_buffer;
 		ProgramObjectPtr _program_object;
+
+		// Shadow of the state last passed to OpenGL, so that redundant changes can be skipped.
+		// Unbinding a texture, program or primitives array is deferred until something else is bound in its place.
+		// Weak pointers are used so a handle reused by a new object is never mistaken for the old binding.
+		struct BoundTexture
+		{
+			std::weak_ptr<Texture> texture;
+			GLenum target = 0;
+			bool released = false;	// Reset by the user but left bound
+		};
+		std::vector<BoundTexture> bound_textures;
+		int active_texture_unit = -1;
+		std::weak_ptr<ProgramObject> bound_program;
+		std::weak_ptr<PrimitivesArray> bound_primitives_array;
+		BlendStatePtr bound_blend_state;
+		Colorf bound_blend_color;
+		bool scissor_test_enabled = false;
+		bool scissor_rect_set = false;
+		Rect scissor_rect;
 	};
 }
@@ -53,7 +53,8 @@ namespace uicore
 		glBindBuffer(GL_ARRAY_BUFFER, static_cast<GL3VertexArrayBuffer *>(attribute.array_provider)->get_handle());
 		glEnableVertexAttribArray(attrib_index);
 
-		if (attribute.type == type_float)
+		// Normalized integers are read as floats
+		if (attribute.type == type_float || normalize)
 		{
 			glVertexAttribPointer(attrib_index, attribute.size, OpenGL::to_enum(attribute.type),
 				normalize ? GL_TRUE : GL_FALSE, attribute.stride, (GLvoid *)attribute.offset);
@@ -43,4 +43,9 @@ namespace uicore
 	{
 		buffer.create(data, size, usage, GL_ARRAY_BUFFER_BINDING, GL_ARRAY_BUFFER);
 	}
+
+	GL3VertexArrayBuffer::GL3VertexArrayBuffer(int size, GLbitfield storage_flags)
+	{
+		buffer.create_storage(size, storage_flags, GL_ARRAY_BUFFER_BINDING, GL_ARRAY_BUFFER);
+	}
 }
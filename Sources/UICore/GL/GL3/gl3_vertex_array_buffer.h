@@ -43,6 +43,7 @@ namespace uicore
 	public:
 		GL3VertexArrayBuffer(int size, BufferUsage usage);
 		GL3VertexArrayBuffer(const void *data, int size, BufferUsage usage);
+		GL3VertexArrayBuffer(int size, GLbitfield storage_flags);
 
 		GLuint get_handle() const { return buffer.get_handle(); }
 
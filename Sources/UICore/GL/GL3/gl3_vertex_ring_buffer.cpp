@@ -0,0 +1,200 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "gl3_vertex_ring_buffer.h"
+#include "gl3_vertex_array_buffer.h"
+#include "UICore/GL/opengl_wrap.h"
+
+namespace uicore
+{
+	GL3VertexRingBuffer::GL3VertexRingBuffer(int new_size) : size(new_size)
+	{
+		OpenGL::set_active();
+
+		persistent = glBufferStorage != nullptr;
+		if (persistent)
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			auto gl3_buffer = std::make_shared<GL3VertexArrayBuffer>(size, flags);
+			vertex_buffer = gl3_buffer;
+			handle = gl3_buffer->get_handle();
+
+			GLint last_buffer = 0;
+			glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, handle);
+			persistent_data = (char *)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+			glBindBuffer(GL_ARRAY_BUFFER, last_buffer);
+
+			if (!persistent_data)
+				throw Exception("Unable to map vertex ring buffer");
+		}
+		else
+		{
+			auto gl3_buffer = std::make_shared<GL3VertexArrayBuffer>(size, usage_stream_draw);
+			vertex_buffer = gl3_buffer;
+			handle = gl3_buffer->get_handle();
+		}
+	}
+
+	GL3VertexRingBuffer::~GL3VertexRingBuffer()
+	{
+		dispose();
+	}
+
+	void GL3VertexRingBuffer::on_dispose()
+	{
+		if (!fences.empty() && OpenGL::set_active())
+		{
+			for (auto &fence : fences)
+				glDeleteSync(fence.sync);
+		}
+		fences.clear();
+	}
+
+	bool GL3VertexRingBuffer::is_supported()
+	{
+		return glMapBufferRange && glFlushMappedBufferRange && glUnmapBuffer && glFenceSync && glClientWaitSync && glDeleteSync && glDrawElementsBaseVertex;
+	}
+
+	void *GL3VertexRingBuffer::begin_write(const GraphicContextPtr &gc, int max_size, int alignment, int &out_offset)
+	{
+		throw_if_disposed();
+
+		if (write_offset != -1)
+			throw Exception("Vertex ring buffer write already in progress");
+		if (max_size > size)
+			throw Exception("Vertex ring buffer write larger than the buffer");
+
+		OpenGL::set_active(gc);
+
+		// The draws using the previous writes have been issued at this point, so this is where their fence goes
+		int offset = (head + alignment - 1) / alignment * alignment;
+		if (offset + max_size > size)
+		{
+			fence_pending();
+			offset = 0;
+			head = 0;
+			pending_start = 0;
+		}
+		else if (head - pending_start >= size / 8)
+		{
+			fence_pending();
+		}
+
+		wait_for_range(offset, offset + max_size);
+
+		write_offset = offset;
+		write_size = max_size;
+		out_offset = offset;
+
+		if (persistent)
+			return persistent_data + offset;
+
+		GLint last_buffer = 0;
+		glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, handle);
+		void *data = glMapBufferRange(GL_ARRAY_BUFFER, offset, max_size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+		glBindBuffer(GL_ARRAY_BUFFER, last_buffer);
+
+		if (!data)
+		{
+			write_offset = -1;
+			throw Exception("Unable to map vertex ring buffer");
+		}
+		return data;
+	}
+
+	void GL3VertexRingBuffer::end_write(const GraphicContextPtr &gc, int used_size)
+	{
+		throw_if_disposed();
+
+		if (write_offset == -1)
+			throw Exception("Vertex ring buffer write not in progress");
+		if (used_size > write_size)
+			throw Exception("Vertex ring buffer write exceeded its reserved size");
+
+		if (!persistent)
+		{
+			OpenGL::set_active(gc);
+
+			GLint last_buffer = 0;
+			glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, handle);
+			if (used_size > 0)
+				glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, used_size);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+			glBindBuffer(GL_ARRAY_BUFFER, last_buffer);
+		}
+
+		head = write_offset + used_size;
+		write_offset = -1;
+		write_size = 0;
+	}
+
+	void GL3VertexRingBuffer::fence_pending()
+	{
+		if (head > pending_start)
+		{
+			Fence fence;
+			fence.sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			fence.start = pending_start;
+			fence.end = head;
+			fences.push_back(fence);
+			pending_start = head;
+		}
+	}
+
+	void GL3VertexRingBuffer::wait_for_range(int start, int end)
+	{
+		// The GPU finishes commands in order, so waiting for the newest overlapping fence covers all older ones too
+		int last_overlap = -1;
+		for (int i = 0; i < (int)fences.size(); i++)
+		{
+			if (fences[i].start < end && fences[i].end > start)
+				last_overlap = i;
+		}
+
+		if (last_overlap == -1)
+			return;
+
+		while (true)
+		{
+			GLenum result = glClientWaitSync(fences[last_overlap].sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+				break;
+		}
+
+		for (int i = 0; i <= last_overlap; i++)
+		{
+			glDeleteSync(fences.front().sync);
+			fences.pop_front();
+		}
+	}
+}
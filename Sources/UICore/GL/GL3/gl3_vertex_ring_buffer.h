@@ -0,0 +1,84 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include "UICore/Display/Render/vertex_ring_buffer.h"
+#include "UICore/GL/opengl.h"
+#include "UICore/GL/gl_share_list.h"
+#include <deque>
+
+namespace uicore
+{
+	class GL3VertexArrayBuffer;
+
+	/// \brief Vertex ring buffer kept persistently mapped when GL_ARB_buffer_storage is available
+	///
+	/// Without buffer storage each write maps its range with GL_MAP_UNSYNCHRONIZED_BIT and unmaps it again in end_write.
+	/// In both cases fences inserted behind the draws keep writes from overwriting ranges the GPU has not read yet.
+	class GL3VertexRingBuffer : public VertexRingBuffer, GLSharedResource
+	{
+	public:
+		GL3VertexRingBuffer(int size);
+		~GL3VertexRingBuffer();
+
+		/// \brief Returns true if the OpenGL functions needed by the ring buffer are available
+		static bool is_supported();
+
+		const VertexArrayBufferPtr &buffer() const override { return vertex_buffer; }
+
+		void *begin_write(const GraphicContextPtr &gc, int max_size, int alignment, int &out_offset) override;
+		void end_write(const GraphicContextPtr &gc, int used_size) override;
+
+	private:
+		struct Fence
+		{
+			CLsync sync;
+			int start;
+			int end;
+		};
+
+		void fence_pending();
+		void wait_for_range(int start, int end);
+		void on_dispose() override;
+
+		VertexArrayBufferPtr vertex_buffer;
+		GLuint handle = 0;
+		int size = 0;
+		bool persistent = false;
+		char *persistent_data = nullptr;
+
+		int head = 0;	// Where the next write starts looking for room
+		int write_offset = -1;	// Start of the range between begin_write and end_write, or -1
+		int write_size = 0;
+		int pending_start = 0;	// Written ranges not covered by a fence yet are [pending_start, head)
+
+		std::deque<Fence> fences;	// Oldest first
+	};
+}
@@ -65,6 +65,10 @@
 #ifdef HAVE_X11_EXTENSIONS_XRENDER_H
 #include <X11/extensions/Xrender.h>
 #endif
+
+#ifndef GLX_BACK_BUFFER_AGE_EXT
+#define GLX_BACK_BUFFER_AGE_EXT 0x20F4
+#endif
 #include "../../../Display/setup_display.h"
 
 namespace uicore
@@ -622,6 +626,8 @@ void OpenGLWindowProvider::setup_extension_pointers()
 		glXSwapIntervalMESA = nullptr;
 	}
 
+	buffer_age_supported = glx_1_3 && glx.glXQueryDrawable && is_glx_extension_supported("GLX_EXT_buffer_age");
+
 	glx.glXCreatePbufferSGIX = (GL_GLXFunctions::ptr_glXCreatePbufferSGIX) OpenGL::get_proc_address("glXCreateGLXPbufferSGIX");
 	glx.glXDestroyPbufferSGIX = (GL_GLXFunctions::ptr_glXDestroyPbuffer) OpenGL::get_proc_address("glXDestroyGLXPbufferSGIX");
 	glx.glXChooseFBConfigSGIX = (GL_GLXFunctions::ptr_glXChooseFBConfig) OpenGL::get_proc_address("glXChooseFBConfigSGIX");
@@ -864,6 +870,18 @@ void OpenGLWindowProvider::backing_flip(int interval)
 	OpenGL::check_error();
 }
 
+int OpenGLWindowProvider::back_buffer_age()
+{
+	if (!buffer_age_supported)
+		return 0;
+
+	OpenGL::set_active(_gc);
+
+	unsigned int age = 0;
+	glx.glXQueryDrawable(x11_window.get_display(), x11_window.get_window(), GLX_BACK_BUFFER_AGE_EXT, &age);
+	return age;
+}
+
 CursorPtr OpenGLWindowProvider::create_cursor(const CursorDescription &cursor_description)
 {
 	return std::make_shared<CursorProvider_X11>(cursor_description, cursor_description.hotspot());
@@ -254,6 +254,9 @@ public:
 	/// \brief Flip opengl buffers.
 	void backing_flip(int interval) override;
 
+	/// \brief Back buffer age from GLX_EXT_buffer_age, or 0 if the extension is missing.
+	int back_buffer_age() override;
+
 	/// \brief Capture/Release the mouse.
 	void capture_mouse(bool capture) override { x11_window.capture_mouse(capture); }
 
@@ -310,6 +313,8 @@ private:
 	ptr_glXSwapIntervalEXT glXSwapIntervalEXT = nullptr;
 	int swap_interval;
 
+	bool buffer_age_supported = false;
+
 	GLXFBConfig fbconfig;
 
 #ifdef GL_USE_DLOPEN
@@ -0,0 +1,53 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Display/Render/element_array_buffer.h"
+#include <vector>
+
+namespace uicore
+{
+	class SoftwareElementArrayBuffer : public ElementArrayBuffer
+	{
+	public:
+		SoftwareElementArrayBuffer(int size, BufferUsage usage);
+		SoftwareElementArrayBuffer(const void *data, int size, BufferUsage usage);
+		~SoftwareElementArrayBuffer();
+
+		const char *get_data() const { return data.data(); }
+		int get_size() const { return (int)data.size(); }
+
+		void upload_data(const GraphicContextPtr &gc, const void *data, int size) override;
+		void copy_from(const GraphicContextPtr &gc, const StagingBufferPtr &buffer, int dest_pos, int src_pos, int size) override;
+		void copy_to(const GraphicContextPtr &gc, const StagingBufferPtr &buffer, int dest_pos, int src_pos, int size) override;
+
+	private:
+		std::vector<char> data;
+	};
+}
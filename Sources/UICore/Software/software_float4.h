@@ -0,0 +1,142 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Core/Math/vec4.h"
+#include <algorithm>
+
+#if !defined __ANDROID__ && ! defined CL_DISABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace uicore
+{
+	/// \brief Four floats processed as one unit, a single SSE register when SSE2 is available
+	///
+	/// The software target keeps a whole RGBA color, or any other shader vector, in one of these.
+	class SoftwareFloat4
+	{
+	public:
+		SoftwareFloat4() { }
+		SoftwareFloat4(const Vec4f &v) { load(&v.x); }
+		SoftwareFloat4(float x, float y, float z, float w) { const float f[4] = { x, y, z, w }; load(f); }
+
+		static SoftwareFloat4 splat(float f) { return SoftwareFloat4(f, f, f, f); }
+
+#ifdef __SSE2__
+		SoftwareFloat4(__m128 v) : v(v) { }
+
+		void load(const float *f) { v = _mm_loadu_ps(f); }
+		void store(float *f) const { _mm_storeu_ps(f, v); }
+
+		float x() const { return _mm_cvtss_f32(v); }
+		float w() const { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))); }
+
+		SoftwareFloat4 splat_x() const { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)); }
+		SoftwareFloat4 splat_w() const { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+		/// \brief Swaps the first and third component (RGBA to BGRA and back)
+		SoftwareFloat4 swap_xz() const { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 1, 2)); }
+
+		/// \brief Returns this vector with the fourth component replaced by the fourth component of other
+		SoftwareFloat4 with_w(const SoftwareFloat4 &other) const
+		{
+			__m128 zw = _mm_shuffle_ps(v, other.v, _MM_SHUFFLE(3, 3, 2, 2));
+			return _mm_shuffle_ps(v, zw, _MM_SHUFFLE(2, 0, 1, 0));
+		}
+
+		SoftwareFloat4 operator+(const SoftwareFloat4 &b) const { return _mm_add_ps(v, b.v); }
+		SoftwareFloat4 operator-(const SoftwareFloat4 &b) const { return _mm_sub_ps(v, b.v); }
+		SoftwareFloat4 operator*(const SoftwareFloat4 &b) const { return _mm_mul_ps(v, b.v); }
+		SoftwareFloat4 &operator+=(const SoftwareFloat4 &b) { v = _mm_add_ps(v, b.v); return *this; }
+
+		static SoftwareFloat4 min(const SoftwareFloat4 &a, const SoftwareFloat4 &b) { return _mm_min_ps(a.v, b.v); }
+		static SoftwareFloat4 max(const SoftwareFloat4 &a, const SoftwareFloat4 &b) { return _mm_max_ps(a.v, b.v); }
+
+		/// \brief Converts a pixel with four 8 bit channels, first channel in the lowest byte, to floats in the 0-1 range
+		static SoftwareFloat4 unpack(unsigned int pixel)
+		{
+			__m128i zero = _mm_setzero_si128();
+			__m128i p = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero);
+			return _mm_mul_ps(_mm_cvtepi32_ps(p), _mm_set1_ps(1.0f / 255.0f));
+		}
+
+		/// \brief Converts to a pixel with four 8 bit channels, clamping to the 0-1 range and rounding to nearest
+		unsigned int pack() const
+		{
+			__m128 c = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+			__m128i p = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+			p = _mm_packs_epi32(p, p);
+			return _mm_cvtsi128_si32(_mm_packus_epi16(p, p));
+		}
+
+		__m128 v;
+#else
+		void load(const float *f) { v[0] = f[0]; v[1] = f[1]; v[2] = f[2]; v[3] = f[3]; }
+		void store(float *f) const { f[0] = v[0]; f[1] = v[1]; f[2] = v[2]; f[3] = v[3]; }
+
+		float x() const { return v[0]; }
+		float w() const { return v[3]; }
+
+		SoftwareFloat4 splat_x() const { return splat(v[0]); }
+		SoftwareFloat4 splat_w() const { return splat(v[3]); }
+		SoftwareFloat4 swap_xz() const { return SoftwareFloat4(v[2], v[1], v[0], v[3]); }
+		SoftwareFloat4 with_w(const SoftwareFloat4 &other) const { return SoftwareFloat4(v[0], v[1], v[2], other.v[3]); }
+
+		SoftwareFloat4 operator+(const SoftwareFloat4 &b) const { return SoftwareFloat4(v[0] + b.v[0], v[1] + b.v[1], v[2] + b.v[2], v[3] + b.v[3]); }
+		SoftwareFloat4 operator-(const SoftwareFloat4 &b) const { return SoftwareFloat4(v[0] - b.v[0], v[1] - b.v[1], v[2] - b.v[2], v[3] - b.v[3]); }
+		SoftwareFloat4 operator*(const SoftwareFloat4 &b) const { return SoftwareFloat4(v[0] * b.v[0], v[1] * b.v[1], v[2] * b.v[2], v[3] * b.v[3]); }
+		SoftwareFloat4 &operator+=(const SoftwareFloat4 &b) { *this = *this + b; return *this; }
+
+		static SoftwareFloat4 min(const SoftwareFloat4 &a, const SoftwareFloat4 &b) { return SoftwareFloat4(std::min(a.v[0], b.v[0]), std::min(a.v[1], b.v[1]), std::min(a.v[2], b.v[2]), std::min(a.v[3], b.v[3])); }
+		static SoftwareFloat4 max(const SoftwareFloat4 &a, const SoftwareFloat4 &b) { return SoftwareFloat4(std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1]), std::max(a.v[2], b.v[2]), std::max(a.v[3], b.v[3])); }
+
+		static SoftwareFloat4 unpack(unsigned int pixel)
+		{
+			const float s = 1.0f / 255.0f;
+			return SoftwareFloat4((pixel & 0xff) * s, ((pixel >> 8) & 0xff) * s, ((pixel >> 16) & 0xff) * s, (pixel >> 24) * s);
+		}
+
+		unsigned int pack() const
+		{
+			unsigned int pixel = 0;
+			for (int i = 0; i < 4; i++)
+				pixel |= static_cast<unsigned int>(std::min(std::max(v[i], 0.0f), 1.0f) * 255.0f + 0.5f) << (i * 8);
+			return pixel;
+		}
+
+		float v[4];
+#endif
+
+		Vec4f to_vec4f() const { Vec4f r; store(&r.x); return r; }
+
+		/// \brief Linear interpolation, a + (b - a) * t
+		static SoftwareFloat4 mix(const SoftwareFloat4 &a, const SoftwareFloat4 &b, const SoftwareFloat4 &t) { return a + (b - a) * t; }
+	};
+}
@@ -0,0 +1,108 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "software_frame_buffer.h"
+#include "software_texture_object.h"
+#include "UICore/Core/System/exception.h"
+
+namespace uicore
+{
+	SoftwareFrameBuffer::SoftwareFrameBuffer()
+	{
+	}
+
+	SoftwareFrameBuffer::~SoftwareFrameBuffer()
+	{
+	}
+
+	Size SoftwareFrameBuffer::size() const
+	{
+		if (!color_attachment)
+			return Size();
+		return color_attachment->size();
+	}
+
+	SoftwareTextureObject *SoftwareFrameBuffer::color_texture() const
+	{
+		if (!color_attachment)
+			return nullptr;
+		return static_cast<SoftwareTextureObject*>(color_attachment->texture_object());
+	}
+
+	void SoftwareFrameBuffer::attach_color(int attachment_index, const RenderBufferPtr &render_buffer)
+	{
+		throw Exception("Render buffers are not supported by the software target");
+	}
+
+	void SoftwareFrameBuffer::attach_color(int attachment_index, const Texture1DPtr &texture, int level)
+	{
+		throw Exception("Only 2D textures can be rendered to by the software target");
+	}
+
+	void SoftwareFrameBuffer::attach_color(int attachment_index, const Texture1DArrayPtr &texture, int array_index, int level)
+	{
+		throw Exception("Only 2D textures can be rendered to by the software target");
+	}
+
+	void SoftwareFrameBuffer::attach_color(int attachment_index, const Texture2DPtr &texture, int level)
+	{
+		if (attachment_index != 0 || level != 0)
+			throw Exception("The software target can only render to the base level of color attachment 0");
+
+		SoftwareTextureObject *texture_object = dynamic_cast<SoftwareTextureObject*>(texture->texture_object());
+		if (texture_object == nullptr)
+			throw Exception("Selected texture is not a software texture");
+		if (texture_object->image()->format() != tf_rgba8)
+			throw Exception("The software target can only render to textures stored as tf_rgba8");
+
+		color_attachment = texture;
+	}
+
+	void SoftwareFrameBuffer::attach_color(int attachment_index, const Texture2DArrayPtr &texture, int array_index, int level)
+	{
+		throw Exception("Only 2D textures can be rendered to by the software target");
+	}
+
+	void SoftwareFrameBuffer::attach_color(int attachment_index, const Texture3DPtr &texture, int depth, int level)
+	{
+		throw Exception("Only 2D textures can be rendered to by the software target");
+	}
+
+	void SoftwareFrameBuffer::attach_color(int attachment_index, const TextureCubePtr &texture, TextureSubtype subtype, int level)
+	{
+		throw Exception("Only 2D textures can be rendered to by the software target");
+	}
+
+	void SoftwareFrameBuffer::detach_color(int attachment_index)
+	{
+		if (attachment_index == 0)
+			color_attachment.reset();
+	}
+}
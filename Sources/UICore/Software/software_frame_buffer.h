@@ -0,0 +1,86 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include "UICore/Display/Render/frame_buffer.h"
+#include "UICore/Display/Render/texture_2d.h"
+#include "UICore/Core/Math/size.h"
+
+namespace uicore
+{
+	class SoftwareTextureObject;
+
+	/// \brief Frame buffer rendering into the pixels of a 2D texture
+	///
+	/// Only color attachment 0 is used. Depth and stencil attachments are accepted but ignored,
+	/// as the software target has no depth or stencil testing.
+	class SoftwareFrameBuffer : public FrameBuffer
+	{
+	public:
+		SoftwareFrameBuffer();
+		~SoftwareFrameBuffer();
+
+		Size size() const override;
+		FrameBufferBindTarget bind_target() const override { return _bind_target; }
+
+		void attach_color(int attachment_index, const RenderBufferPtr &render_buffer) override;
+		void attach_color(int attachment_index, const Texture1DPtr &texture, int level) override;
+		void attach_color(int attachment_index, const Texture1DArrayPtr &texture, int array_index, int level) override;
+		void attach_color(int attachment_index, const Texture2DPtr &texture, int level) override;
+		void attach_color(int attachment_index, const Texture2DArrayPtr &texture, int array_index, int level) override;
+		void attach_color(int attachment_index, const Texture3DPtr &texture, int depth, int level) override;
+		void attach_color(int attachment_index, const TextureCubePtr &texture, TextureSubtype subtype, int level) override;
+		void detach_color(int attachment_index) override;
+
+		void attach_stencil(const RenderBufferPtr &render_buffer) override { }
+		void attach_stencil(const Texture2DPtr &texture, int level) override { }
+		void attach_stencil(const TextureCubePtr &texture, TextureSubtype subtype, int level) override { }
+		void detach_stencil() override { }
+
+		void attach_depth(const RenderBufferPtr &render_buffer) override { }
+		void attach_depth(const Texture2DPtr &texture, int level) override { }
+		void attach_depth(const TextureCubePtr &texture, TextureSubtype subtype, int level) override { }
+		void detach_depth() override { }
+
+		void attach_depth_stencil(const RenderBufferPtr &render_buffer) override { }
+		void attach_depth_stencil(const Texture2DPtr &texture, int level) override { }
+		void attach_depth_stencil(const TextureCubePtr &texture, TextureSubtype subtype, int level) override { }
+		void detach_depth_stencil() override { }
+
+		void set_bind_target(FrameBufferBindTarget target) override { _bind_target = target; }
+
+		/// \brief Texture object of color attachment 0, or null when nothing is attached
+		SoftwareTextureObject *color_texture() const;
+
+	private:
+		Texture2DPtr color_attachment;
+		FrameBufferBindTarget _bind_target = framebuffer_draw;
+	};
+}
@@ -0,0 +1,559 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "software_graphic_context.h"
+#include "software_render_state.h"
+#include "software_texture_object.h"
+#include "software_frame_buffer.h"
+#include "software_program_object.h"
+#include "software_primitives_array.h"
+#include "software_vertex_array_buffer.h"
+#include "software_element_array_buffer.h"
+#include "software_staging_buffer.h"
+#include "software_staging_texture.h"
+#include "UICore/Display/Render/texture_impl.h"
+#include "UICore/Core/System/exception.h"
+#include <cmath>
+
+namespace uicore
+{
+	SoftwareGraphicContext::SoftwareGraphicContext(const PixelBufferPtr &window_pixels)
+	{
+		set_window_pixels(window_pixels);
+		selected_program = standard_programs.get_program_object(program_color_only);
+	}
+
+	SoftwareGraphicContext::~SoftwareGraphicContext()
+	{
+	}
+
+	void SoftwareGraphicContext::set_window_pixels(const PixelBufferPtr &pixels)
+	{
+		if (!pixels)
+			throw Exception("Software graphic context needs a pixel buffer to draw into");
+
+		TextureFormat format = pixels->format();
+		if (format != tf_rgba8 && format != tf_srgb8_alpha8 && format != tf_bgra8)
+			throw Exception("Software graphic context can only draw into tf_rgba8, tf_srgb8_alpha8 or tf_bgra8 pixel buffers");
+
+		bool resized = !window_pixels || window_pixels->size() != pixels->size();
+		window_pixels = pixels;
+		if (resized)
+			on_window_resized();
+	}
+
+	float SoftwareGraphicContext::pixel_ratio() const
+	{
+		float ratio = window_pixels->pixel_ratio();
+		return ratio > 0.0f ? ratio : 1.0f;
+	}
+
+	std::shared_ptr<RasterizerState> SoftwareGraphicContext::create_rasterizer_state(const RasterizerStateDescription &desc)
+	{
+		auto it = rasterizer_states.find(desc);
+		if (it != rasterizer_states.end())
+		{
+			return it->second;
+		}
+		else
+		{
+			auto state = std::make_shared<SoftwareRasterizerState>(desc);
+			rasterizer_states[desc.clone()] = state;
+			return state;
+		}
+	}
+
+	std::shared_ptr<BlendState> SoftwareGraphicContext::create_blend_state(const BlendStateDescription &desc)
+	{
+		auto it = blend_states.find(desc);
+		if (it != blend_states.end())
+		{
+			return it->second;
+		}
+		else
+		{
+			auto state = std::make_shared<SoftwareBlendState>(desc);
+			blend_states[desc.clone()] = state;
+			return state;
+		}
+	}
+
+	std::shared_ptr<DepthStencilState> SoftwareGraphicContext::create_depth_stencil_state(const DepthStencilStateDescription &desc)
+	{
+		auto it = depth_stencil_states.find(desc);
+		if (it != depth_stencil_states.end())
+		{
+			return it->second;
+		}
+		else
+		{
+			auto state = std::make_shared<SoftwareDepthStencilState>(desc);
+			depth_stencil_states[desc.clone()] = state;
+			return state;
+		}
+	}
+
+	std::shared_ptr<ProgramObject> SoftwareGraphicContext::create_program()
+	{
+		throw Exception("Custom program objects are not supported by the software target");
+	}
+
+	std::shared_ptr<ShaderObject> SoftwareGraphicContext::create_shader(ShaderType type, const std::string &source)
+	{
+		throw Exception("Shaders are not supported by the software target");
+	}
+
+	std::shared_ptr<ShaderObject> SoftwareGraphicContext::create_shader(ShaderType type, const void *bytecode, int bytecode_size)
+	{
+		throw Exception("Shaders are not supported by the software target");
+	}
+
+	std::shared_ptr<OcclusionQuery> SoftwareGraphicContext::create_occlusion_query()
+	{
+		throw Exception("Occlusion queries are not supported by the software target");
+	}
+
+	std::shared_ptr<FrameBuffer> SoftwareGraphicContext::create_frame_buffer()
+	{
+		return std::make_shared<SoftwareFrameBuffer>();
+	}
+
+	std::shared_ptr<RenderBuffer> SoftwareGraphicContext::create_render_buffer(int width, int height, TextureFormat texture_format, int multisample_samples)
+	{
+		throw Exception("Render buffers are not supported by the software target");
+	}
+
+	std::shared_ptr<StorageBuffer> SoftwareGraphicContext::create_storage_buffer(int size, int stride, BufferUsage usage)
+	{
+		throw Exception("Storage buffers are not supported by the software target");
+	}
+
+	std::shared_ptr<StorageBuffer> SoftwareGraphicContext::create_storage_buffer(const void *data, int size, int stride, BufferUsage usage)
+	{
+		throw Exception("Storage buffers are not supported by the software target");
+	}
+
+	std::shared_ptr<ElementArrayBuffer> SoftwareGraphicContext::create_element_array_buffer(int size, BufferUsage usage)
+	{
+		return std::make_shared<SoftwareElementArrayBuffer>(size, usage);
+	}
+
+	std::shared_ptr<ElementArrayBuffer> SoftwareGraphicContext::create_element_array_buffer(const void *data, int size, BufferUsage usage)
+	{
+		return std::make_shared<SoftwareElementArrayBuffer>(data, size, usage);
+	}
+
+	std::shared_ptr<VertexArrayBuffer> SoftwareGraphicContext::create_vertex_array_buffer(int size, BufferUsage usage)
+	{
+		return std::make_shared<SoftwareVertexArrayBuffer>(size, usage);
+	}
+
+	std::shared_ptr<VertexArrayBuffer> SoftwareGraphicContext::create_vertex_array_buffer(const void *data, int size, BufferUsage usage)
+	{
+		return std::make_shared<SoftwareVertexArrayBuffer>(data, size, usage);
+	}
+
+	std::shared_ptr<UniformBuffer> SoftwareGraphicContext::create_uniform_buffer(int size, BufferUsage usage)
+	{
+		throw Exception("Uniform buffers are not supported by the software target");
+	}
+
+	std::shared_ptr<UniformBuffer> SoftwareGraphicContext::create_uniform_buffer(const void *data, int size, BufferUsage usage)
+	{
+		throw Exception("Uniform buffers are not supported by the software target");
+	}
+
+	std::shared_ptr<StagingBuffer> SoftwareGraphicContext::create_staging_buffer(int size, BufferUsage usage)
+	{
+		return std::make_shared<SoftwareStagingBuffer>(size, usage);
+	}
+
+	std::shared_ptr<StagingBuffer> SoftwareGraphicContext::create_staging_buffer(const void *data, int size, BufferUsage usage)
+	{
+		return std::make_shared<SoftwareStagingBuffer>(data, size, usage);
+	}
+
+	std::shared_ptr<PrimitivesArray> SoftwareGraphicContext::create_primitives_array()
+	{
+		return std::make_shared<SoftwarePrimitivesArray>();
+	}
+
+	std::shared_ptr<Texture1D> SoftwareGraphicContext::create_texture_1d(int width, TextureFormat texture_format, int levels)
+	{
+		throw Exception("Only 2D textures are supported by the software target");
+	}
+
+	std::shared_ptr<Texture1DArray> SoftwareGraphicContext::create_texture_1d_array(int width, int array_size, TextureFormat texture_format, int levels)
+	{
+		throw Exception("Only 2D textures are supported by the software target");
+	}
+
+	std::shared_ptr<Texture2D> SoftwareGraphicContext::create_texture_2d(int width, int height, TextureFormat texture_format, int levels)
+	{
+		return std::make_shared<Texture2DImpl<SoftwareTextureObject>>(SoftwareTextureObject::InitData(), width, height, texture_format, levels);
+	}
+
+	std::shared_ptr<Texture2DArray> SoftwareGraphicContext::create_texture_2d_array(int width, int height, int array_size, TextureFormat texture_format, int levels)
+	{
+		throw Exception("Only 2D textures are supported by the software target");
+	}
+
+	std::shared_ptr<Texture3D> SoftwareGraphicContext::create_texture_3d(int width, int height, int depth, TextureFormat texture_format, int levels)
+	{
+		throw Exception("Only 2D textures are supported by the software target");
+	}
+
+	std::shared_ptr<TextureCube> SoftwareGraphicContext::create_texture_cube(int width, int height, TextureFormat texture_format, int levels)
+	{
+		throw Exception("Only 2D textures are supported by the software target");
+	}
+
+	std::shared_ptr<TextureCubeArray> SoftwareGraphicContext::create_texture_cube_array(int width, int height, int array_size, TextureFormat texture_format, int levels)
+	{
+		throw Exception("Only 2D textures are supported by the software target");
+	}
+
+	std::shared_ptr<StagingTexture> SoftwareGraphicContext::create_staging_texture(const void *data, const Size &new_size, StagingDirection direction, TextureFormat new_format, BufferUsage usage)
+	{
+		return std::make_shared<SoftwareStagingTexture>(data, new_size, direction, new_format, usage);
+	}
+
+	void SoftwareGraphicContext::set_rasterizer_state(const RasterizerStatePtr &state)
+	{
+		if (state)
+			selected_rasterizer = std::static_pointer_cast<SoftwareRasterizerState>(state);
+		else
+			set_rasterizer_state(default_rasterizer_state());
+	}
+
+	void SoftwareGraphicContext::set_blend_state(const BlendStatePtr &state, const Colorf &blend_color, unsigned int sample_mask)
+	{
+		if (state)
+		{
+			selected_blend = std::static_pointer_cast<SoftwareBlendState>(state);
+			selected_blend_color = blend_color;
+		}
+		else
+		{
+			set_blend_state(default_blend_state(), blend_color, sample_mask);
+		}
+	}
+
+	void SoftwareGraphicContext::set_depth_stencil_state(const DepthStencilStatePtr &state, int stencil_ref)
+	{
+		// Depth and stencil testing is not performed by the software target
+	}
+
+	PixelBufferPtr SoftwareGraphicContext::pixeldata(const Rect& rect, TextureFormat texture_format, bool clamp) const
+	{
+		PixelBufferPtr source = read_target();
+
+		Rect source_rect = rect;
+		source_rect.overlap(Rect(Point(0, 0), source->size()));
+		if (source_rect != rect)
+			throw Exception("Rectangle passed to GraphicContext::pixeldata is outside the frame buffer");
+
+		return source->copy(rect)->to_format(texture_format);
+	}
+
+	bool SoftwareGraphicContext::read_pixels_async(const Rect &rect, const StagingTexturePtr &dest)
+	{
+		if (dest->format() != tf_rgba8 || rect.width() > dest->width() || rect.height() > dest->height())
+			throw Exception("Staging texture passed to GraphicContext::read_pixels_async must be tf_rgba8 and large enough");
+
+		// Staging textures live in system memory, so this is a plain copy
+		PixelBufferPtr pixels = pixeldata(rect, tf_rgba8, true);
+		for (int y = 0; y < rect.height(); y++)
+			memcpy(dest->line_uint8(y), pixels->line_uint8(y), rect.width() * 4);
+		return true;
+	}
+
+	void SoftwareGraphicContext::set_uniform_buffer(int index, const UniformBufferPtr &buffer)
+	{
+		if (buffer)
+			throw Exception("Uniform buffers are not supported by the software target");
+	}
+
+	void SoftwareGraphicContext::set_storage_buffer(int index, const StorageBufferPtr &buffer)
+	{
+		if (buffer)
+			throw Exception("Storage buffers are not supported by the software target");
+	}
+
+	void SoftwareGraphicContext::set_texture(int unit_index, const TexturePtr &texture)
+	{
+		if (unit_index < 0 || unit_index >= SoftwareShaderContext::max_textures)
+			throw Exception("Invalid texture unit index in software target");
+		selected_textures[unit_index] = texture;
+	}
+
+	void SoftwareGraphicContext::set_image_texture(int unit_index, const TexturePtr &texture)
+	{
+		if (texture)
+			throw Exception("Image textures are not supported by the software target");
+	}
+
+	bool SoftwareGraphicContext::is_frame_buffer_owner(const FrameBufferPtr &fb)
+	{
+		return dynamic_cast<SoftwareFrameBuffer*>(fb.get()) != nullptr;
+	}
+
+	void SoftwareGraphicContext::set_frame_buffer(const FrameBufferPtr &write_buffer, const FrameBufferPtr &read_buffer)
+	{
+		if ((write_buffer && !is_frame_buffer_owner(write_buffer)) || (read_buffer && !is_frame_buffer_owner(read_buffer)))
+			throw Exception("FrameBuffer objects cannot be shared between different graphic context targets");
+
+		_write_frame_buffer = write_buffer;
+		_read_frame_buffer = read_buffer;
+	}
+
+	void SoftwareGraphicContext::set_program_object(StandardProgram standard_program)
+	{
+		selected_program = standard_programs.get_program_object(standard_program);
+	}
+
+	void SoftwareGraphicContext::set_program_object(const ProgramObjectPtr &program)
+	{
+		if (program && !dynamic_cast<SoftwareProgramObject*>(program.get()))
+			throw Exception("Program object is not a software program");
+		selected_program = program;
+	}
+
+	bool SoftwareGraphicContext::is_primitives_array_owner(const PrimitivesArrayPtr &primitives_array)
+	{
+		return dynamic_cast<SoftwarePrimitivesArray*>(primitives_array.get()) != nullptr;
+	}
+
+	void SoftwareGraphicContext::draw_primitives(PrimitivesType type, int num_vertices, const PrimitivesArrayPtr &primitives_array)
+	{
+		set_primitives_array(primitives_array);
+		draw_primitives_array(type, 0, num_vertices);
+		set_primitives_array(nullptr);
+	}
+
+	void SoftwareGraphicContext::set_primitives_array(const PrimitivesArrayPtr &primitives_array)
+	{
+		if (primitives_array && !is_primitives_array_owner(primitives_array))
+			throw Exception("Primitives array is not a software primitives array");
+		selected_primitives = std::static_pointer_cast<SoftwarePrimitivesArray>(primitives_array);
+	}
+
+	void SoftwareGraphicContext::draw_primitives_array(PrimitivesType type, int offset, int num_vertices)
+	{
+		indices.resize(num_vertices);
+		for (int i = 0; i < num_vertices; i++)
+			indices[i] = offset + i;
+		draw_indices(type);
+	}
+
+	void SoftwareGraphicContext::draw_primitives_array_instanced(PrimitivesType type, int offset, int num_vertices, int instance_count)
+	{
+		throw Exception("Instanced drawing is not supported by the software target");
+	}
+
+	void SoftwareGraphicContext::set_primitives_elements(const ElementArrayBufferPtr &element_array)
+	{
+		selected_elements = element_array;
+	}
+
+	void SoftwareGraphicContext::draw_primitives_elements(PrimitivesType type, int count, VertexAttributeDataType indices_type, size_t offset)
+	{
+		draw_primitives_elements(type, count, selected_elements, indices_type, offset);
+	}
+
+	void SoftwareGraphicContext::draw_primitives_elements_instanced(PrimitivesType type, int count, VertexAttributeDataType indices_type, size_t offset, int instance_count)
+	{
+		throw Exception("Instanced drawing is not supported by the software target");
+	}
+
+	void SoftwareGraphicContext::draw_primitives_elements(PrimitivesType type, int count, const ElementArrayBufferPtr &element_array, VertexAttributeDataType indices_type, size_t offset)
+	{
+		read_indices(element_array, count, indices_type, offset);
+		draw_indices(type);
+	}
+
+	void SoftwareGraphicContext::draw_primitives_elements_instanced(PrimitivesType type, int count, const ElementArrayBufferPtr &element_array, VertexAttributeDataType indices_type, size_t offset, int instance_count)
+	{
+		throw Exception("Instanced drawing is not supported by the software target");
+	}
+
+	void SoftwareGraphicContext::set_scissor(const Rect &rect)
+	{
+		if (!selected_rasterizer || !selected_rasterizer->desc.enable_scissor())
+			throw Exception("RasterizerState must be set with enable_scissor() for clipping to work");
+
+		scissor_rect = rect;
+		scissor_set = true;
+	}
+
+	void SoftwareGraphicContext::reset_scissor()
+	{
+		scissor_set = false;
+	}
+
+	void SoftwareGraphicContext::dispatch(int x, int y, int z)
+	{
+		throw Exception("Compute shaders are not supported by the software target");
+	}
+
+	void SoftwareGraphicContext::clear(const Colorf &color)
+	{
+		SoftwareDrawState state;
+		state.target = draw_target(state.target_bgra);
+		if (!state.target)
+			return;
+
+		state.clip_rect = Rect(Point(0, 0), state.target->size());
+		if (scissor_set && selected_rasterizer && selected_rasterizer->desc.enable_scissor())
+			state.clip_rect.overlap(scissor_rect);
+
+		SoftwareRasterizer::clear(state, color);
+	}
+
+	void SoftwareGraphicContext::set_viewport(const Rectf &new_viewport)
+	{
+		viewport = new_viewport;
+	}
+
+	void SoftwareGraphicContext::set_viewport(int index, const Rectf &new_viewport)
+	{
+		if (index == 0 || index == -1)
+			set_viewport(new_viewport);
+	}
+
+	void SoftwareGraphicContext::on_window_resized()
+	{
+		window_resized_signal(display_window_size());
+	}
+
+	PixelBuffer *SoftwareGraphicContext::draw_target(bool &out_bgra) const
+	{
+		if (_write_frame_buffer)
+		{
+			SoftwareTextureObject *texture = static_cast<SoftwareFrameBuffer*>(_write_frame_buffer.get())->color_texture();
+			out_bgra = false;
+			return texture ? texture->image().get() : nullptr;
+		}
+		else
+		{
+			out_bgra = is_bgra(window_pixels->format());
+			return window_pixels.get();
+		}
+	}
+
+	PixelBufferPtr SoftwareGraphicContext::read_target() const
+	{
+		if (_read_frame_buffer)
+		{
+			SoftwareTextureObject *texture = static_cast<SoftwareFrameBuffer*>(_read_frame_buffer.get())->color_texture();
+			if (!texture)
+				throw Exception("Read frame buffer has no color attachment");
+			return texture->image();
+		}
+		return window_pixels;
+	}
+
+	bool SoftwareGraphicContext::setup_draw_state(SoftwareDrawState &state) const
+	{
+		if (!selected_program || !selected_primitives)
+			return false;
+
+		state.target = draw_target(state.target_bgra);
+		if (!state.target)
+			return false;
+
+		// Pixels outside the viewport are never covered, as clip space ends at its edges
+		state.viewport = viewport;
+		state.clip_rect = Rect(Point(0, 0), state.target->size());
+		state.clip_rect.overlap(Rect((int)std::floor(viewport.left), (int)std::floor(viewport.top), (int)std::ceil(viewport.right), (int)std::ceil(viewport.bottom)));
+
+		const RasterizerStateDescription &rasterizer_desc = selected_rasterizer->desc;
+		if (scissor_set && rasterizer_desc.enable_scissor())
+			state.clip_rect.overlap(scissor_rect);
+
+		if (rasterizer_desc.culled())
+		{
+			bool front_is_ccw = rasterizer_desc.front_face() == face_counter_clockwise;
+			bool cull_front = rasterizer_desc.face_cull_mode() != cull_back;
+			bool cull_back_faces = rasterizer_desc.face_cull_mode() != cull_front;
+			state.cull_counter_clockwise = front_is_ccw ? cull_front : cull_back_faces;
+			state.cull_clockwise = front_is_ccw ? cull_back_faces : cull_front;
+		}
+
+		state.program = static_cast<const SoftwareProgramObject*>(selected_program.get());
+		state.context.primitives = selected_primitives.get();
+		for (int i = 0; i < SoftwareShaderContext::max_textures; i++)
+			state.context.textures[i] = selected_textures[i] ? static_cast<const SoftwareTextureObject*>(selected_textures[i]->texture_object()) : nullptr;
+
+		state.blend = selected_blend.get();
+		state.blend_color = selected_blend_color;
+		return true;
+	}
+
+	void SoftwareGraphicContext::draw_indices(PrimitivesType type)
+	{
+		SoftwareDrawState state;
+		if (setup_draw_state(state))
+			rasterizer.draw(state, type, indices);
+	}
+
+	void SoftwareGraphicContext::read_indices(const ElementArrayBufferPtr &element_array, int count, VertexAttributeDataType indices_type, size_t offset)
+	{
+		if (!element_array)
+			throw Exception("No element array buffer set");
+
+		const SoftwareElementArrayBuffer *buffer = static_cast<const SoftwareElementArrayBuffer*>(element_array.get());
+
+		int index_size = 0;
+		switch (indices_type)
+		{
+		case type_unsigned_byte: index_size = 1; break;
+		case type_unsigned_short: index_size = 2; break;
+		case type_unsigned_int: index_size = 4; break;
+		default: throw Exception("Element indices must be unsigned bytes, shorts or ints");
+		}
+
+		if (count < 0 || offset + (size_t)count * index_size > (size_t)buffer->get_size())
+			throw Exception("Element indices are outside the element array buffer");
+
+		const char *data = buffer->get_data() + offset;
+		indices.resize(count);
+		for (int i = 0; i < count; i++)
+		{
+			switch (indices_type)
+			{
+			default:
+			case type_unsigned_byte: indices[i] = reinterpret_cast<const unsigned char*>(data)[i]; break;
+			case type_unsigned_short: indices[i] = reinterpret_cast<const unsigned short*>(data)[i]; break;
+			case type_unsigned_int: indices[i] = (int)reinterpret_cast<const unsigned int*>(data)[i]; break;
+			}
+		}
+	}
+}
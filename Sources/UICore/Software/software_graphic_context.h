@@ -0,0 +1,182 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include "UICore/Display/Render/graphic_context_impl.h"
+#include "UICore/Display/Image/pixel_buffer.h"
+#include "UICore/Core/Signals/signal.h"
+#include "software_rasterizer.h"
+#include "software_standard_programs.h"
+#include <map>
+#include <vector>
+
+namespace uicore
+{
+	class SoftwareRasterizerState;
+	class SoftwareBlendState;
+	class SoftwarePrimitivesArray;
+
+	/// \brief Graphic context drawing into a pixel buffer on the CPU
+	///
+	/// Follows the Direct3D conventions: the z range of clip space is 0 to w and images are stored top-down.
+	/// Only the standard programs are available, and depth and stencil testing are not performed.
+	class SoftwareGraphicContext : public GraphicContextImpl
+	{
+	public:
+		SoftwareGraphicContext(const PixelBufferPtr &window_pixels);
+		~SoftwareGraphicContext();
+
+		/// \brief Pixel buffer acting as the window frame buffer
+		const PixelBufferPtr &get_window_pixels() const { return window_pixels; }
+		void set_window_pixels(const PixelBufferPtr &pixels);
+
+		void set_num_threads(int count) { rasterizer.set_num_threads(count); }
+
+		int max_attributes() override { return 16; }
+		Size max_texture_size() const override { return Size(16384, 16384); }
+
+		Size display_window_size() const override { return window_pixels->size(); }
+		float pixel_ratio() const override;
+
+		Signal<void(const Size &)> &sig_window_resized() override { return window_resized_signal; }
+
+		FrameBufferPtr write_frame_buffer() const override { return _write_frame_buffer; }
+		FrameBufferPtr read_frame_buffer() const override { return _read_frame_buffer; }
+		ProgramObjectPtr program_object() const override { return selected_program; }
+
+		ClipZRange clip_z_range() const override { return clip_zero_positive_w; }
+		TextureImageYAxis texture_image_y_axis() const override { return y_axis_top_down; }
+		ShaderLanguage shader_language() const override { return shader_software; }
+		int major_version() const override { return 1; }
+		int minor_version() const override { return 0; }
+		bool has_compute_shader_support() const override { return false; }
+		std::shared_ptr<RasterizerState> create_rasterizer_state(const RasterizerStateDescription &desc) override;
+		std::shared_ptr<BlendState> create_blend_state(const BlendStateDescription &desc) override;
+		std::shared_ptr<DepthStencilState> create_depth_stencil_state(const DepthStencilStateDescription &desc) override;
+		std::shared_ptr<ProgramObject> create_program() override;
+		std::shared_ptr<ShaderObject> create_shader(ShaderType type, const std::string &source) override;
+		std::shared_ptr<ShaderObject> create_shader(ShaderType type, const void *bytecode, int bytecode_size) override;
+		std::shared_ptr<OcclusionQuery> create_occlusion_query() override;
+		std::shared_ptr<FrameBuffer> create_frame_buffer() override;
+		std::shared_ptr<RenderBuffer> create_render_buffer(int width, int height, TextureFormat texture_format, int multisample_samples) override;
+		std::shared_ptr<StorageBuffer> create_storage_buffer(int size, int stride, BufferUsage usage) override;
+		std::shared_ptr<StorageBuffer> create_storage_buffer(const void *data, int size, int stride, BufferUsage usage) override;
+		std::shared_ptr<ElementArrayBuffer> create_element_array_buffer(int size, BufferUsage usage) override;
+		std::shared_ptr<ElementArrayBuffer> create_element_array_buffer(const void *data, int size, BufferUsage usage) override;
+		std::shared_ptr<VertexArrayBuffer> create_vertex_array_buffer(int size, BufferUsage usage) override;
+		std::shared_ptr<VertexArrayBuffer> create_vertex_array_buffer(const void *data, int size, BufferUsage usage) override;
+		std::shared_ptr<UniformBuffer> create_uniform_buffer(int size, BufferUsage usage) override;
+		std::shared_ptr<UniformBuffer> create_uniform_buffer(const void *data, int size, BufferUsage usage) override;
+		std::shared_ptr<StagingBuffer> create_staging_buffer(int size, BufferUsage usage) override;
+		std::shared_ptr<StagingBuffer> create_staging_buffer(const void *data, int size, BufferUsage usage) override;
+		std::shared_ptr<PrimitivesArray> create_primitives_array() override;
+		std::shared_ptr<Texture1D> create_texture_1d(int width, TextureFormat texture_format, int levels) override;
+		std::shared_ptr<Texture1DArray> create_texture_1d_array(int width, int array_size, TextureFormat texture_format, int levels) override;
+		std::shared_ptr<Texture2D> create_texture_2d(int width, int height, TextureFormat texture_format, int levels) override;
+		std::shared_ptr<Texture2DArray> create_texture_2d_array(int width, int height, int array_size, TextureFormat texture_format, int levels) override;
+		std::shared_ptr<Texture3D> create_texture_3d(int width, int height, int depth, TextureFormat texture_format, int levels) override;
+		std::shared_ptr<TextureCube> create_texture_cube(int width, int height, TextureFormat texture_format, int levels) override;
+		std::shared_ptr<TextureCubeArray> create_texture_cube_array(int width, int height, int array_size, TextureFormat texture_format, int levels) override;
+		std::shared_ptr<StagingTexture> create_staging_texture(const void *data, const Size &size, StagingDirection direction, TextureFormat new_format, BufferUsage usage) override;
+		void set_rasterizer_state(const RasterizerStatePtr &state) override;
+		void set_blend_state(const BlendStatePtr &state, const Colorf &blend_color, unsigned int sample_mask) override;
+		void set_depth_stencil_state(const DepthStencilStatePtr &state, int stencil_ref) override;
+		std::shared_ptr<PixelBuffer> pixeldata(const Rect& rect, TextureFormat texture_format, bool clamp) const override;
+		bool read_pixels_async(const Rect &rect, const StagingTexturePtr &dest) override;
+		void set_uniform_buffer(int index, const UniformBufferPtr &buffer) override;
+		void set_storage_buffer(int index, const StorageBufferPtr &buffer) override;
+		void set_texture(int unit_index, const TexturePtr &texture) override;
+		void set_image_texture(int unit_index, const TexturePtr &texture) override;
+		bool is_frame_buffer_owner(const FrameBufferPtr &fb) override;
+		void set_frame_buffer(const FrameBufferPtr &write_buffer, const FrameBufferPtr &read_buffer) override;
+		void set_program_object(StandardProgram standard_program) override;
+		void set_program_object(const ProgramObjectPtr &program) override;
+		void set_draw_buffer(DrawBuffer buffer) override { }
+
+		bool is_primitives_array_owner(const PrimitivesArrayPtr &primitives_array) override;
+		void draw_primitives(PrimitivesType type, int num_vertices, const PrimitivesArrayPtr &primitives_array) override;
+		void set_primitives_array(const PrimitivesArrayPtr &primitives_array) override;
+		void draw_primitives_array(PrimitivesType type, int offset, int num_vertices) override;
+		void draw_primitives_array_instanced(PrimitivesType type, int offset, int num_vertices, int instance_count) override;
+		void set_primitives_elements(const ElementArrayBufferPtr &element_array) override;
+		void draw_primitives_elements(PrimitivesType type, int count, VertexAttributeDataType indices_type, size_t offset = 0) override;
+		void draw_primitives_elements_instanced(PrimitivesType type, int count, VertexAttributeDataType indices_type, size_t offset, int instance_count) override;
+		void draw_primitives_elements(PrimitivesType type, int count, const ElementArrayBufferPtr &element_array, VertexAttributeDataType indices_type, size_t offset) override;
+		void draw_primitives_elements_instanced(PrimitivesType type, int count, const ElementArrayBufferPtr &element_array, VertexAttributeDataType indices_type, size_t offset, int instance_count) override;
+		void set_scissor(const Rect &rect) override;
+		void reset_scissor() override;
+		void dispatch(int x, int y, int z) override;
+		void clear(const Colorf &color) override;
+		void clear_depth(float value) override { }
+		void clear_stencil(int value) override { }
+		void set_viewport(const Rectf &viewport) override;
+		void set_viewport(int index, const Rectf &viewport) override;
+		void set_depth_range(int viewport, float n, float f) override { }
+		void on_window_resized() override;
+
+		void flush() override { }
+
+	private:
+		PixelBuffer *draw_target(bool &out_bgra) const;
+		PixelBufferPtr read_target() const;
+		bool setup_draw_state(SoftwareDrawState &state) const;
+		void draw_indices(PrimitivesType type);
+		void read_indices(const ElementArrayBufferPtr &element_array, int count, VertexAttributeDataType indices_type, size_t offset);
+
+		static bool is_bgra(TextureFormat format) { return format == tf_bgra8; }
+
+		PixelBufferPtr window_pixels;
+		Signal<void(const Size &)> window_resized_signal;
+
+		SoftwareRasterizer rasterizer;
+		SoftwareStandardPrograms standard_programs;
+		std::vector<int> indices;
+
+		ProgramObjectPtr selected_program;
+		TexturePtr selected_textures[SoftwareShaderContext::max_textures];
+		std::shared_ptr<SoftwarePrimitivesArray> selected_primitives;
+		ElementArrayBufferPtr selected_elements;
+
+		std::shared_ptr<SoftwareRasterizerState> selected_rasterizer;
+		std::shared_ptr<SoftwareBlendState> selected_blend;
+		Colorf selected_blend_color;
+
+		Rectf viewport;
+		Rect scissor_rect;
+		bool scissor_set = false;
+
+		std::map<RasterizerStateDescription, std::shared_ptr<RasterizerState> > rasterizer_states;
+		std::map<BlendStateDescription, std::shared_ptr<BlendState> > blend_states;
+		std::map<DepthStencilStateDescription, std::shared_ptr<DepthStencilState> > depth_stencil_states;
+
+		FrameBufferPtr _read_frame_buffer;
+		FrameBufferPtr _write_frame_buffer;
+	};
+}
@@ -0,0 +1,158 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "software_program_object.h"
+#include "software_primitives_array.h"
+#include "software_vertex_array_buffer.h"
+#include "UICore/Core/System/exception.h"
+
+namespace uicore
+{
+	namespace
+	{
+		template<typename T, typename Result>
+		void read_components(const char *src, int size, bool normalize, float scale, Result *out)
+		{
+			const T *values = reinterpret_cast<const T*>(src);
+			for (int i = 0; i < size; i++)
+				out[i] = normalize ? static_cast<Result>(values[i] * scale) : static_cast<Result>(values[i]);
+		}
+
+		template<typename Result>
+		bool read_attribute(const SoftwarePrimitivesArray *primitives, int index, int vertex, Result *out)
+		{
+			if (!primitives || index >= (int)primitives->attributes.size() || !primitives->attribute_set[index])
+				return false;
+
+			const PrimitivesArrayImpl::VertexData &data = primitives->attributes[index];
+			bool normalize = primitives->normalize_attributes[index];
+			const SoftwareVertexArrayBuffer *buffer = static_cast<const SoftwareVertexArrayBuffer*>(data.array_provider);
+
+			int size = std::min(data.size, 4);
+			int component_size = 4;
+			switch (data.type)
+			{
+			case type_unsigned_byte: case type_byte: component_size = 1; break;
+			case type_unsigned_short: case type_short: component_size = 2; break;
+			default: break;
+			}
+
+			int stride = data.stride != 0 ? data.stride : component_size * data.size;
+			size_t offset = data.offset + (size_t)stride * vertex;
+			if (offset + component_size * size > (size_t)buffer->get_size())
+				throw Exception("Vertex attribute read past the end of its buffer");
+
+			const char *src = buffer->get_data() + offset;
+			switch (data.type)
+			{
+			case type_unsigned_byte: read_components<unsigned char>(src, size, normalize, 1.0f / 255.0f, out); break;
+			case type_unsigned_short: read_components<unsigned short>(src, size, normalize, 1.0f / 65535.0f, out); break;
+			case type_unsigned_int: read_components<unsigned int>(src, size, normalize, 1.0f / 4294967295.0f, out); break;
+			case type_byte: read_components<signed char>(src, size, normalize, 1.0f / 127.0f, out); break;
+			case type_short: read_components<short>(src, size, normalize, 1.0f / 32767.0f, out); break;
+			case type_int: read_components<int>(src, size, normalize, 1.0f / 2147483647.0f, out); break;
+			case type_float: read_components<float>(src, size, false, 1.0f, out); break;
+			}
+			return true;
+		}
+	}
+
+	Vec4f SoftwareShaderContext::attribute(int index, int vertex) const
+	{
+		Vec4f result(0.0f, 0.0f, 0.0f, 1.0f);
+		read_attribute(primitives, index, vertex, &result.x);
+		return result;
+	}
+
+	Vec4i SoftwareShaderContext::attribute_int(int index, int vertex) const
+	{
+		Vec4i result(0, 0, 0, 1);
+		read_attribute(primitives, index, vertex, &result.x);
+		return result;
+	}
+
+	SoftwareProgramObject::SoftwareProgramObject(std::vector<std::string> attribute_names, std::vector<std::string> uniform_names)
+		: attribute_names(std::move(attribute_names)), uniform_names(std::move(uniform_names))
+	{
+		uniforms.resize(this->uniform_names.size());
+	}
+
+	int SoftwareProgramObject::attribute_location(const std::string &name) const
+	{
+		for (size_t i = 0; i < attribute_names.size(); i++)
+		{
+			if (attribute_names[i] == name)
+				return (int)i;
+		}
+		return -1;
+	}
+
+	int SoftwareProgramObject::uniform_location(const std::string &name) const
+	{
+		for (size_t i = 0; i < uniform_names.size(); i++)
+		{
+			if (uniform_names[i] == name)
+				return (int)i;
+		}
+		return -1;
+	}
+
+	void SoftwareProgramObject::attach(const ShaderObjectPtr &obj)
+	{
+		throw Exception("Shader objects are not supported by the software target");
+	}
+
+	void SoftwareProgramObject::detach(const ShaderObjectPtr &obj)
+	{
+		throw Exception("Shader objects are not supported by the software target");
+	}
+
+	void SoftwareProgramObject::set_uniform4f(int location, float value_a, float value_b, float value_c, float value_d)
+	{
+		if (location >= 0 && location < (int)uniforms.size())
+			uniforms[location] = Vec4f(value_a, value_b, value_c, value_d);
+	}
+
+	void SoftwareProgramObject::set_uniformiv(int location, int size, int count, const int *data)
+	{
+		for (int i = 0; i < count; i++, data += size)
+			set_uniform4f(location + i, (float)data[0], size > 1 ? (float)data[1] : 0.0f, size > 2 ? (float)data[2] : 0.0f, size > 3 ? (float)data[3] : 0.0f);
+	}
+
+	void SoftwareProgramObject::set_uniformfv(int location, int size, int count, const float *data)
+	{
+		for (int i = 0; i < count; i++, data += size)
+			set_uniform4f(location + i, data[0], size > 1 ? data[1] : 0.0f, size > 2 ? data[2] : 0.0f, size > 3 ? data[3] : 0.0f);
+	}
+
+	void SoftwareProgramObject::set_uniform_matrix(int location, int size, int count, bool transpose, const float *data)
+	{
+		throw Exception("Matrix uniforms are not used by the standard programs of the software target");
+	}
+}
@@ -0,0 +1,146 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Display/Render/program_object_impl.h"
+#include "UICore/Core/Math/vec4.h"
+#include "software_float4.h"
+#include <vector>
+#include <string>
+
+namespace uicore
+{
+	class SoftwarePrimitivesArray;
+	class SoftwareTextureObject;
+
+	/// \brief Vertex attributes and textures available to the shading functions of a draw call
+	class SoftwareShaderContext
+	{
+	public:
+		static const int max_textures = 16;
+
+		/// \brief Reads a vertex attribute as floats. Missing components default to (0, 0, 0, 1)
+		Vec4f attribute(int index, int vertex) const;
+
+		/// \brief Reads an integer vertex attribute without conversion. Missing components default to (0, 0, 0, 1)
+		Vec4i attribute_int(int index, int vertex) const;
+
+		const SoftwarePrimitivesArray *primitives = nullptr;
+		const SoftwareTextureObject *textures[max_textures] = {};
+	};
+
+	/// \brief Output of the vertex shading function
+	class SoftwareVertex
+	{
+	public:
+		static const int max_varyings = 6;
+
+		Vec4f position;	// Clip space position, like gl_Position
+		Vec4f varyings[max_varyings];
+	};
+
+	/// \brief A horizontal run of pixels inside a primitive, handed to the fragment shading function
+	class SoftwareSpan
+	{
+	public:
+		static const int max_length = 64;
+
+		int x = 0;
+		int y = 0;
+		int length = 0;
+		SoftwareFloat4 varyings[SoftwareVertex::max_varyings];	// Values at the center of the first pixel
+		SoftwareFloat4 steps[SoftwareVertex::max_varyings];	// Change from one pixel to the next
+	};
+
+	/// \brief Program object with its shaders written as C++ functions
+	///
+	/// Only the standard programs exist in the software target, as there is no shader compiler.
+	class SoftwareProgramObject : public ProgramObjectImpl
+	{
+	public:
+		/// \brief Number of varyings written by shade_vertex
+		virtual int num_varyings() const = 0;
+
+		/// \brief Bit mask of the varyings taken from the last vertex of a primitive, like flat varyings in GLSL
+		virtual unsigned int flat_varyings() const { return 0; }
+
+		/// \brief Vertex shading function
+		virtual void shade_vertex(const SoftwareShaderContext &context, int vertex, SoftwareVertex &out_vertex) const = 0;
+
+		/// \brief Fragment shading function, writing the color of every pixel in the span
+		virtual void shade_span(const SoftwareShaderContext &context, const SoftwareSpan &span, SoftwareFloat4 *out_colors) const = 0;
+
+		std::string info_log() const override { return std::string(); }
+		std::vector<ShaderObjectPtr> shaders() const override { return std::vector<ShaderObjectPtr>(); }
+		int attribute_location(const std::string &name) const override;
+		int uniform_location(const std::string &name) const override;
+
+		using ProgramObject::uniform_buffer_size;
+		int uniform_buffer_size(int block_index) const override { return 0; }
+		using ProgramObject::uniform_buffer_index;
+		int uniform_buffer_index(const std::string &block_name) const override { return -1; }
+		using ProgramObject::storage_buffer_index;
+		int storage_buffer_index(const std::string &name) const override { return -1; }
+
+		void attach(const ShaderObjectPtr &obj) override;
+		void detach(const ShaderObjectPtr &obj) override;
+		void bind_attribute_location(int index, const std::string &name) override { }
+		void bind_frag_data_location(int color_number, const std::string &name) override { }
+		bool try_link() override { return true; }
+		bool validate() override { return true; }
+
+		void set_uniform1i(int location, int value_a) override { set_uniform4f(location, (float)value_a, 0.0f, 0.0f, 0.0f); }
+		void set_uniform2i(int location, int value_a, int value_b) override { set_uniform4f(location, (float)value_a, (float)value_b, 0.0f, 0.0f); }
+		void set_uniform3i(int location, int value_a, int value_b, int value_c) override { set_uniform4f(location, (float)value_a, (float)value_b, (float)value_c, 0.0f); }
+		void set_uniform4i(int location, int value_a, int value_b, int value_c, int value_d) override { set_uniform4f(location, (float)value_a, (float)value_b, (float)value_c, (float)value_d); }
+		void set_uniformiv(int location, int size, int count, const int *data) override;
+		void set_uniform1f(int location, float value_a) override { set_uniform4f(location, value_a, 0.0f, 0.0f, 0.0f); }
+		void set_uniform2f(int location, float value_a, float value_b) override { set_uniform4f(location, value_a, value_b, 0.0f, 0.0f); }
+		void set_uniform3f(int location, float value_a, float value_b, float value_c) override { set_uniform4f(location, value_a, value_b, value_c, 0.0f); }
+		void set_uniform4f(int location, float value_a, float value_b, float value_c, float value_d) override;
+		void set_uniformfv(int location, int size, int count, const float *data) override;
+		void set_uniform_matrix(int location, int size, int count, bool transpose, const float *data) override;
+
+		using ProgramObject::set_uniform_buffer_index;
+		void set_uniform_buffer_index(int block_index, int bind_index) override { }
+		using ProgramObject::set_storage_buffer_index;
+		void set_storage_buffer_index(int buffer_index, int bind_unit_index) override { }
+
+	protected:
+		/// \brief Constructs the program with the names of its attributes and uniforms, in location order
+		SoftwareProgramObject(std::vector<std::string> attribute_names, std::vector<std::string> uniform_names);
+
+		const Vec4f &uniform(int location) const { return uniforms[location]; }
+
+	private:
+		std::vector<std::string> attribute_names;
+		std::vector<std::string> uniform_names;
+		std::vector<Vec4f> uniforms;
+	};
+}
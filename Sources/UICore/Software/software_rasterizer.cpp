@@ -0,0 +1,594 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "software_rasterizer.h"
+#include "software_render_state.h"
+#include "UICore/Display/Image/pixel_buffer.h"
+#include "UICore/Display/2D/path_raster_threads.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace uicore
+{
+	namespace
+	{
+		const int subpixel_bits = 8;
+		const int64_t subpixel_scale = 1 << subpixel_bits;
+		const int64_t subpixel_half = subpixel_scale / 2;
+
+		// Triangles reaching further out than this are dropped, which keeps the fixed point edge functions within 64 bits
+		const float guard_band = 1 << 20;
+
+		// Draws covering fewer pixels than this are not worth waking up the worker threads for
+		const int64_t min_threaded_area = 128 * 128;
+
+		inline int64_t floor_div(int64_t a, int64_t b)
+		{
+			return a >= 0 ? a / b : -((-a + b - 1) / b);
+		}
+
+		inline int64_t ceil_div(int64_t a, int64_t b)
+		{
+			return -floor_div(-a, b);
+		}
+
+		inline int clamp_to_int(int64_t value, int min_value, int max_value)
+		{
+			return static_cast<int>(std::max<int64_t>(std::min<int64_t>(value, max_value), min_value));
+		}
+
+		inline SoftwareFloat4 blend_factor(BlendFunc func, const SoftwareFloat4 &src, const SoftwareFloat4 &dest, const SoftwareFloat4 &constant)
+		{
+			const SoftwareFloat4 one = SoftwareFloat4::splat(1.0f);
+			switch (func)
+			{
+			default:
+			case blend_zero: return SoftwareFloat4::splat(0.0f);
+			case blend_one: return one;
+			case blend_dest_color: return dest;
+			case blend_src_color: return src;
+			case blend_one_minus_dest_color: return one - dest;
+			case blend_one_minus_src_color: return one - src;
+			case blend_src_alpha: return src.splat_w();
+			case blend_one_minus_src_alpha: return one - src.splat_w();
+			case blend_dest_alpha: return dest.splat_w();
+			case blend_one_minus_dest_alpha: return one - dest.splat_w();
+			case blend_src_alpha_saturate:
+			{
+				float f = std::min(src.w(), 1.0f - dest.w());
+				return SoftwareFloat4(f, f, f, 1.0f);
+			}
+			case blend_constant_color: return constant;
+			case blend_one_minus_constant_color: return one - constant;
+			case blend_constant_alpha: return constant.splat_w();
+			case blend_one_minus_constant_alpha: return one - constant.splat_w();
+			}
+		}
+
+		inline SoftwareFloat4 blend_equation(BlendEquation equation, const SoftwareFloat4 &src, const SoftwareFloat4 &src_factor, const SoftwareFloat4 &dest, const SoftwareFloat4 &dest_factor)
+		{
+			switch (equation)
+			{
+			default:
+			case equation_add: return src * src_factor + dest * dest_factor;
+			case equation_subtract: return src * src_factor - dest * dest_factor;
+			case equation_reverse_subtract: return dest * dest_factor - src * src_factor;
+			case equation_min: return SoftwareFloat4::min(src, dest);
+			case equation_max: return SoftwareFloat4::max(src, dest);
+			}
+		}
+	}
+
+	int SoftwareRasterizer::get_num_threads() const
+	{
+		if (num_threads > 0)
+			return num_threads;
+		return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+	}
+
+	void SoftwareRasterizer::draw(const SoftwareDrawState &state, PrimitivesType type, const std::vector<int> &indices)
+	{
+		if (!state.program || !state.target || indices.empty() || state.clip_rect.width() <= 0 || state.clip_rect.height() <= 0)
+			return;
+
+		shade_vertices(state, indices);
+
+		triangles.clear();
+		triangle_varyings.clear();
+		lines.clear();
+		covered_area = 0;
+
+		int num_tiles = (state.target->height() + tile_height - 1) / tile_height;
+		if ((int)tiles.size() < num_tiles)
+			tiles.resize(num_tiles);
+		for (auto &tile : tiles)
+			tile.clear();
+
+		size_t count = indices.size();
+		switch (type)
+		{
+		case type_triangles:
+			for (size_t i = 0; i + 2 < count; i += 3)
+				setup_triangle(state, indices[i], indices[i + 1], indices[i + 2]);
+			break;
+		case type_triangle_strip:
+			for (size_t i = 0; i + 2 < count; i++)
+			{
+				if (i % 2 == 0)
+					setup_triangle(state, indices[i], indices[i + 1], indices[i + 2]);
+				else
+					setup_triangle(state, indices[i + 1], indices[i], indices[i + 2]);
+			}
+			break;
+		case type_triangle_fan:
+			for (size_t i = 1; i + 1 < count; i++)
+				setup_triangle(state, indices[0], indices[i], indices[i + 1]);
+			break;
+		case type_lines:
+			for (size_t i = 0; i + 1 < count; i += 2)
+				setup_line(state, indices[i], indices[i + 1]);
+			break;
+		case type_line_strip:
+			for (size_t i = 0; i + 1 < count; i++)
+				setup_line(state, indices[i], indices[i + 1]);
+			break;
+		case type_line_loop:
+			for (size_t i = 0; i + 1 < count; i++)
+				setup_line(state, indices[i], indices[i + 1]);
+			if (count > 2)
+				setup_line(state, indices[count - 1], indices[0]);
+			break;
+		case type_points:
+			for (size_t i = 0; i < count; i++)
+				setup_point(state, indices[i]);
+			break;
+		}
+
+		std::vector<int> used_tiles;
+		for (int i = 0; i < num_tiles; i++)
+		{
+			if (!tiles[i].empty())
+				used_tiles.push_back(i);
+		}
+
+		int threads = covered_area >= min_threaded_area ? get_num_threads() : 1;
+		if (threads <= 1 || used_tiles.size() <= 1)
+		{
+			for (int tile : used_tiles)
+				draw_tile(state, tile);
+		}
+		else
+		{
+			PathRasterThreads::instance().run(threads, (int)used_tiles.size(), [&](int task_index, int thread_index)
+			{
+				draw_tile(state, used_tiles[task_index]);
+			});
+		}
+	}
+
+	void SoftwareRasterizer::shade_vertices(const SoftwareDrawState &state, const std::vector<int> &indices)
+	{
+		auto range = std::minmax_element(indices.begin(), indices.end());
+		first_index = *range.first;
+		int num_vertices = *range.second - first_index + 1;
+
+		vertices.resize(num_vertices);
+		screen_positions.resize(num_vertices);
+
+		const Rectf &viewport = state.viewport;
+		for (int i = 0; i < num_vertices; i++)
+		{
+			SoftwareVertex &vertex = vertices[i];
+			state.program->shade_vertex(state.context, first_index + i, vertex);
+
+			// Vertices behind the viewer get a position outside the guard band, dropping their primitives
+			const Vec4f &pos = vertex.position;
+			if (pos.w > 0.0f)
+			{
+				float rcp_w = 1.0f / pos.w;
+				screen_positions[i].x = viewport.left + (pos.x * rcp_w * 0.5f + 0.5f) * viewport.width();
+				screen_positions[i].y = viewport.top + (0.5f - pos.y * rcp_w * 0.5f) * viewport.height();
+			}
+			else
+			{
+				screen_positions[i] = Pointf(guard_band * 2.0f, guard_band * 2.0f);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::bin(int y0, int y1, int primitive)
+	{
+		for (int tile = y0 / tile_height; tile <= (y1 - 1) / tile_height; tile++)
+			tiles[tile].push_back(primitive);
+	}
+
+	void SoftwareRasterizer::setup_triangle(const SoftwareDrawState &state, int i0, int i1, int i2)
+	{
+		int vertex_index[3] = { i0 - first_index, i1 - first_index, i2 - first_index };
+
+		int64_t x[3], y[3];
+		for (int i = 0; i < 3; i++)
+		{
+			const Pointf &pos = screen_positions[vertex_index[i]];
+			if (!(std::abs(pos.x) < guard_band && std::abs(pos.y) < guard_band))	// Also catches NaN
+				return;
+			x[i] = static_cast<int64_t>(std::floor(pos.x * subpixel_scale + 0.5f));
+			y[i] = static_cast<int64_t>(std::floor(pos.y * subpixel_scale + 0.5f));
+		}
+
+		// Positive area is counter-clockwise in normalized device coordinates, as the y axis is flipped on the way to the window
+		int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		if (area == 0)
+			return;
+		if ((area > 0 && state.cull_counter_clockwise) || (area < 0 && state.cull_clockwise))
+			return;
+
+		int order[3] = { 0, 1, 2 };
+		if (area < 0)
+		{
+			std::swap(order[1], order[2]);
+			area = -area;
+		}
+
+		const Rect &clip = state.clip_rect;
+		int64_t min_x = std::min(std::min(x[0], x[1]), x[2]);
+		int64_t max_x = std::max(std::max(x[0], x[1]), x[2]);
+		int64_t min_y = std::min(std::min(y[0], y[1]), y[2]);
+		int64_t max_y = std::max(std::max(y[0], y[1]), y[2]);
+
+		// Pixels whose centers are inside the bounding box
+		int row0 = clamp_to_int(ceil_div(min_y - subpixel_half, subpixel_scale), clip.top, clip.bottom);
+		int row1 = clamp_to_int(floor_div(max_y - subpixel_half, subpixel_scale) + 1, clip.top, clip.bottom);
+		int column0 = clamp_to_int(ceil_div(min_x - subpixel_half, subpixel_scale), clip.left, clip.right);
+		int column1 = clamp_to_int(floor_div(max_x - subpixel_half, subpixel_scale) + 1, clip.left, clip.right);
+		if (row0 >= row1 || column0 >= column1)
+			return;
+
+		Triangle triangle;
+		for (int e = 0; e < 3; e++)
+		{
+			int a = order[e];
+			int b = order[(e + 1) % 3];
+			triangle.edge_a[e] = y[a] - y[b];
+			triangle.edge_b[e] = x[b] - x[a];
+			triangle.edge_c[e] = -triangle.edge_b[e] * y[a] - triangle.edge_a[e] * x[a];
+
+			// An edge shared by two triangles is seen with opposite signs by each of them, so only one includes its pixels
+			bool inclusive = triangle.edge_a[e] > 0 || (triangle.edge_a[e] == 0 && triangle.edge_b[e] > 0);
+			triangle.edge_threshold[e] = inclusive ? 0 : 1;
+		}
+		triangle.y0 = row0;
+		triangle.y1 = row1;
+
+		// Varying gradients, with the first vertex as origin
+		const SoftwareVertex &v0 = vertices[vertex_index[order[0]]];
+		const SoftwareVertex &v1 = vertices[vertex_index[order[1]]];
+		const SoftwareVertex &v2 = vertices[vertex_index[order[2]]];
+		const SoftwareVertex &provoking = vertices[vertex_index[2]];
+
+		float x0 = x[order[0]] / (float)subpixel_scale;
+		float y0 = y[order[0]] / (float)subpixel_scale;
+		float dx1 = (x[order[1]] - x[order[0]]) / (float)subpixel_scale;
+		float dy1 = (y[order[1]] - y[order[0]]) / (float)subpixel_scale;
+		float dx2 = (x[order[2]] - x[order[0]]) / (float)subpixel_scale;
+		float dy2 = (y[order[2]] - y[order[0]]) / (float)subpixel_scale;
+		SoftwareFloat4 rcp_det = SoftwareFloat4::splat(1.0f / (dx1 * dy2 - dx2 * dy1));
+
+		triangle.origin_x = x0;
+		triangle.origin_y = y0;
+		triangle.varyings_offset = (int)triangle_varyings.size();
+
+		int num_varyings = state.program->num_varyings();
+		unsigned int flat = state.program->flat_varyings();
+		for (int i = 0; i < num_varyings; i++)
+		{
+			if (flat & (1 << i))
+			{
+				triangle_varyings.push_back(provoking.varyings[i]);
+				triangle_varyings.push_back(SoftwareFloat4::splat(0.0f));
+				triangle_varyings.push_back(SoftwareFloat4::splat(0.0f));
+			}
+			else
+			{
+				SoftwareFloat4 f0 = v0.varyings[i];
+				SoftwareFloat4 d1 = SoftwareFloat4(v1.varyings[i]) - f0;
+				SoftwareFloat4 d2 = SoftwareFloat4(v2.varyings[i]) - f0;
+				triangle_varyings.push_back(f0);
+				triangle_varyings.push_back((d1 * SoftwareFloat4::splat(dy2) - d2 * SoftwareFloat4::splat(dy1)) * rcp_det);
+				triangle_varyings.push_back((d2 * SoftwareFloat4::splat(dx1) - d1 * SoftwareFloat4::splat(dx2)) * rcp_det);
+			}
+		}
+
+		covered_area += (int64_t)(row1 - row0) * (column1 - column0);
+		triangles.push_back(triangle);
+		bin(row0, row1, (int)triangles.size() - 1);
+	}
+
+	void SoftwareRasterizer::setup_line(const SoftwareDrawState &state, int i0, int i1)
+	{
+		const Pointf &a = screen_positions[i0 - first_index];
+		const Pointf &b = screen_positions[i1 - first_index];
+		if (!(std::abs(a.x) < guard_band && std::abs(a.y) < guard_band && std::abs(b.x) < guard_band && std::abs(b.y) < guard_band))
+			return;
+
+		const Rect &clip = state.clip_rect;
+		LinePoint line;
+		line.point = false;
+		line.v0 = i0 - first_index;
+		line.v1 = i1 - first_index;
+		line.y0 = clamp((int)std::floor(std::min(a.y, b.y)), clip.top, clip.bottom);
+		line.y1 = clamp((int)std::floor(std::max(a.y, b.y)) + 1, clip.top, clip.bottom);
+		if (line.y0 >= line.y1)
+			return;
+
+		covered_area += (int64_t)std::ceil(std::max(std::abs(b.x - a.x), std::abs(b.y - a.y)));
+		lines.push_back(line);
+		bin(line.y0, line.y1, -1 - ((int)lines.size() - 1));
+	}
+
+	void SoftwareRasterizer::setup_point(const SoftwareDrawState &state, int i0)
+	{
+		const Pointf &pos = screen_positions[i0 - first_index];
+		if (!(std::abs(pos.x) < guard_band && std::abs(pos.y) < guard_band))
+			return;
+
+		int y = (int)std::floor(pos.y);
+		if (y < state.clip_rect.top || y >= state.clip_rect.bottom)
+			return;
+
+		LinePoint point;
+		point.point = true;
+		point.v0 = i0 - first_index;
+		point.v1 = point.v0;
+		point.y0 = y;
+		point.y1 = y + 1;
+
+		covered_area++;
+		lines.push_back(point);
+		bin(point.y0, point.y1, -1 - ((int)lines.size() - 1));
+	}
+
+	void SoftwareRasterizer::draw_tile(const SoftwareDrawState &state, int tile)
+	{
+		int y0 = tile * tile_height;
+		int y1 = y0 + tile_height;
+
+		// Primitives are drawn in submission order, as blending depends on it
+		for (int primitive : tiles[tile])
+		{
+			if (primitive >= 0)
+				draw_triangle_rows(state, triangles[primitive], y0, y1);
+			else
+				draw_line(state, lines[-1 - primitive], y0, y1);
+		}
+	}
+
+	void SoftwareRasterizer::draw_triangle_rows(const SoftwareDrawState &state, const Triangle &triangle, int y0, int y1)
+	{
+		const Rect &clip = state.clip_rect;
+		int num_varyings = state.program->num_varyings();
+		const SoftwareFloat4 *varyings = triangle_varyings.data() + triangle.varyings_offset;
+
+		SoftwareSpan span;
+		for (int y = std::max(triangle.y0, y0); y < std::min(triangle.y1, y1); y++)
+		{
+			int64_t pixel_y = y * subpixel_scale + subpixel_half;
+			int x0 = clip.left;
+			int x1 = clip.right;
+			for (int e = 0; e < 3; e++)
+			{
+				// Solve edge_a * pixel_x + k >= threshold for the pixel centers
+				int64_t a = triangle.edge_a[e];
+				int64_t k = triangle.edge_b[e] * pixel_y + triangle.edge_c[e];
+				int64_t threshold = triangle.edge_threshold[e];
+				if (a > 0)
+				{
+					int64_t min_pixel_x = ceil_div(threshold - k, a);
+					x0 = std::max(x0, clamp_to_int(ceil_div(min_pixel_x - subpixel_half, subpixel_scale), clip.left, clip.right));
+				}
+				else if (a < 0)
+				{
+					int64_t max_pixel_x = floor_div(k - threshold, -a);
+					x1 = std::min(x1, clamp_to_int(floor_div(max_pixel_x - subpixel_half, subpixel_scale) + 1, clip.left, clip.right));
+				}
+				else if (k < threshold)
+				{
+					x1 = x0;
+				}
+			}
+
+			SoftwareFloat4 center_y = SoftwareFloat4::splat(y + 0.5f - triangle.origin_y);
+			for (int x = x0; x < x1; x += SoftwareSpan::max_length)
+			{
+				span.x = x;
+				span.y = y;
+				span.length = std::min(x1 - x, (int)SoftwareSpan::max_length);
+
+				SoftwareFloat4 center_x = SoftwareFloat4::splat(x + 0.5f - triangle.origin_x);
+				for (int i = 0; i < num_varyings; i++)
+				{
+					const SoftwareFloat4 *plane = varyings + i * 3;
+					span.varyings[i] = plane[0] + plane[1] * center_x + plane[2] * center_y;
+					span.steps[i] = plane[1];
+				}
+
+				draw_span(state, span);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::draw_line(const SoftwareDrawState &state, const LinePoint &line, int y0, int y1)
+	{
+		const Rect &clip = state.clip_rect;
+		int num_varyings = state.program->num_varyings();
+		unsigned int flat = state.program->flat_varyings();
+		const SoftwareVertex &v0 = vertices[line.v0];
+		const SoftwareVertex &v1 = vertices[line.v1];
+
+		SoftwareSpan span;
+		span.length = 1;
+		for (int i = 0; i < num_varyings; i++)
+			span.steps[i] = SoftwareFloat4::splat(0.0f);
+
+		if (line.point)
+		{
+			const Pointf &pos = screen_positions[line.v0];
+			span.x = (int)std::floor(pos.x);
+			span.y = line.y0;
+			if (span.x < clip.left || span.x >= clip.right || span.y < y0 || span.y >= y1)
+				return;
+			for (int i = 0; i < num_varyings; i++)
+				span.varyings[i] = v0.varyings[i];
+			draw_span(state, span);
+			return;
+		}
+
+		// One pixel per step along the major axis, leaving out the last pixel like OpenGL does
+		const Pointf &a = screen_positions[line.v0];
+		const Pointf &b = screen_positions[line.v1];
+		float dx = b.x - a.x;
+		float dy = b.y - a.y;
+		int steps = (int)std::ceil(std::max(std::abs(dx), std::abs(dy)));
+		for (int step = 0; step < steps; step++)
+		{
+			float t = (step + 0.5f) / steps;
+			span.x = (int)std::floor(a.x + dx * t);
+			span.y = (int)std::floor(a.y + dy * t);
+			if (span.x < clip.left || span.x >= clip.right || span.y < std::max(y0, line.y0) || span.y >= std::min(y1, line.y1))
+				continue;
+
+			SoftwareFloat4 tt = SoftwareFloat4::splat(t);
+			for (int i = 0; i < num_varyings; i++)
+				span.varyings[i] = (flat & (1 << i)) ? SoftwareFloat4(v1.varyings[i]) : SoftwareFloat4::mix(v0.varyings[i], v1.varyings[i], tt);
+			draw_span(state, span);
+		}
+	}
+
+	void SoftwareRasterizer::draw_span(const SoftwareDrawState &state, SoftwareSpan &span)
+	{
+		SoftwareFloat4 colors[SoftwareSpan::max_length];
+		state.program->shade_span(state.context, span, colors);
+		blend_span(state, colors, state.target->line_uint32(span.y) + span.x, span.length);
+	}
+
+	void SoftwareRasterizer::blend_span(const SoftwareDrawState &state, const SoftwareFloat4 *src, unsigned int *dest, int length)
+	{
+		const SoftwareBlendState *blend = state.blend;
+		bool bgra = state.target_bgra;
+		const SoftwareFloat4 one = SoftwareFloat4::splat(1.0f);
+
+		switch (blend->mode)
+		{
+		case SoftwareBlendState::Mode::opaque:
+			for (int i = 0; i < length; i++)
+				dest[i] = (bgra ? src[i].swap_xz() : src[i]).pack();
+			break;
+
+		case SoftwareBlendState::Mode::alpha:
+			for (int i = 0; i < length; i++)
+			{
+				SoftwareFloat4 s = bgra ? src[i].swap_xz() : src[i];
+				float alpha = s.w();
+				if (alpha <= 0.0f)
+					continue;
+				if (alpha >= 1.0f)
+				{
+					dest[i] = s.pack();
+					continue;
+				}
+				SoftwareFloat4 s_alpha = s.splat_w();
+				SoftwareFloat4 d = SoftwareFloat4::unpack(dest[i]);
+				dest[i] = ((s * s_alpha).with_w(s) + d * (one - s_alpha)).pack();
+			}
+			break;
+
+		case SoftwareBlendState::Mode::premultiplied_alpha:
+			for (int i = 0; i < length; i++)
+			{
+				SoftwareFloat4 s = bgra ? src[i].swap_xz() : src[i];
+				float alpha = s.w();
+				if (alpha >= 1.0f)
+				{
+					dest[i] = s.pack();
+					continue;
+				}
+				if (s.pack() == 0)	// Nothing would change, as with the zero coverage parts of path masks
+					continue;
+				SoftwareFloat4 d = SoftwareFloat4::unpack(dest[i]);
+				dest[i] = (s + d * (one - s.splat_w())).pack();
+			}
+			break;
+
+		case SoftwareBlendState::Mode::generic:
+		{
+			SoftwareFloat4 constant(state.blend_color.x, state.blend_color.y, state.blend_color.z, state.blend_color.w);
+			SoftwareFloat4 write_mask(blend->write_red ? 1.0f : 0.0f, blend->write_green ? 1.0f : 0.0f, blend->write_blue ? 1.0f : 0.0f, blend->write_alpha ? 1.0f : 0.0f);
+			if (bgra)
+			{
+				constant = constant.swap_xz();
+				write_mask = write_mask.swap_xz();
+			}
+
+			bool same_factors = blend->src == blend->src_alpha && blend->dest == blend->dest_alpha && blend->equation_color == blend->equation_alpha;
+			for (int i = 0; i < length; i++)
+			{
+				SoftwareFloat4 s = bgra ? src[i].swap_xz() : src[i];
+				SoftwareFloat4 d = SoftwareFloat4::unpack(dest[i]);
+
+				SoftwareFloat4 result = blend_equation(blend->equation_color, s, blend_factor(blend->src, s, d, constant), d, blend_factor(blend->dest, s, d, constant));
+				if (!same_factors)
+				{
+					SoftwareFloat4 result_alpha = blend_equation(blend->equation_alpha, s, blend_factor(blend->src_alpha, s, d, constant), d, blend_factor(blend->dest_alpha, s, d, constant));
+					result = result.with_w(result_alpha);
+				}
+
+				if (!blend->write_all)
+					result = d + (result - d) * write_mask;
+
+				dest[i] = result.pack();
+			}
+			break;
+		}
+		}
+	}
+
+	void SoftwareRasterizer::clear(const SoftwareDrawState &state, const Colorf &color)
+	{
+		SoftwareFloat4 value(color.x, color.y, color.z, color.w);
+		unsigned int pixel = (state.target_bgra ? value.swap_xz() : value).pack();
+
+		const Rect &clip = state.clip_rect;
+		for (int y = clip.top; y < clip.bottom; y++)
+		{
+			unsigned int *line = state.target->line_uint32(y);
+			std::fill(line + clip.left, line + clip.right, pixel);
+		}
+	}
+}
@@ -0,0 +1,124 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Display/Render/graphic_context.h"
+#include "UICore/Core/Math/rect.h"
+#include "software_program_object.h"
+#include "software_float4.h"
+#include <vector>
+#include <cstdint>
+
+namespace uicore
+{
+	class PixelBuffer;
+	class SoftwareBlendState;
+
+	/// \brief Everything a draw call needs besides its vertices
+	class SoftwareDrawState
+	{
+	public:
+		PixelBuffer *target = nullptr;	// tf_rgba8, tf_srgb8_alpha8 or tf_bgra8 color buffer
+		bool target_bgra = false;
+		Rect clip_rect;	// Viewport, scissor and target bounds combined
+		Rectf viewport;
+
+		const SoftwareProgramObject *program = nullptr;
+		SoftwareShaderContext context;
+
+		const SoftwareBlendState *blend = nullptr;
+		Colorf blend_color;
+
+		bool cull_clockwise = false;	// Cull triangles that are clockwise in normalized device coordinates
+		bool cull_counter_clockwise = false;
+	};
+
+	/// \brief Draws primitives into a color buffer
+	///
+	/// The vertices of a draw call are shaded first, then its primitives are binned by horizontal tiles
+	/// of the color buffer. Each tile is rasterized by one thread, so no two threads ever touch the same
+	/// pixel and the result does not depend on the number of threads.
+	class SoftwareRasterizer
+	{
+	public:
+		/// \brief Sets the number of threads rasterizing tiles. Zero uses one thread per core
+		void set_num_threads(int count) { num_threads = count; }
+		int get_num_threads() const;
+
+		/// \brief Draws primitives using the vertices in the order listed by indices
+		void draw(const SoftwareDrawState &state, PrimitivesType type, const std::vector<int> &indices);
+
+		/// \brief Fills the clip rect of the state with a color
+		static void clear(const SoftwareDrawState &state, const Colorf &color);
+
+		static const int tile_height = 32;
+
+	private:
+		struct Triangle
+		{
+			int64_t edge_a[3], edge_b[3], edge_c[3];
+			int64_t edge_threshold[3];	// Top-left fill convention: 0 includes pixels exactly on the edge, 1 excludes them
+			int y0, y1;
+			float origin_x, origin_y;	// Position of the first vertex, where varyings[] is taken
+			int varyings_offset;	// Index into triangle_varyings of value, ddx and ddy per varying
+		};
+
+		struct LinePoint
+		{
+			bool point;
+			int v0, v1;	// Indices into vertices; v1 is unused for points
+			int y0, y1;
+		};
+
+		void shade_vertices(const SoftwareDrawState &state, const std::vector<int> &indices);
+		void setup_triangle(const SoftwareDrawState &state, int i0, int i1, int i2);
+		void setup_line(const SoftwareDrawState &state, int i0, int i1);
+		void setup_point(const SoftwareDrawState &state, int i0);
+		void bin(int y0, int y1, int primitive);
+		void draw_tile(const SoftwareDrawState &state, int tile);
+		void draw_triangle_rows(const SoftwareDrawState &state, const Triangle &triangle, int y0, int y1);
+		void draw_line(const SoftwareDrawState &state, const LinePoint &line, int y0, int y1);
+		static void draw_span(const SoftwareDrawState &state, SoftwareSpan &span);
+		static void blend_span(const SoftwareDrawState &state, const SoftwareFloat4 *src, unsigned int *dest, int length);
+
+		int num_threads = 0;
+
+		std::vector<SoftwareVertex> vertices;	// Shaded vertices, from lowest index to highest
+		std::vector<Pointf> screen_positions;	// Window positions of the vertices
+		int first_index = 0;
+
+		std::vector<Triangle> triangles;
+		std::vector<SoftwareFloat4> triangle_varyings;
+		std::vector<LinePoint> lines;
+
+		// Primitives per tile. Lines and points are stored as -1 - index into lines
+		std::vector<std::vector<int>> tiles;
+		int64_t covered_area = 0;
+	};
+}
@@ -0,0 +1,62 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "software_render_state.h"
+
+namespace uicore
+{
+	SoftwareBlendState::SoftwareBlendState(const BlendStateDescription &new_desc) : desc(new_desc.clone())
+	{
+		desc.blend_function(src, dest, src_alpha, dest_alpha);
+		desc.blend_equation(equation_color, equation_alpha);
+		desc.color_write(write_red, write_green, write_blue, write_alpha);
+		write_all = write_red && write_green && write_blue && write_alpha;
+
+		bool add = equation_color == equation_add && equation_alpha == equation_add;
+		if (!desc.is_blending_enabled())
+			mode = write_all ? Mode::opaque : Mode::generic;
+		else if (add && write_all && src == blend_src_alpha && dest == blend_one_minus_src_alpha && src_alpha == blend_one && dest_alpha == blend_one_minus_src_alpha)
+			mode = Mode::alpha;
+		else if (add && write_all && src == blend_one && dest == blend_one_minus_src_alpha && src_alpha == blend_one && dest_alpha == blend_one_minus_src_alpha)
+			mode = Mode::premultiplied_alpha;
+		else
+			mode = Mode::generic;
+
+		if (!desc.is_blending_enabled())
+		{
+			// The generic path reduces to a masked copy when blending is off
+			src = blend_one;
+			dest = blend_zero;
+			src_alpha = blend_one;
+			dest_alpha = blend_zero;
+			equation_color = equation_add;
+			equation_alpha = equation_add;
+		}
+	}
+}
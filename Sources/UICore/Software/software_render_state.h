@@ -0,0 +1,73 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Display/Render/graphic_context.h"
+#include "UICore/Display/Render/rasterizer_state_description.h"
+#include "UICore/Display/Render/blend_state_description.h"
+#include "UICore/Display/Render/depth_stencil_state_description.h"
+
+namespace uicore
+{
+	class SoftwareRasterizerState : public RasterizerState
+	{
+	public:
+		SoftwareRasterizerState(const RasterizerStateDescription &desc) : desc(desc.clone()) { }
+		RasterizerStateDescription desc;
+	};
+
+	class SoftwareBlendState : public BlendState
+	{
+	public:
+		SoftwareBlendState(const BlendStateDescription &desc);
+
+		/// \brief Blend setups with their own span loop, everything else goes through the generic blend equation
+		enum class Mode
+		{
+			opaque,	// Blending disabled
+			alpha,	// src_alpha, one_minus_src_alpha for color and one, one_minus_src_alpha for alpha
+			premultiplied_alpha,	// one, one_minus_src_alpha
+			generic
+		};
+
+		BlendStateDescription desc;
+		Mode mode = Mode::opaque;
+		BlendFunc src = blend_one, dest = blend_zero, src_alpha = blend_one, dest_alpha = blend_zero;
+		BlendEquation equation_color = equation_add, equation_alpha = equation_add;
+		bool write_all = true;	// All four channels are written
+		bool write_red = true, write_green = true, write_blue = true, write_alpha = true;
+	};
+
+	class SoftwareDepthStencilState : public DepthStencilState
+	{
+	public:
+		SoftwareDepthStencilState(const DepthStencilStateDescription &desc) : desc(desc.clone()) { }
+		DepthStencilStateDescription desc;
+	};
+}
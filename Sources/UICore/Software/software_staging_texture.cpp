@@ -0,0 +1,59 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "software_staging_texture.h"
+#include "UICore/Core/System/exception.h"
+
+namespace uicore
+{
+	SoftwareStagingTexture::SoftwareStagingTexture(const void *data, const Size &new_size, StagingDirection direction, TextureFormat new_format, BufferUsage usage)
+		: pixels(PixelBuffer::create(new_size.width, new_size.height, new_format, data))
+	{
+	}
+
+	SoftwareStagingTexture::~SoftwareStagingTexture()
+	{
+	}
+
+	void SoftwareStagingTexture::upload_data(const GraphicContextPtr &gc, const Rect &dest_rect, const void *data)
+	{
+		if (dest_rect.left < 0 || dest_rect.top < 0 || dest_rect.right > width() || dest_rect.bottom > height())
+			throw Exception("Rectangle out of bounds");
+
+		// The source rows are tightly packed, as for the other targets
+		int bytes_per_pixel = pixels->bytes_per_pixel();
+		int row_size = dest_rect.width() * bytes_per_pixel;
+		const unsigned char *src = static_cast<const unsigned char*>(data);
+		for (int y = dest_rect.top; y < dest_rect.bottom; y++)
+		{
+			memcpy(pixels->line_uint8(y) + dest_rect.left * bytes_per_pixel, src, row_size);
+			src += row_size;
+		}
+	}
+}
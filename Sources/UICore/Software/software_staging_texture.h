@@ -0,0 +1,60 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Display/Render/staging_texture.h"
+
+namespace uicore
+{
+	/// \brief Staging texture kept in system memory, so it can be written at any time without locking
+	class SoftwareStagingTexture : public StagingTexture
+	{
+	public:
+		SoftwareStagingTexture(const void *data, const Size &new_size, StagingDirection direction, TextureFormat new_format, BufferUsage usage);
+		~SoftwareStagingTexture();
+
+		void *data() override { return pixels->data(); }
+		const void *data() const override { return pixels->data(); }
+		int pitch() const override { return pixels->pitch(); }
+		int width() const override { return pixels->width(); }
+		int height() const override { return pixels->height(); }
+
+		TextureFormat format() const override { return pixels->format(); };
+
+		float pixel_ratio() const override { return pixels->pixel_ratio(); }
+		void set_pixel_ratio(float ratio) override { pixels->set_pixel_ratio(ratio); }
+
+		void lock(const GraphicContextPtr &gc, BufferAccess access) override { }
+		void unlock() override { }
+		void upload_data(const GraphicContextPtr &gc, const Rect &dest_rect, const void *data) override;
+
+	private:
+		PixelBufferPtr pixels;
+	};
+}
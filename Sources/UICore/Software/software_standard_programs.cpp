@@ -0,0 +1,322 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "software_standard_programs.h"
+#include "software_texture_object.h"
+#include "UICore/Core/Math/cl_math.h"
+#include <cmath>
+
+namespace uicore
+{
+	namespace
+	{
+		/// \brief Samples a texture unit, reading unbound units as opaque black like OpenGL does
+		inline SoftwareFloat4 sample_unit(const SoftwareShaderContext &context, int unit, float u, float v)
+		{
+			const SoftwareTextureObject *texture = context.textures[unit];
+			return texture ? texture->sample(u, v) : SoftwareFloat4(0.0f, 0.0f, 0.0f, 1.0f);
+		}
+
+		class ColorOnlyProgram : public SoftwareProgramObject
+		{
+		public:
+			ColorOnlyProgram() : SoftwareProgramObject({ "Position", "Color0" }, {}) { }
+
+			int num_varyings() const override { return 1; }
+
+			void shade_vertex(const SoftwareShaderContext &context, int vertex, SoftwareVertex &out_vertex) const override
+			{
+				out_vertex.position = context.attribute(0, vertex);
+				out_vertex.varyings[0] = context.attribute(1, vertex);
+			}
+
+			void shade_span(const SoftwareShaderContext &context, const SoftwareSpan &span, SoftwareFloat4 *out_colors) const override
+			{
+				SoftwareFloat4 color = span.varyings[0];
+				for (int i = 0; i < span.length; i++)
+				{
+					out_colors[i] = color;
+					color += span.steps[0];
+				}
+			}
+		};
+
+		class SingleTextureProgram : public SoftwareProgramObject
+		{
+		public:
+			SingleTextureProgram() : SoftwareProgramObject({ "Position", "Color0", "TexCoord0" }, { "Texture0" }) { }
+
+			int num_varyings() const override { return 2; }
+
+			void shade_vertex(const SoftwareShaderContext &context, int vertex, SoftwareVertex &out_vertex) const override
+			{
+				out_vertex.position = context.attribute(0, vertex);
+				out_vertex.varyings[0] = context.attribute(1, vertex);
+				out_vertex.varyings[1] = context.attribute(2, vertex);
+			}
+
+			void shade_span(const SoftwareShaderContext &context, const SoftwareSpan &span, SoftwareFloat4 *out_colors) const override
+			{
+				SoftwareFloat4 color = span.varyings[0];
+				Vec4f texcoord = span.varyings[1].to_vec4f();
+				Vec4f texcoord_step = span.steps[1].to_vec4f();
+				for (int i = 0; i < span.length; i++)
+				{
+					out_colors[i] = color * sample_unit(context, 0, texcoord.x, texcoord.y);
+					color += span.steps[0];
+					texcoord.x += texcoord_step.x;
+					texcoord.y += texcoord_step.y;
+				}
+			}
+		};
+
+		class SpriteProgram : public SoftwareProgramObject
+		{
+		public:
+			SpriteProgram() : SoftwareProgramObject({ "Position", "Color0", "TexCoord0", "TexIndex0" },
+				{ "Texture0", "Texture1", "Texture2", "Texture3", "Texture4", "Texture5", "Texture6", "Texture7",
+				"Texture8", "Texture9", "Texture10", "Texture11", "Texture12", "Texture13", "Texture14", "Texture15" }) { }
+
+			int num_varyings() const override { return 3; }
+			unsigned int flat_varyings() const override { return 1 << 2; }
+
+			void shade_vertex(const SoftwareShaderContext &context, int vertex, SoftwareVertex &out_vertex) const override
+			{
+				out_vertex.position = context.attribute(0, vertex);
+				out_vertex.varyings[0] = context.attribute(1, vertex);
+				out_vertex.varyings[1] = context.attribute(2, vertex);
+				out_vertex.varyings[2] = Vec4f((float)context.attribute_int(3, vertex).x, 0.0f, 0.0f, 0.0f);
+			}
+
+			void shade_span(const SoftwareShaderContext &context, const SoftwareSpan &span, SoftwareFloat4 *out_colors) const override
+			{
+				SoftwareFloat4 color = span.varyings[0];
+				int texindex = (int)span.varyings[2].x();
+				if (texindex < 0 || texindex >= SoftwareShaderContext::max_textures || !context.textures[texindex])
+				{
+					// Vertices without a texture multiply the color by white. Solid fills point at the first unused unit
+					for (int i = 0; i < span.length; i++)
+					{
+						out_colors[i] = color;
+						color += span.steps[0];
+					}
+					return;
+				}
+
+				Vec4f texcoord = span.varyings[1].to_vec4f();
+				Vec4f texcoord_step = span.steps[1].to_vec4f();
+				for (int i = 0; i < span.length; i++)
+				{
+					out_colors[i] = color * sample_unit(context, texindex, texcoord.x, texcoord.y);
+					color += span.steps[0];
+					texcoord.x += texcoord_step.x;
+					texcoord.y += texcoord_step.y;
+				}
+			}
+		};
+
+		class PathProgram : public SoftwareProgramObject
+		{
+		public:
+			PathProgram() : SoftwareProgramObject({ "Vertex" }, { "ypos_scale", "mask_texture", "instance_data", "image_texture" }) { }
+
+			// Texture units, as bound by PathFillRenderer
+			enum { mask_unit = 0, instance_unit = 1, image_unit = 2 };
+
+			// Varyings
+			enum { brush_data1, brush_data2, vary_data, mask_position, instance_offset };
+
+			int num_varyings() const override { return 5; }
+			unsigned int flat_varyings() const override { return (1 << brush_data1) | (1 << brush_data2) | (1 << instance_offset); }
+
+			void shade_vertex(const SoftwareShaderContext &context, int vertex, SoftwareVertex &out_vertex) const override
+			{
+				const int mask_block_size = 16;
+				const int mask_width = 1024;
+				const int instance_width = 512;
+
+				const SoftwareTextureObject *instance_data = context.textures[instance_unit];
+				if (!instance_data)
+				{
+					out_vertex.position = Vec4f(0.0f, 0.0f, 0.0f, 1.0f);
+					return;
+				}
+
+				Vec4i v = context.attribute_int(0, vertex);
+				float ypos_scale = uniform(0).x;
+
+				Vec4f canvas_data = instance_data->fetch(0, 0).to_vec4f();
+				int size_x = v.z % 2;
+				int size_y = v.z / 2;
+				float x = (float)(v.x + size_x * mask_block_size);
+				float y = (float)(v.y + size_y * mask_block_size);
+				out_vertex.position = Vec4f(x * 2.0f / canvas_data.x - 1.0f, ypos_scale * (y * -2.0f / canvas_data.y + 1.0f), 0.0f, 1.0f);
+
+				int mask_offset = v.w % 65536;
+				int y_offset = (mask_offset * mask_block_size) / mask_width;
+				out_vertex.varyings[mask_position] = Vec4f(
+					(float)(mask_offset * mask_block_size - y_offset * mask_width + size_x * mask_block_size) / mask_width,
+					(float)(y_offset * mask_block_size + size_y * mask_block_size) / mask_width, 0.0f, 0.0f);
+
+				int instance_block = v.w / 65536;
+				int instance_y = instance_block / instance_width;
+				int instance_x = instance_block - instance_y * instance_width;
+				out_vertex.varyings[instance_offset] = Vec4f((float)instance_x, (float)instance_y, 0.0f, 0.0f);
+
+				Vec4f data1 = instance_data->fetch(instance_x, instance_y).to_vec4f();
+				Vec4f data2 = instance_data->fetch(instance_x + 1, instance_y).to_vec4f();
+				Vec4f data3 = instance_data->fetch(instance_x + 2, instance_y).to_vec4f();
+				out_vertex.varyings[brush_data1] = data1;
+				out_vertex.varyings[brush_data2] = data2;
+
+				// Gradient position relative to its start or center, and image texture position through the inverse transform
+				Vec4f transform_x = data3;
+				Vec4f transform_y = instance_data->fetch(instance_x + 3, instance_y).to_vec4f();
+				Vec4f transform_w = instance_data->fetch(instance_x + 5, instance_y).to_vec4f();
+				Vec4f texture_pos = transform_x * x + transform_y * y + transform_w;
+
+				out_vertex.varyings[vary_data] = Vec4f(
+					x - data3.x,
+					y - data3.y,
+					(texture_pos.x + data1.x) / data2.x,
+					(texture_pos.y + data1.y) / data2.y);
+			}
+
+			void shade_span(const SoftwareShaderContext &context, const SoftwareSpan &span, SoftwareFloat4 *out_colors) const override
+			{
+				const SoftwareTextureObject *mask_texture = context.textures[mask_unit];
+				const SoftwareTextureObject *instance_data = context.textures[instance_unit];
+				if (!mask_texture || !instance_data)
+				{
+					for (int i = 0; i < span.length; i++)
+						out_colors[i] = SoftwareFloat4::splat(0.0f);
+					return;
+				}
+
+				Vec4f data1 = span.varyings[brush_data1].to_vec4f();
+				Vec4f data2 = span.varyings[brush_data2].to_vec4f();
+				Vec4f offset = span.varyings[instance_offset].to_vec4f();
+				Vec4f vary = span.varyings[vary_data].to_vec4f();
+				Vec4f vary_step = span.steps[vary_data].to_vec4f();
+
+				// Pixel centers land exactly on mask texel centers, so the mask is read without filtering
+				Vec4f mask_pos = span.varyings[mask_position].to_vec4f();
+				int mask_x = (int)std::floor(mask_pos.x * mask_texture->width());
+				int mask_y = (int)std::floor(mask_pos.y * mask_texture->height());
+
+				int instance_x = (int)offset.x;
+				int instance_y = (int)offset.y;
+
+				switch ((int)data1.x)
+				{
+				default:
+				case 0:	// Solid
+				{
+					SoftwareFloat4 fill_color(data2);
+					for (int i = 0; i < span.length; i++)
+						out_colors[i] = fill_color * mask_texture->fetch(mask_x + i, mask_y).splat_x();
+					break;
+				}
+				case 1:	// Linear gradient
+				{
+					int stop_start = (int)data2.y;
+					int stop_end = (int)data2.z;
+					for (int i = 0; i < span.length; i++)
+					{
+						float t = (vary.x * data1.z + vary.y * data1.w) * data2.x;
+						out_colors[i] = gradient_color(instance_data, instance_x, instance_y, stop_start, stop_end, t) * mask_texture->fetch(mask_x + i, mask_y).splat_x();
+						vary.x += vary_step.x;
+						vary.y += vary_step.y;
+					}
+					break;
+				}
+				case 2:	// Radial gradient
+				{
+					int stop_start = (int)data2.y;
+					int stop_end = (int)data2.z;
+					for (int i = 0; i < span.length; i++)
+					{
+						float t = std::sqrt(vary.x * vary.x + vary.y * vary.y) * data2.x;
+						out_colors[i] = gradient_color(instance_data, instance_x, instance_y, stop_start, stop_end, t) * mask_texture->fetch(mask_x + i, mask_y).splat_x();
+						vary.x += vary_step.x;
+						vary.y += vary_step.y;
+					}
+					break;
+				}
+				case 3:	// Image
+				{
+					for (int i = 0; i < span.length; i++)
+					{
+						out_colors[i] = sample_unit(context, image_unit, vary.z, vary.w) * mask_texture->fetch(mask_x + i, mask_y).splat_x();
+						vary.z += vary_step.z;
+						vary.w += vary_step.w;
+					}
+					break;
+				}
+				}
+			}
+
+		private:
+			static SoftwareFloat4 gradient_color(const SoftwareTextureObject *instance_data, int instance_x, int instance_y, int stop_start, int stop_end, float t)
+			{
+				SoftwareFloat4 color = instance_data->fetch(instance_x + stop_start, instance_y);
+				float last_stop_pos = instance_data->fetch(instance_x + stop_start + 1, instance_y).x();
+				for (int i = stop_start; i < stop_end; i += 2)
+				{
+					SoftwareFloat4 stop_color = instance_data->fetch(instance_x + i, instance_y);
+					float stop_pos = instance_data->fetch(instance_x + i + 1, instance_y).x();
+					float tt = clamp((t - last_stop_pos) / (stop_pos - last_stop_pos), 0.0f, 1.0f);
+					color = SoftwareFloat4::mix(color, stop_color, SoftwareFloat4::splat(tt));
+					last_stop_pos = stop_pos;
+				}
+				return color;
+			}
+		};
+	}
+
+	SoftwareStandardPrograms::SoftwareStandardPrograms()
+		: color_only_program(std::make_shared<ColorOnlyProgram>()),
+		single_texture_program(std::make_shared<SingleTextureProgram>()),
+		sprite_program(std::make_shared<SpriteProgram>()),
+		path_program(std::make_shared<PathProgram>())
+	{
+	}
+
+	ProgramObjectPtr SoftwareStandardPrograms::get_program_object(StandardProgram standard_program) const
+	{
+		switch (standard_program)
+		{
+		case program_color_only: return color_only_program;
+		case program_single_texture: return single_texture_program;
+		case program_sprite: return sprite_program;
+		case program_path: return path_program;
+		}
+		throw Exception("Unsupported standard program");
+	}
+}
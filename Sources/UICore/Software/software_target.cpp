@@ -0,0 +1,69 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "UICore/Software/software_target.h"
+#include "UICore/Core/System/exception.h"
+#include "software_graphic_context.h"
+
+namespace uicore
+{
+	namespace
+	{
+		SoftwareGraphicContext *software_gc(const GraphicContextPtr &gc)
+		{
+			SoftwareGraphicContext *provider = dynamic_cast<SoftwareGraphicContext*>(gc.get());
+			if (!provider)
+				throw Exception("Graphic context is not a software graphic context");
+			return provider;
+		}
+	}
+
+	GraphicContextPtr SoftwareTarget::create_graphic_context(const PixelBufferPtr &target)
+	{
+		auto gc = std::make_shared<SoftwareGraphicContext>(target);
+		gc->set_default_state();
+		return gc;
+	}
+
+	PixelBufferPtr SoftwareTarget::pixel_buffer(const GraphicContextPtr &gc)
+	{
+		return software_gc(gc)->get_window_pixels();
+	}
+
+	void SoftwareTarget::set_pixel_buffer(const GraphicContextPtr &gc, const PixelBufferPtr &target)
+	{
+		software_gc(gc)->set_window_pixels(target);
+	}
+
+	void SoftwareTarget::set_num_threads(const GraphicContextPtr &gc, int num_threads)
+	{
+		software_gc(gc)->set_num_threads(num_threads);
+	}
+}
@@ -0,0 +1,201 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "software_texture_object.h"
+#include "UICore/Display/Render/texture.h"
+#include "UICore/Core/System/exception.h"
+#include "UICore/Core/Math/cl_math.h"
+#include <cmath>
+
+namespace uicore
+{
+	SoftwareTextureObject::SoftwareTextureObject(InitData, TextureDimensions texture_dimensions, int width, int height, int depth, int array_size, TextureFormat texture_format, int levels)
+		: dimensions(width, height, depth, array_size), pixels_format(storage_format(texture_format))
+	{
+		if (texture_dimensions != texture_2d)
+			throw Exception("Only 2D textures are supported by the software target");
+
+		if (width < 1 || height < 1)
+			throw Exception("Invalid texture size in the software target");
+
+		allocate(width, height);
+	}
+
+	SoftwareTextureObject::~SoftwareTextureObject()
+	{
+	}
+
+	void SoftwareTextureObject::allocate(int width, int height)
+	{
+		dimensions.x = width;
+		dimensions.y = height;
+		pixels = PixelBuffer::create(width, height, pixels_format);
+		memset(pixels->data(), 0, pixels->pitch() * height);
+		pixels_data = pixels->data_uint8();
+		pixels_pitch = pixels->pitch();
+	}
+
+	TextureFormat SoftwareTextureObject::storage_format(TextureFormat texture_format)
+	{
+		switch (texture_format)
+		{
+		case tf_r8:
+			return tf_r8;
+		case tf_rgba32f:
+			return tf_rgba32f;
+		default:
+			return tf_rgba8;
+		}
+	}
+
+	SoftwareFloat4 SoftwareTextureObject::sample(float u, float v) const
+	{
+		// Keep the coordinates in a range where the conversions to int cannot overflow
+		float fx = clamp(u * dimensions.x, -16777216.0f, 16777216.0f);
+		float fy = clamp(v * dimensions.y, -16777216.0f, 16777216.0f);
+
+		if (mag_filter == filter_nearest || mag_filter == filter_nearest_mipmap_nearest || mag_filter == filter_nearest_mipmap_linear)
+		{
+			int x = wrap(static_cast<int>(std::floor(fx)), dimensions.x, wrap_s);
+			int y = wrap(static_cast<int>(std::floor(fy)), dimensions.y, wrap_t);
+			return read(x, y);
+		}
+
+		fx -= 0.5f;
+		fy -= 0.5f;
+		float floor_x = std::floor(fx);
+		float floor_y = std::floor(fy);
+		float tx = fx - floor_x;
+		float ty = fy - floor_y;
+		int x0 = wrap(static_cast<int>(floor_x), dimensions.x, wrap_s);
+		int y0 = wrap(static_cast<int>(floor_y), dimensions.y, wrap_t);
+
+		// Images drawn at their own size sample texel centers exactly
+		if (tx == 0.0f && ty == 0.0f)
+			return read(x0, y0);
+
+		int x1 = wrap(static_cast<int>(floor_x) + 1, dimensions.x, wrap_s);
+		int y1 = wrap(static_cast<int>(floor_y) + 1, dimensions.y, wrap_t);
+
+		SoftwareFloat4 top = SoftwareFloat4::mix(read(x0, y0), read(x1, y0), SoftwareFloat4::splat(tx));
+		SoftwareFloat4 bottom = SoftwareFloat4::mix(read(x0, y1), read(x1, y1), SoftwareFloat4::splat(tx));
+		return SoftwareFloat4::mix(top, bottom, SoftwareFloat4::splat(ty));
+	}
+
+	int SoftwareTextureObject::wrap(int pos, int size, TextureWrapMode mode)
+	{
+		switch (mode)
+		{
+		default:
+		case wrap_clamp_to_edge:
+			return clamp(pos, 0, size - 1);
+		case wrap_repeat:
+			pos %= size;
+			return pos < 0 ? pos + size : pos;
+		case wrap_mirrored_repeat:
+			pos %= size * 2;
+			if (pos < 0)
+				pos += size * 2;
+			return pos < size ? pos : size * 2 - 1 - pos;
+		}
+	}
+
+	void SoftwareTextureObject::generate_mipmap()
+	{
+		// Only the base level is kept
+	}
+
+	PixelBufferPtr SoftwareTextureObject::get_pixeldata(const GraphicContextPtr &gc, TextureFormat texture_format, int level) const
+	{
+		if (level != 0)
+			throw Exception("Only the base level of a texture can be read in the software target");
+
+		if (texture_format == pixels_format)
+			return pixels->copy();
+		else
+			return pixels->to_format(texture_format);
+	}
+
+	void SoftwareTextureObject::copy_from(const GraphicContextPtr &gc, int x, int y, int slice, int level, const PixelBufferPtr &src, const Rect &src_rect)
+	{
+		if (level != 0)	// Only the base level is kept
+			return;
+
+		Rect dest_rect(Point(x, y), src_rect.size());
+		if (src_rect.left < 0 || src_rect.top < 0 || src_rect.right > src->width() || src_rect.bottom > src->height() ||
+			dest_rect.left < 0 || dest_rect.top < 0 || dest_rect.right > dimensions.x || dest_rect.bottom > dimensions.y)
+			throw Exception("Rectangle out of bounds");
+
+		const unsigned char *src_data = src->data_uint8();
+		int src_pitch = src->pitch();
+		int src_left = src_rect.left;
+		int src_top = src_rect.top;
+
+		PixelBufferPtr converted;
+		if (src->format() != pixels_format)
+		{
+			converted = src->copy(src_rect)->to_format(pixels_format);
+			src_data = converted->data_uint8();
+			src_pitch = converted->pitch();
+			src_left = 0;
+			src_top = 0;
+		}
+
+		int bytes_per_pixel = pixels->bytes_per_pixel();
+		int row_size = src_rect.width() * bytes_per_pixel;
+		for (int row = 0; row < src_rect.height(); row++)
+		{
+			memcpy(pixels->data_uint8() + (y + row) * pixels_pitch + x * bytes_per_pixel, src_data + (src_top + row) * src_pitch + src_left * bytes_per_pixel, row_size);
+		}
+	}
+
+	void SoftwareTextureObject::copy_image_from(int x, int y, int width, int height, int level, TextureFormat texture_format, GraphicContextImpl *gc)
+	{
+		if (level != 0)
+			return;
+
+		pixels_format = storage_format(texture_format);
+		allocate(width, height);
+		copy_subimage_from(0, 0, x, y, width, height, level, gc);
+	}
+
+	void SoftwareTextureObject::copy_subimage_from(int offset_x, int offset_y, int x, int y, int width, int height, int level, GraphicContextImpl *gc)
+	{
+		if (level != 0)
+			return;
+
+		PixelBufferPtr frame = gc->pixeldata(Rect(Point(x, y), Size(width, height)), pixels_format, true);
+		copy_from(nullptr, offset_x, offset_y, 0, level, frame, Rect(Point(0, 0), frame->size()));
+	}
+
+	std::shared_ptr<Texture> SoftwareTextureObject::create_view(TextureDimensions texture_dimensions, TextureFormat texture_format, int min_level, int num_levels, int min_layer, int num_layers)
+	{
+		throw Exception("Texture views are not supported by the software target");
+	}
+}
@@ -0,0 +1,125 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#pragma once
+
+#include "UICore/Display/Render/texture_impl.h"
+#include "UICore/Display/Render/graphic_context_impl.h"
+#include "UICore/Display/Image/pixel_buffer.h"
+#include "software_float4.h"
+
+namespace uicore
+{
+	class SoftwareTextureObject : public TextureObject
+	{
+	public:
+		struct HandleInit {};
+		struct InitData {};
+
+		SoftwareTextureObject(HandleInit) {}
+		SoftwareTextureObject(InitData, TextureDimensions texture_dimensions, int width, int height, int depth, int array_size, TextureFormat texture_format, int levels);
+		~SoftwareTextureObject();
+
+		/// \brief Returns the pixels of the base level, stored as tf_rgba8, tf_r8 or tf_rgba32f
+		///
+		/// Other texture formats are converted to tf_rgba8 when uploaded.
+		const PixelBufferPtr &image() const { return pixels; }
+
+		/// \brief Samples the base level at a normalized texture coordinate, like texture() in GLSL
+		///
+		/// Mipmaps are not kept, so the magnification filter decides between nearest and bilinear filtering.
+		SoftwareFloat4 sample(float u, float v) const;
+
+		/// \brief Reads a single texel of the base level, like texelFetch() in GLSL. Texels outside the texture read as zero
+		SoftwareFloat4 fetch(int x, int y) const
+		{
+			if (x < 0 || y < 0 || x >= dimensions.x || y >= dimensions.y)
+				return SoftwareFloat4::splat(0.0f);
+			return read(x, y);
+		}
+
+		void generate_mipmap();
+		PixelBufferPtr get_pixeldata(const GraphicContextPtr &gc, TextureFormat texture_format, int level) const;
+
+		void copy_from(const GraphicContextPtr &gc, int x, int y, int slice, int level, const PixelBufferPtr &src, const Rect &src_rect);
+
+		void copy_image_from(int x, int y, int width, int height, int level, TextureFormat texture_format, GraphicContextImpl *gc);
+		void copy_subimage_from(int offset_x, int offset_y, int x, int y, int width, int height, int level, GraphicContextImpl *gc);
+
+		void set_min_lod(double min_lod) { }
+		void set_max_lod(double max_lod) { }
+		void set_lod_bias(double lod_bias) { }
+		void set_base_level(int base_level) { }
+		void set_max_level(int max_level) { }
+
+		void set_wrap_mode(TextureWrapMode wrap_s, TextureWrapMode wrap_t, TextureWrapMode wrap_r) { set_wrap_mode(wrap_s, wrap_t); }
+		void set_wrap_mode(TextureWrapMode new_wrap_s, TextureWrapMode new_wrap_t) { wrap_s = new_wrap_s; wrap_t = new_wrap_t; }
+		void set_wrap_mode(TextureWrapMode new_wrap_s) { wrap_s = new_wrap_s; }
+
+		void set_min_filter(TextureFilter filter) { min_filter = filter; }
+		void set_mag_filter(TextureFilter filter) { mag_filter = filter; }
+		void set_max_anisotropy(float v) { }
+
+		void set_texture_compare(TextureCompareMode mode, CompareFunction func) { }
+
+		int width() const { return dimensions.x; }
+		int height() const { return dimensions.y; }
+		int depth() const { return dimensions.z; }
+		int array_size() const { return dimensions.w; }
+
+		std::shared_ptr<Texture> create_view(TextureDimensions texture_dimensions, TextureFormat texture_format, int min_level, int num_levels, int min_layer, int num_layers);
+
+	private:
+		void allocate(int width, int height);
+		static TextureFormat storage_format(TextureFormat texture_format);
+		static int wrap(int pos, int size, TextureWrapMode mode);
+
+		SoftwareFloat4 read(int x, int y) const
+		{
+			const unsigned char *line = pixels_data + y * pixels_pitch;
+			switch (pixels_format)
+			{
+			default:
+			case tf_rgba8: return SoftwareFloat4::unpack(reinterpret_cast<const unsigned int*>(line)[x]);
+			case tf_r8: return SoftwareFloat4(line[x] * (1.0f / 255.0f), 0.0f, 0.0f, 1.0f);
+			case tf_rgba32f: return SoftwareFloat4(reinterpret_cast<const Vec4f*>(line)[x]);
+			}
+		}
+
+		Vec4i dimensions;
+		PixelBufferPtr pixels;
+		const unsigned char *pixels_data = nullptr;
+		int pixels_pitch = 0;
+		TextureFormat pixels_format = tf_rgba8;
+
+		TextureFilter min_filter = filter_linear;
+		TextureFilter mag_filter = filter_linear;
+		TextureWrapMode wrap_s = wrap_clamp_to_edge;
+		TextureWrapMode wrap_t = wrap_clamp_to_edge;
+	};
+}
@@ -0,0 +1,74 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+#include "UICore/precomp.h"
+#include "software_vertex_array_buffer.h"
+#include "UICore/Display/Render/staging_buffer.h"
+#include "UICore/Core/System/exception.h"
+
+namespace uicore
+{
+	SoftwareVertexArrayBuffer::SoftwareVertexArrayBuffer(int size, BufferUsage usage) : data(size)
+	{
+	}
+
+	SoftwareVertexArrayBuffer::SoftwareVertexArrayBuffer(const void *init_data, int size, BufferUsage usage) : data(static_cast<const char*>(init_data), static_cast<const char*>(init_data) + size)
+	{
+	}
+
+	SoftwareVertexArrayBuffer::~SoftwareVertexArrayBuffer()
+	{
+	}
+
+	void SoftwareVertexArrayBuffer::upload_data(const GraphicContextPtr &gc, int offset, const void *new_data, int new_size)
+	{
+		if ((offset < 0) || (new_size < 0) || ((new_size + offset) > (int)data.size()))
+			throw Exception("Vertex array buffer, invalid size");
+
+		memcpy(data.data() + offset, new_data, new_size);
+	}
+
+	void SoftwareVertexArrayBuffer::copy_from(const GraphicContextPtr &gc, const StagingBufferPtr &buffer, int dest_pos, int src_pos, int size)
+	{
+		if (size == -1)
+			size = (int)data.size() - dest_pos;
+		if ((dest_pos < 0) || (size < 0) || ((size + dest_pos) > (int)data.size()))
+			throw Exception("Vertex array buffer, invalid size");
+
+		buffer->lock(gc, access_read_only);
+		memcpy(data.data() + dest_pos, static_cast<char*>(buffer->data()) + src_pos, size);
+		buffer->unlock();
+	}
+
+	void SoftwareVertexArrayBuffer::copy_to(const GraphicContextPtr &gc, const StagingBufferPtr &buffer, int dest_pos, int src_pos, int size)
+	{
+		if (size == -1)
+			size = (int)data.size() - src_pos;
+		buffer->upload_data(gc, dest_pos, data.data() + src_pos, size);
+	}
+}
@@ -272,8 +272,9 @@ namespace uicore
 			std::string txt_selected = impl->get_selected_text(line_index);
 			std::string txt_after = impl->get_text_after_selection(line_index);
 
-			float advance_before = font->measure_text(canvas, txt_before).advance.width;
-			float advance_selected = font->measure_text(canvas, txt_selected).advance.width;
+			std::vector<GlyphMetrics> advances = font->measure_texts(canvas, { txt_before, txt_selected });
+			float advance_before = advances[0].advance.width;
+			float advance_selected = advances[1].advance.width;
 
 			// Measure text for get_character_index()
 			impl->last_measured_rects = font->character_indices(canvas, txt_before + txt_selected + txt_after);
@@ -349,9 +349,10 @@ namespace uicore
 
 		FontPtr font = impl->get_font();
 
-		float advance_before = font->measure_text(canvas, txt_before).advance.width;
-		float advance_selected = font->measure_text(canvas, txt_selected).advance.width;
-		float cursor_advance = canvas->grid_fit({ font->measure_text(canvas, impl->text.substr(0, impl->cursor_pos)).advance.width, 0.0f }).x;
+		std::vector<GlyphMetrics> advances = font->measure_texts(canvas, { txt_before, txt_selected, impl->text.substr(0, impl->cursor_pos) });
+		float advance_before = advances[0].advance.width;
+		float advance_selected = advances[1].advance.width;
+		float cursor_advance = canvas->grid_fit({ advances[2].advance.width, 0.0f }).x;
 
 		FontMetrics font_metrics = font->font_metrics(canvas);
 		float baseline = font_metrics.baseline_offset();
@@ -45,15 +45,35 @@ namespace uicore
 		std::shared_ptr<ImageSource> highlighted_image;
 		ImagePtr canvas_image;
 		ImagePtr canvas_highlighted_image;
+		bool measured_loading_image = false;	// Preferred size was calculated before the image finished loading
+		Slot canvas_image_ready;
 
-		void get_images(const CanvasPtr &canvas)
+		void get_images(ImageBaseView *view, const CanvasPtr &canvas)
 		{
 			if (!canvas_image && image)
+			{
 				canvas_image = image->image(canvas);
 
+				// The window is only repainted when the image arrives, so the view has to ask to be drawn again
+				if (!canvas_image->is_ready())
+					canvas_image_ready = canvas_image->sig_ready().connect([=]() { image_ready(view); });
+			}
+
 			if (!canvas_highlighted_image && highlighted_image)
 				canvas_highlighted_image = highlighted_image->image(canvas);
 		}
+
+		void image_ready(ImageBaseView *view)
+		{
+			view->set_needs_render();
+
+			// The image no longer has a size of zero
+			if (measured_loading_image)
+			{
+				measured_loading_image = false;
+				view->set_needs_layout();
+			}
+		}
 	};
 
 	ImageBaseView::ImageBaseView() : impl(std::make_shared<ImageBaseViewImpl>())
@@ -69,6 +89,8 @@ namespace uicore
 	{
 		impl->image = image;
 		impl->canvas_image = nullptr;
+		impl->canvas_image_ready = Slot();
+		impl->measured_loading_image = false;
 		set_needs_render();
 		set_needs_layout();
 	}
@@ -98,7 +120,7 @@ namespace uicore
 
 	void ImageBaseView::render_content(const CanvasPtr &canvas)
 	{
-		impl->get_images(canvas);
+		impl->get_images(this, canvas);
 
 		if (impl->canvas_image && impl->canvas_image->width() != 0.0f && impl->canvas_image->height() != 0.0f)
 		{
@@ -115,7 +137,10 @@ namespace uicore
 
 	float ImageBaseView::calculate_preferred_width(const CanvasPtr &canvas)
 	{
-		impl->get_images(canvas);
+		impl->get_images(this, canvas);
+
+		if (impl->canvas_image && !impl->canvas_image->is_ready())
+			impl->measured_loading_image = true;
 
 		if (impl->canvas_image)
 			return impl->canvas_image->width();
@@ -125,7 +150,10 @@ namespace uicore
 
 	float ImageBaseView::calculate_preferred_height(const CanvasPtr &canvas, float width)
 	{
-		impl->get_images(canvas);
+		impl->get_images(this, canvas);
+
+		if (impl->canvas_image && !impl->canvas_image->is_ready())
+			impl->measured_loading_image = true;
 
 		if (impl->canvas_image && impl->canvas_image->width() != 0)
 			return impl->canvas_image->height() * width / impl->canvas_image->width();
@@ -55,6 +55,8 @@ namespace uicore
 	StylePropertyDefault style_default_background_sizes_x("background-size-x[0]", StyleGetValue::from_keyword("auto"), false);
 	StylePropertyDefault style_default_background_sizes_y("background-size-y[0]", StyleGetValue::from_keyword("auto"), false);
 
+	StylePaintProperties style_paint_background({ "background-color", "background-image", "background-repeat", "background-repeat-x", "background-repeat-y", "background-attachment", "background-position", "background-position-x", "background-position-y", "background-origin", "background-clip", "background-size", "background-size-x", "background-size-y" });
+
 	BackgroundPropertyParser style_parser_background;
 	BackgroundAttachmentPropertyParser style_parser_background_attachment;
 	BackgroundClipPropertyParser style_parser_background_clip;
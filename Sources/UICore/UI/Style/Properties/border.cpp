@@ -49,6 +49,8 @@ namespace uicore
 	StylePropertyDefault style_default_border_right_width("border-right-width", StyleGetValue::from_keyword("medium"), false);
 	StylePropertyDefault style_default_border_bottom_width("border-bottom-width", StyleGetValue::from_keyword("medium"), false);
 
+	StylePaintProperties style_paint_border({ "border-left-color", "border-top-color", "border-right-color", "border-bottom-color", "border-left-style", "border-top-style", "border-right-style", "border-bottom-style", "border-top-left-radius-x", "border-top-left-radius-y", "border-top-right-radius-x", "border-top-right-radius-y", "border-bottom-left-radius-x", "border-bottom-left-radius-y", "border-bottom-right-radius-x", "border-bottom-right-radius-y" });
+
 	BorderPropertyParser style_parser_border;
 	BorderColorPropertyParser style_parser_border_color;
 	BorderStylePropertyParser style_parser_border_style;
@@ -53,6 +53,8 @@ namespace uicore
 	StylePropertyDefault style_default_border_image_image_repeat_x("border-image-repeat-x", StyleGetValue::from_keyword("stretch"), false);
 	StylePropertyDefault style_default_border_image_image_repeat_y("border-image-repeat-y", StyleGetValue::from_keyword("stretch"), false);
 
+	StylePaintProperties style_paint_border_image({ "border-image-source", "border-image-slice-top", "border-image-slice-right", "border-image-slice-bottom", "border-image-slice-left", "border-image-slice-center", "border-image-width-top", "border-image-width-right", "border-image-width-bottom", "border-image-width-left", "border-image-repeat-x", "border-image-repeat-y" });
+
 	BorderImagePropertyParser style_parser_border_image;
 	BorderImageOutsetPropertyParser style_parser_border_image_outset;
 	BorderImageRepeatPropertyParser style_parser_border_image_repeat;
@@ -37,6 +37,8 @@ namespace uicore
 
 	StylePropertyDefault style_default_box_shadow("box-shadow", StyleGetValue::from_keyword("none"), false);
 
+	StylePaintProperties style_paint_box_shadow({ "box-shadow-color" });
+
 	BoxShadowPropertyParser style_parser_box_shadow;
 
 	void BoxShadowPropertyParser::parse(StylePropertySetter *setter, const std::string &name, StyleParser &parser)
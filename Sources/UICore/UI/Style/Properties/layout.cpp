@@ -37,6 +37,7 @@ namespace uicore
 	}
 
 	StylePropertyDefault style_default_layout("layout", StyleGetValue::from_keyword("flex"), false);
+	StylePropertyDefault style_default_layer("layer", StyleGetValue::from_keyword("none"), false);
 	StylePropertyDefault style_default_position("position", StyleGetValue::from_keyword("static"), false);
 	StylePropertyDefault style_default_left("left", StyleGetValue::from_keyword("auto"), false);
 	StylePropertyDefault style_default_top("top", StyleGetValue::from_keyword("auto"), false);
@@ -44,7 +45,10 @@ namespace uicore
 	StylePropertyDefault style_default_bottom("bottom", StyleGetValue::from_keyword("auto"), false);
 	StylePropertyDefault style_default_zindex("z-index", StyleGetValue::from_keyword("auto"), false);
 
+	StylePaintProperties style_paint_layer({ "layer" });
+
 	LayoutPropertyParser style_parser_layout;
+	LayerPropertyParser style_parser_layer;
 	PositionPropertyParser style_parser_position;
 	LeftPropertyParser style_parser_left;
 	TopPropertyParser style_parser_top;
@@ -79,6 +83,33 @@ namespace uicore
 		setter->set_value("layout", layout);
 	}
 
+	void LayerPropertyParser::parse(StylePropertySetter *setter, const std::string &name, StyleParser &parser)
+	{
+		auto &tokens = parser.tokens;
+
+		StyleSetValue layer;
+
+		size_t pos = 0;
+		StyleToken token = next_token(pos, tokens);
+		if (token.type == StyleTokenType::ident && pos == tokens.size())
+		{
+			if (equals(token.value, "none"))
+				layer = StyleSetValue::from_keyword("none");
+			else if (equals(token.value, "cache"))
+				layer = StyleSetValue::from_keyword("cache");
+			else if (equals(token.value, "inherit"))
+				layer = StyleSetValue::from_keyword("inherit");
+			else
+				return;
+		}
+		else
+		{
+			return;
+		}
+
+		setter->set_value("layer", layer);
+	}
+
 	void PositionPropertyParser::parse(StylePropertySetter *setter, const std::string &name, StyleParser &parser)
 	{
 		auto &tokens = parser.tokens;
@@ -41,6 +41,13 @@ namespace uicore
 		void parse(StylePropertySetter *setter, const std::string &name, StyleParser &parser) override;
 	};
 
+	class LayerPropertyParser : public StylePropertyParser
+	{
+	public:
+		LayerPropertyParser() : StylePropertyParser({ "layer" }) { }
+		void parse(StylePropertySetter *setter, const std::string &name, StyleParser &parser) override;
+	};
+
 	class PositionPropertyParser : public StylePropertyParser
 	{
 	public:
@@ -39,6 +39,8 @@ namespace uicore
 	StylePropertyDefault style_default_outline_style("outline-style", StyleGetValue::from_keyword("none"), false);
 	StylePropertyDefault style_default_outline_width("outline-width", StyleGetValue::from_keyword("medium"), false);
 
+	StylePaintProperties style_paint_outline({ "outline-color", "outline-style" });
+
 	OutlinePropertyParser style_parser_outline;
 	OutlineColorPropertyParser style_parser_outline_color;
 	OutlineStylePropertyParser style_parser_outline_style;
@@ -56,6 +56,8 @@ namespace uicore
 
 	StylePropertyDefault style_default_uicore_font_rendering("-uicore-font-rendering", StyleGetValue::from_keyword("auto"), true);
 
+	StylePaintProperties style_paint_text({ "color", "text-decoration-underline", "text-decoration-overline", "text-decoration-line-through", "text-decoration-blink" });
+
 	ColorPropertyParser style_parser_color;
 	TextAlignPropertyParser style_parser_text_align;
 	TextDecorationPropertyParser style_parser_text_decoration;
@@ -112,7 +112,8 @@ namespace uicore
 		if (layer_image.is_url())
 			image = ImageSource::from_resource(layer_image.text())->image(canvas);
 
-		if (image)
+		// Images still loading, or that failed to load, have no size to tile by
+		if (image && image->width() > 0.0f && image->height() > 0.0f)
 		{
 			Rectf clip_box = get_clip_box(index);
 			Rectf origin_box = get_origin_box(index);
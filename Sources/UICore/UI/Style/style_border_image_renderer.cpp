@@ -49,7 +49,7 @@ namespace uicore
 			return;
 
 		ImagePtr image = UIThread::image(canvas, style.computed_value("border-image-source").text());
-		if (image)
+		if (image && image->width() > 0.0f && image->height() > 0.0f)
 		{
 			int slice_left = get_left_slice_value(image->width());
 			int slice_right = get_right_slice_value(image->width());
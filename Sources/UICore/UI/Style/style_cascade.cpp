@@ -40,28 +40,50 @@
 
 namespace uicore
 {
+	static int font_size_id()
+	{
+		static int id = StylePropertyRegistry::instance().intern("font-size");
+		return id;
+	}
+
 	StyleGetValue StyleCascade::cascade_value(const char *property_name) const
+	{
+		return cascade_value(StylePropertyRegistry::instance().find(property_name));
+	}
+
+	StyleGetValue StyleCascade::specified_value(const char *property_name) const
+	{
+		return specified_value(StylePropertyRegistry::instance().find(property_name));
+	}
+
+	StyleGetValue StyleCascade::computed_value(const char *property_name) const
+	{
+		return computed_value(StylePropertyRegistry::instance().find(property_name));
+	}
+
+	StyleGetValue StyleCascade::cascade_value(int property_id) const
 	{
 		for (Style *style : cascade)
 		{
-			StyleGetValue value = style->declared_value(property_name);
+			StyleGetValue value = style->impl->declared_value(property_id);
 			if (!value.is_undefined())
 				return value;
 		}
 		return StyleGetValue();
 	}
 
-	StyleGetValue StyleCascade::specified_value(const char *property_name) const
+	StyleGetValue StyleCascade::specified_value(int property_id) const
 	{
-		StyleGetValue value = cascade_value(property_name);
-		bool inherit = (value.is_undefined() && StyleProperty::is_inherited(property_name)) || value.is_keyword("inherit");
+		const auto &registry = StylePropertyRegistry::instance();
+		StyleGetValue value = cascade_value(property_id);
+		bool inherit = (value.is_undefined() && registry.is_inherited(property_id)) || value.is_keyword("inherit");
 		if (inherit && parent)
 		{
-			return parent->computed_value(property_name);
+			return parent->computed_value(property_id);
 		}
 		else if (value.is_undefined() || value.is_keyword("initial") || value.is_keyword("inherit"))
 		{
-			return StyleProperty::default_value(property_name);
+			return registry.default_value(property_id);
 		}
 		else
 		{
@@ -69,14 +91,56 @@ namespace uicore
 		}
 	}
 
-	StyleGetValue StyleCascade::computed_value(const char *property_name) const
+	StyleGetValue StyleCascade::computed_value(int property_id) const
+	{
+		validate_cache();
+
+		auto it = cached_values.find(property_id);
+		if (it != cached_values.end())
+			return it->second.value;
+
+		bool depends_on_parent = false;
+		StyleGetValue value = resolve_computed_value(property_id, depends_on_parent);
+		cached_values[property_id] = { value, depends_on_parent };
+		return value;
+	}
+
+	StyleGetValue StyleCascade::resolve_computed_value(int property_id, bool &depends_on_parent) const
 	{
 		// To do: pass on to property compute functions
 
-		StyleGetValue specified = specified_value(property_name);
+		const auto &registry = StylePropertyRegistry::instance();
+		StyleGetValue specified = cascade_value(property_id);
+		bool inherit = (specified.is_undefined() && registry.is_inherited(property_id)) || specified.is_keyword("inherit");
+		if (inherit && parent)
+		{
+			depends_on_parent = true;
+			return parent->computed_value(property_id);
+		}
+		else if (specified.is_undefined() || specified.is_keyword("initial") || specified.is_keyword("inherit"))
+		{
+			specified = registry.default_value(property_id);
+		}
+
 		switch (specified.type())
 		{
 		case StyleValueType::length:
+			if (specified.dimension() == StyleDimension::em || specified.dimension() == StyleDimension::ex)
+			{
+				// Relative to our own font size, except for the font size itself which is relative to the parent
+				if (property_id == font_size_id())
+				{
+					depends_on_parent = true;
+					float font_size = parent ? parent->computed_value(property_id).number() : registry.default_value(property_id).number();
+					float scale = specified.dimension() == StyleDimension::ex ? 0.5f : 1.0f;
+					return StyleGetValue::from_length(font_size * specified.number() * scale);
+				}
+
+				StyleGetValue length = compute_length(specified);
+				auto font_size = cached_values.find(font_size_id());
+				depends_on_parent = font_size == cached_values.end() || font_size->second.depends_on_parent;
+				return length;
+			}
 			return compute_length(specified);
 		case StyleValueType::angle:
 			return compute_angle(specified);
@@ -91,6 +155,53 @@ namespace uicore
 		}
 	}
 
+	void StyleCascade::invalidate()
+	{
+		cached_values.clear();
+		version++;
+		StyleImpl::changes++;
+	}
+
+	void StyleCascade::validate_cache() const
+	{
+		if (validated_change == StyleImpl::changes)
+			return;
+
+		bool styles_changed = style_versions.size() != cascade.size();
+		for (size_t i = 0; !styles_changed && i < cascade.size(); i++)
+			styles_changed = style_versions[i].first != cascade[i] || style_versions[i].second != cascade[i]->impl->version;
+
+		if (parent)
+			parent->validate_cache();
+
+		bool parent_changed = validated_parent != parent || (parent && validated_parent_version != parent->version);
+
+		if (styles_changed)
+		{
+			style_versions.clear();
+			for (Style *style : cascade)
+				style_versions.push_back({ style, style->impl->version });
+
+			cached_values.clear();
+			version++;
+		}
+		else if (parent_changed)
+		{
+			for (auto it = cached_values.begin(); it != cached_values.end();)
+			{
+				if (it->second.depends_on_parent)
+					it = cached_values.erase(it);
+				else
+					++it;
+			}
+			version++;
+		}
+
+		validated_parent = parent;
+		validated_parent_version = parent ? parent->version : 0;
+		validated_change = StyleImpl::changes;
+	}
+
 	StyleGetValue StyleCascade::compute_length(const StyleGetValue &length) const
 	{
 		switch (length.dimension())
@@ -109,9 +220,9 @@ namespace uicore
 		case StyleDimension::pc:
 			return StyleGetValue::from_length(length.number() * (float)(12.0 * 96.0 / 72.0));
 		case StyleDimension::em:
-			return StyleGetValue::from_length(computed_value("font-size").number() * length.number());
+			return StyleGetValue::from_length(computed_value(font_size_id()).number() * length.number());
 		case StyleDimension::ex:
-			return StyleGetValue::from_length(computed_value("font-size").number() * length.number() * 0.5f);
+			return StyleGetValue::from_length(computed_value(font_size_id()).number() * length.number() * 0.5f);
 		}
 	}
 
@@ -233,6 +344,7 @@ namespace uicore
 
 	int StyleCascade::array_size(const char *property_name) const
 	{
+		const auto &registry = StylePropertyRegistry::instance();
 		int size = 0;
 		while (true)
 		{
@@ -241,7 +353,8 @@ namespace uicore
 			prop_name.append("[");
 			prop_name.append(Text::to_string(size));
 			prop_name.append("]");
-			if (specified_value(prop_name).is_undefined())
+			int id = registry.find(prop_name);
+			if (id == -1 || specified_value(id).is_undefined())
 				break;
 			size++;
 		}
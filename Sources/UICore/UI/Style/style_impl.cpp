@@ -30,71 +30,170 @@
 #include "UICore/UI/Style/style.h"
 #include "UICore/Core/Text/text.h"
 #include "style_impl.h"
+#include <algorithm>
 
 namespace uicore
 {
-	void StyleImpl::set_value(const std::string &name, const StyleSetValue &value)
+	StylePropertyRegistry &StylePropertyRegistry::instance()
 	{
-		auto type_it = prop_type.find(name);
-		if (type_it != prop_type.end() && type_it->second != value.type)
+		static StylePropertyRegistry registry;
+		return registry;
+	}
+
+	int StylePropertyRegistry::find(const char *name) const
+	{
+		auto it = ids.find(name);
+		return it != ids.end() ? it->second : -1;
+	}
+
+	int StylePropertyRegistry::intern(const std::string &name)
+	{
+		auto it = ids.find(name);
+		if (it != ids.end())
+			return it->second;
+
+		Property property;
+		property.base_name = base_name(name);
+		property.paint_only = std::find(paint_only_names.begin(), paint_only_names.end(), property.base_name) != paint_only_names.end();
+
+		int id = (int)properties.size();
+		properties.push_back(property);
+		ids[name] = id;
+		return id;
+	}
+
+	void StylePropertyRegistry::set_paint_only(const std::string &name)
+	{
+		paint_only_names.push_back(name);
+
+		// Names can be interned before the flag is set, as the order of static initialization is unspecified
+		for (auto &property : properties)
 		{
-			switch (type_it->second)
-			{
-			default:
-			case StyleValueType::undefined:
-				break;
-			case StyleValueType::keyword:
-			case StyleValueType::string:
-			case StyleValueType::url:
-				prop_text.erase(prop_text.find(name));
-				break;
-			case StyleValueType::length:
-			case StyleValueType::angle:
-			case StyleValueType::time:
-			case StyleValueType::frequency:
-			case StyleValueType::resolution:
-				prop_dimension.erase(prop_dimension.find(name));
-				prop_number.erase(prop_number.find(name));
-				break;
-			case StyleValueType::percentage:
-			case StyleValueType::number:
-				prop_number.erase(prop_number.find(name));
-				break;
-			case StyleValueType::color:
-				prop_color.erase(prop_color.find(name));
-				break;
-			}
+			if (property.base_name == name)
+				property.paint_only = true;
 		}
+	}
 
-		if (value.type != StyleValueType::undefined)
-			prop_type[name] = value.type;
-		else if (type_it != prop_type.end())
-			prop_type.erase(type_it);
+	std::string StylePropertyRegistry::base_name(const std::string &name)
+	{
+		return name.substr(0, name.find_first_of("[."));
+	}
 
-		switch (value.type)
+	void StylePropertyRegistry::set_default(int id, const StyleGetValue &value, bool inherit)
+	{
+		properties[id].default_value = value;
+		properties[id].inherited = inherit;
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	unsigned int StyleImpl::changes = 1;
+
+	std::vector<StyleSlot>::const_iterator StyleImpl::find_slot(int id) const
+	{
+		auto it = std::lower_bound(slots.begin(), slots.end(), id, [](const StyleSlot &slot, int id) { return slot.id < id; });
+		return (it != slots.end() && it->id == id) ? it : slots.end();
+	}
+
+	StyleGetValue StyleImpl::declared_value(int id) const
+	{
+		auto it = find_slot(id);
+		if (it == slots.end())
+			return StyleGetValue();
+
+		switch (it->type)
 		{
 		default:
 		case StyleValueType::undefined:
-			break;
+			return StyleGetValue();
 		case StyleValueType::keyword:
+			return StyleGetValue::from_keyword(it->text.c_str());
 		case StyleValueType::string:
+			return StyleGetValue::from_string(it->text.c_str());
 		case StyleValueType::url:
-			prop_text[name] = value.text;
-			break;
+			return StyleGetValue::from_url(it->text.c_str());
 		case StyleValueType::length:
+			return StyleGetValue::from_length(it->number, it->dimension);
 		case StyleValueType::angle:
+			return StyleGetValue::from_angle(it->number, it->dimension);
 		case StyleValueType::time:
+			return StyleGetValue::from_time(it->number, it->dimension);
 		case StyleValueType::frequency:
+			return StyleGetValue::from_frequency(it->number, it->dimension);
 		case StyleValueType::resolution:
-			prop_dimension[name] = value.dimension;
-			prop_number[name] = value.number;
-			break;
+			return StyleGetValue::from_resolution(it->number, it->dimension);
 		case StyleValueType::percentage:
+			return StyleGetValue::from_percentage(it->number);
 		case StyleValueType::number:
-			prop_number[name] = value.number;
-			break;
+			return StyleGetValue::from_number(it->number);
 		case StyleValueType::color:
-			prop_color[name] = value.color;
+			return StyleGetValue::from_color(it->color);
+		}
+	}
+
+	bool StyleImpl::affects_layout() const
+	{
+		const auto &registry = StylePropertyRegistry::instance();
+		for (const auto &slot : slots)
+		{
+			if (!registry.is_paint_only(slot.id))
+				return true;
+		}
+		return false;
+	}
+
+	bool StyleImpl::affects_descendants() const
+	{
+		const auto &registry = StylePropertyRegistry::instance();
+		for (const auto &slot : slots)
+		{
+			if (registry.is_inherited(slot.id) || (slot.type == StyleValueType::keyword && slot.text == "inherit"))
+				return true;
+		}
+		return false;
+	}
+
+	void StyleImpl::set_value(const std::string &name, const StyleSetValue &value)
+	{
+		int id = StylePropertyRegistry::instance().intern(name);
+		auto it = std::lower_bound(slots.begin(), slots.end(), id, [](const StyleSlot &slot, int id) { return slot.id < id; });
+		bool found = it != slots.end() && it->id == id;
+
+		if (!found && value.type == StyleValueType::undefined)
+			return;
+
+		if (found && it->type == value.type && it->number == value.number && it->dimension == value.dimension && it->color == value.color && it->text == value.text)
+			return;
+
+		version++;
+		changes++;
+
+		if (value.type == StyleValueType::undefined)
+		{
+			slots.erase(it);
+			return;
+		}
+
+		if (!found)
+		{
+			it = slots.insert(it, StyleSlot());
+			it->id = id;
+		}
+
+		StyleSlot &slot = *it;
+		slot.type = value.type;
+		slot.dimension = value.dimension;
+		slot.number = value.number;
+		slot.color = value.color;
+		switch (value.type)
+		{
+		case StyleValueType::keyword:
+		case StyleValueType::string:
+		case StyleValueType::url:
+			slot.text = value.text;
+			break;
+		default:
+			slot.text.clear();
 			break;
 		}
 	}
@@ -106,11 +205,10 @@ namespace uicore
 			set_value(name + "[" + Text::to_string((int)i) + "]", value_array[i]);
 		}
 
-		size_t i = value_array.size();
-		while (true)
+		for (size_t i = value_array.size(); ; i++)
 		{
 			auto index_name = name + "[" + Text::to_string((int)i) + "]";
-			if (prop_type.find(index_name) == prop_type.end())
+			if (find_slot(StylePropertyRegistry::instance().find(index_name.c_str())) == slots.end())
 				break;
 			set_value(index_name, StyleSetValue());
 		}
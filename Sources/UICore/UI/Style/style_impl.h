@@ -32,6 +32,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace uicore
 {
@@ -138,16 +139,86 @@ namespace uicore
 		mutable std::size_t _hash = 0;
 	};
 
+	/// \brief Interned style property names
+	///
+	/// Every property name that gets a default value or is set on a style is given a small integer id.
+	/// Styles store their values by id, so a cascade query hashes the property name only once.
+	class StylePropertyRegistry
+	{
+	public:
+		static StylePropertyRegistry &instance();
+
+		/// \brief Returns the id for a property name, or -1 if the name was never interned
+		int find(const char *name) const;
+
+		/// \brief Returns the id for a property name, adding it if needed
+		int intern(const std::string &name);
+
+		/// \brief Sets the initial value and inheritance for a property
+		void set_default(int id, const StyleGetValue &value, bool inherit);
+
+		/// \brief Marks a property, its array elements and its sub-properties as paint only
+		void set_paint_only(const std::string &name);
+
+		const StyleGetValue &default_value(int id) const { static StyleGetValue undefined; return id >= 0 ? properties[id].default_value : undefined; }
+		bool is_inherited(int id) const { return id >= 0 && properties[id].inherited; }
+		bool is_paint_only(int id) const { return id >= 0 && properties[id].paint_only; }
+
+	private:
+		static std::string base_name(const std::string &name);
+
+		struct Property
+		{
+			std::string base_name;
+			StyleGetValue default_value;
+			bool inherited = false;
+			bool paint_only = false;
+		};
+
+		std::unordered_map<StyleString, int, StyleString::hash> ids;
+		std::vector<Property> properties;
+		std::vector<std::string> paint_only_names;
+	};
+
+	/// \brief Declared value for one property in a style
+	class StyleSlot
+	{
+	public:
+		int id = -1;
+		StyleValueType type = StyleValueType::undefined;
+		StyleDimension dimension = StyleDimension::px;
+		float number = 0.0f;
+		Colorf color;
+		std::string text;
+	};
+
 	class StyleImpl : public StylePropertySetter
 	{
 	public:
 		void set_value(const std::string &name, const StyleSetValue &value) override;
 		void set_value_array(const std::string &name, const std::vector<StyleSetValue> &value_array) override;
 
-		std::unordered_map<StyleString, StyleValueType, StyleString::hash> prop_type;
-		std::unordered_map<StyleString, std::string, StyleString::hash> prop_text;
-		std::unordered_map<StyleString, float, StyleString::hash> prop_number;
-		std::unordered_map<StyleString, StyleDimension, StyleString::hash> prop_dimension;
-		std::unordered_map<StyleString, Colorf, StyleString::hash> prop_color;
+		/// \brief Returns the declared value for a property id, or undefined if the style does not declare it
+		StyleGetValue declared_value(int id) const;
+
+		/// \brief True if any declared property can change the layout
+		bool affects_layout() const;
+
+		/// \brief True if any declared property is inherited by descendants
+		bool affects_descendants() const;
+
+		/// \brief Declared values sorted by property id
+		std::vector<StyleSlot> slots;
+
+		/// \brief Incremented every time a value in this style changes
+		unsigned int version = 0;
+
+		/// \brief Incremented every time any style changes or a cascade is invalidated
+		///
+		/// Cascades compare this against the value they last validated their cached values at.
+		static unsigned int changes;
+
+	private:
+		std::vector<StyleSlot>::const_iterator find_slot(int id) const;
 	};
 }
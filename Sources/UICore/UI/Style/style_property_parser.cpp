@@ -37,12 +37,6 @@
 
 namespace uicore
 {
-	std::unordered_map<StyleString, std::pair<StyleGetValue, bool>, StyleString::hash> &style_defaults()
-	{
-		static std::unordered_map<StyleString, std::pair<StyleGetValue, bool>, StyleString::hash> defaults;
-		return defaults;
-	}
-
 	std::unordered_map<StyleString, StylePropertyParser *, StyleString::hash> &style_parsers()
 	{
 		static std::unordered_map<StyleString, StylePropertyParser *, StyleString::hash> parsers;
@@ -53,7 +47,17 @@ namespace uicore
 
 	StylePropertyDefault::StylePropertyDefault(const std::string &name, const StyleGetValue &value, bool inherit)
 	{
-		style_defaults()[name] = { value, inherit };
+		auto &registry = StylePropertyRegistry::instance();
+		registry.set_default(registry.intern(name), value, inherit);
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	StylePaintProperties::StylePaintProperties(const std::vector<std::string> &names)
+	{
+		auto &registry = StylePropertyRegistry::instance();
+		for (const auto &name : names)
+			registry.set_paint_only(name);
 	}
 
 	/////////////////////////////////////////////////////////////////////////
@@ -1064,29 +1068,20 @@ namespace uicore
 
 	bool StyleProperty::is_inherited(const char *name)
 	{
-		auto it = style_defaults().find(name);
-		if (it != style_defaults().end())
-		{
-			return it->second.second;
-		}
-		else
-		{
-			return false;
-		}
+		auto &registry = StylePropertyRegistry::instance();
+		return registry.is_inherited(registry.find(name));
 	}
 	
+	bool StyleProperty::is_paint_only(const char *name)
+	{
+		auto &registry = StylePropertyRegistry::instance();
+		return registry.is_paint_only(registry.find(name));
+	}
+
 	const StyleGetValue &StyleProperty::default_value(const char *name)
 	{
-		auto it = style_defaults().find(name);
-		if (it != style_defaults().end())
-		{
-			return it->second.first;
-		}
-		else
-		{
-			static StyleGetValue undefined;
-			return undefined;
-		}
+		auto &registry = StylePropertyRegistry::instance();
+		return registry.default_value(registry.find(name));
 	}
 
 	void StyleProperty::parse(StylePropertySetter *setter, const std::string &properties)
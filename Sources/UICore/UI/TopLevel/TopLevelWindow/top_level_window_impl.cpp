@@ -74,13 +74,70 @@ namespace uicore
 
 	void TopLevelWindow_Impl::on_paint()
 	{
+		Rectf viewport = window->viewport();
+
 		canvas->begin();
-		canvas->clear(StandardColorf::transparent());
-		window_view->render(canvas, window->viewport());
+
+		Rectf damage = window_view->update_layout(canvas, viewport);
+		Rectf redraw = redraw_area(damage, viewport);
+
+		if (redraw == viewport)
+		{
+			canvas->clear(StandardColorf::transparent());
+			window_view->render(canvas, viewport);
+		}
+		else if (redraw.left < redraw.right && redraw.top < redraw.bottom)
+		{
+			// Views outside the clip rect are skipped by render
+			canvas->push_clip(redraw);
+			canvas->clear(StandardColorf::transparent());
+			window_view->render(canvas, viewport);
+			canvas->pop_clip();
+		}
+
 		canvas->end();
 		window->flip();
 	}
 
+	Rectf TopLevelWindow_Impl::redraw_area(const Rectf &damage, const Rectf &viewport)
+	{
+		damage_history.insert(damage_history.begin(), damage);
+		if ((int)damage_history.size() > max_damage_history)
+			damage_history.pop_back();
+
+		// The back buffer misses the changes of every frame presented since it was drawn. Older buffers than the history covers are redrawn completely
+		int age = window->back_buffer_age();
+		if (age <= 0 || age > (int)damage_history.size())
+			return viewport;
+
+		Rectf redraw;
+		for (int i = 0; i < age; i++)
+		{
+			const Rectf &box = damage_history[i];
+			if (box.left >= box.right || box.top >= box.bottom)
+				continue;
+
+			if (redraw.left >= redraw.right || redraw.top >= redraw.bottom)
+				redraw = box;
+			else
+				redraw.bounding_rect(box);
+		}
+
+		if (redraw.left >= redraw.right || redraw.top >= redraw.bottom)
+			return Rectf();
+
+		// Include the antialiased edges and snap to whole pixels
+		float pixel_ratio = canvas->pixel_ratio();
+		redraw.expand(1.0f);
+		redraw = Rectf(
+			std::floor(redraw.left * pixel_ratio) / pixel_ratio,
+			std::floor(redraw.top * pixel_ratio) / pixel_ratio,
+			std::ceil(redraw.right * pixel_ratio) / pixel_ratio,
+			std::ceil(redraw.bottom * pixel_ratio) / pixel_ratio);
+		redraw.overlap(viewport);
+		return redraw;
+	}
+
 	void TopLevelWindow_Impl::on_window_close()
 	{
 		CloseEvent e;
@@ -50,6 +50,10 @@ namespace uicore
 
 		std::shared_ptr<View> hot_view;
 
+		// Damage of the most recent frames, newest first, for back buffers holding an older frame
+		std::vector<Rectf> damage_history;
+		static const int max_damage_history = 4;
+
 	private:
 		Pointf to_root_pos(const Pointf &client_pos) const;
 
@@ -65,6 +69,7 @@ namespace uicore
 		void on_got_focus();
 		void on_resize(float, float);
 		void on_paint();
+		Rectf redraw_area(const Rectf &damage, const Rectf &viewport);
 		void on_key_down(const uicore::InputEvent &);
 		void on_key_up(const uicore::InputEvent &);
 		void on_mouse_down(const uicore::InputEvent &);
@@ -30,8 +30,12 @@
 #include "UICore/UI/TopLevel/view_tree.h"
 #include "UICore/UI/Events/event.h"
 #include "UICore/UI/Events/focus_change_event.h"
+#include "UICore/Display/2D/canvas.h"
+#include "UICore/Display/2D/canvas_impl.h"
+#include "UICore/Display/Render/frame_buffer.h"
+#include "UICore/Core/System/system.h"
 #include "../View/view_impl.h"
-#include "../View/positioned_layout.h"
+#include "../View/view_layer.h"
 #include <algorithm>
 
 namespace uicore
@@ -51,6 +55,18 @@ namespace uicore
 
 		View *focus_view = nullptr;
 		std::shared_ptr<View> root;
+
+		Rectf damage;	// Union of the damaged areas, empty if nothing changed
+		bool render_boxes_dirty = true;
+		bool placeholders_drawn = false;	// The last frame drew something still loading, so the next one redraws everything
+
+		int layout_passes = 0;
+		int layout_passes_per_second = 0;
+		int layout_passes_at_second_start = 0;
+		int64_t second_start = 0;
+
+		FrameBufferPtr layer_frame_buffer;
+		CanvasPtr layer_canvas;
 	};
 
 	ViewTree::ViewTree() : impl(new ViewTreeImpl)
@@ -112,20 +128,96 @@ namespace uicore
 		}
 	}
 
-	void ViewTree::render(const CanvasPtr &canvas, const Rectf &margin_box)
+	Rectf ViewTree::update_layout(const CanvasPtr &canvas, const Rectf &margin_box)
 	{
 		View *view = impl->root.get();
 
 		view->set_geometry(ViewGeometry::from_margin_box(view->style_cascade(), margin_box));
 
-		if (view->needs_layout())
+		// Only the subtrees below the nearest dirty layout boundaries are laid out, and their views are the only ones that can move
+		bool layout_changed = view->impl->layout_dirty_subtrees(view, this, canvas, canvas->transform(), !view->hidden(), !impl->render_boxes_dirty);
+		if (layout_changed)
+			impl->layout_passes++;
+
+		int64_t now = System::microseconds();
+		if (now - impl->second_start >= 1000000)
+		{
+			impl->layout_passes_per_second = impl->second_start != 0 ? impl->layout_passes - impl->layout_passes_at_second_start : 0;
+			impl->layout_passes_at_second_start = impl->layout_passes;
+			impl->second_start = now;
+		}
+
+		// Compare where each view ended up with where it was drawn before
+		if (impl->render_boxes_dirty)
+		{
+			view->impl->update_render_boxes(this, canvas->transform(), !view->hidden());
+			impl->render_boxes_dirty = false;
+		}
+
+		// Glyphs and images finishing loading only repaint the window, without telling which views used them
+		if (impl->placeholders_drawn)
 		{
-			view->layout_children(canvas);
-			PositionedLayout::layout_children(canvas, view);
+			add_damage(margin_box);
+			impl->placeholders_drawn = false;
 		}
-		view->impl->needs_layout = false;
 
+		Rectf damage = impl->damage;
+		impl->damage = Rectf();
+		return damage;
+	}
+
+	void ViewTree::render(const CanvasPtr &canvas, const Rectf &margin_box)
+	{
+		update_layout(canvas, margin_box);
+		ViewLayerCache::instance().next_frame();
+
+		View *view = impl->root.get();
 		view->impl->render(view, canvas);
+
+		impl->placeholders_drawn = static_cast<CanvasImpl*>(canvas.get())->placeholders_drawn;
+	}
+
+	int ViewTree::layout_pass_count() const
+	{
+		return impl->layout_passes;
+	}
+
+	int ViewTree::layout_passes_per_second() const
+	{
+		return impl->layout_passes_per_second;
+	}
+
+	void ViewTree::add_damage(const Rectf &box)
+	{
+		if (box.left >= box.right || box.top >= box.bottom)
+			return;
+
+		if (impl->damage.left >= impl->damage.right || impl->damage.top >= impl->damage.bottom)
+			impl->damage = box;
+		else
+			impl->damage.bounding_rect(box);
+	}
+
+	void ViewTree::set_render_boxes_dirty()
+	{
+		impl->render_boxes_dirty = true;
+	}
+
+	const CanvasPtr &ViewTree::layer_canvas(const CanvasPtr &canvas, const Texture2DPtr &layer_texture)
+	{
+		const GraphicContextPtr &gc = canvas->gc();
+		if (!impl->layer_canvas || impl->layer_canvas->gc() != gc)
+		{
+			// All layers share one frame buffer and canvas, only the attached texture changes
+			impl->layer_frame_buffer = FrameBuffer::create(gc);
+			impl->layer_canvas = std::make_shared<CanvasImpl>(gc, impl->layer_frame_buffer);
+		}
+
+		impl->layer_frame_buffer->attach_color(0, layer_texture);
+
+		// Content still loading in the layer repaints the window of the canvas when it becomes available
+		static_cast<CanvasImpl*>(impl->layer_canvas.get())->set_window(static_cast<CanvasImpl*>(canvas.get())->window());
+		return impl->layer_canvas;
 	}
 
 	void ViewTree::dispatch_activation_change(ActivationChangeType type)
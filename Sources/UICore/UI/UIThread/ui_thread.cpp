@@ -126,7 +126,7 @@ namespace uicore
 	{
 		auto &images = UIThreadImpl::instance()->images;
 		if (images.find(name) == images.end())
-			images[name] = Image::create(canvas, FilePath::combine(UIThreadImpl::instance()->resource_path, name));
+			images[name] = Image::create_async(canvas, FilePath::combine(UIThreadImpl::instance()->resource_path, name));
 		return images[name];
 	}
 
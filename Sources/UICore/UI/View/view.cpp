@@ -42,11 +42,14 @@
 #include "UICore/Display/2D/path.h"
 #include "UICore/Display/2D/pen.h"
 #include "UICore/Display/2D/brush.h"
+#include "UICore/Display/2D/canvas_impl.h"
+#include "UICore/UI/Style/style_impl.h"
 #include "UICore/Core/Text/text.h"
 #include "view_impl.h"
 #include "view_action_impl.h"
 #include "flex_layout.h"
 #include "custom_layout.h"
+#include "positioned_layout.h"
 #include <algorithm>
 #include <set>
 
@@ -84,50 +87,54 @@ namespace uicore
 
 		auto &style = impl->styles[state];
 		style = std::make_shared<Style>();
+
+		ViewStateStyle state_style(style.get(), state);
+		auto cascade_order = [](const ViewStateStyle &a, const ViewStateStyle &b) { return a.state_count != b.state_count ? a.state_count > b.state_count : a.style > b.style; };
+		impl->state_styles.insert(std::upper_bound(impl->state_styles.begin(), impl->state_styles.end(), state_style, cascade_order), state_style);
+		impl->cascade_cache.clear();
+
 		impl->update_style_cascade();
 		return style;
 	}
 
 	bool View::state(const std::string &name) const
 	{
-		const auto it = impl->states.find(name);
-		if (it != impl->states.end())
-			return it->second.enabled;
-		else
-			return false;
+		return impl->enabled_states.test(ViewStateNames::find(name));
 	}
 	
 	void View::set_state(const std::string &name, bool value)
 	{
-		if (impl->states[name].enabled != value)
+		int state = ViewStateNames::intern(name);
+		if (impl->enabled_states.test(state) != value)
 		{
-			impl->states[name] = ViewImpl::StyleState(false, value);
-			impl->update_style_cascade();
-			set_needs_layout();
+			impl->enabled_states.set(state, value);
+			impl->explicit_states.set(state, true);
+			impl->apply_style_change(this, impl->update_style_cascade());
 		}
 	}
+
 	void View::set_state_cascade(const std::string &name, bool value)
 	{
-		if (impl->states[name].enabled != value)
+		int state = ViewStateNames::intern(name);
+		if (impl->enabled_states.test(state) != value)
 		{
-			impl->states[name] = ViewImpl::StyleState(false, value);
-			impl->update_style_cascade();
-			set_needs_layout();
-			impl->set_state_cascade_siblings(name, value);
+			impl->enabled_states.set(state, value);
+			impl->explicit_states.set(state, true);
+			impl->apply_style_change(this, impl->update_style_cascade());
+			impl->set_state_cascade_siblings(state, value);
 		}
 	}
 
-	void ViewImpl::set_state_cascade_siblings(const std::string &name, bool value)
+	void ViewImpl::set_state_cascade_siblings(int state, bool value)
 	{
 		for (auto view = _first_child; view != nullptr; view = view->next_sibling())
 		{
 			ViewImpl *impl = view->impl.get();
-			if (impl->states[name].inherited)
+			if (!impl->explicit_states.test(state))
 			{
-				impl->states[name] = ViewImpl::StyleState(true, value);
-				impl->update_style_cascade();
-				view->set_needs_layout();
-				impl->set_state_cascade_siblings(name, value);
+				impl->enabled_states.set(state, value);
+				impl->apply_style_change(view.get(), impl->update_style_cascade());
+				impl->set_state_cascade_siblings(state, value);
 			}
 		}
 	}
@@ -183,7 +190,7 @@ namespace uicore
 		new_child->impl->_parent = this;
 		new_child->impl->update_style_cascade();
 		new_child->set_needs_layout();
-		set_needs_layout();
+		impl->invalidate_layout(this);
 		
 		child_added(new_child);
 
@@ -228,7 +235,7 @@ namespace uicore
 		new_child->impl->_parent = this;
 		new_child->impl->update_style_cascade();
 		new_child->set_needs_layout();
-		set_needs_layout();
+		impl->invalidate_layout(this);
 		
 		child_added(new_child);
 
@@ -242,9 +249,12 @@ namespace uicore
 		
 		auto tree = view_tree();
 		if (tree)
+		{
 			tree->removing_view(this);
+			impl->add_subtree_damage(tree);
+		}
 		
-		impl->_parent->set_needs_layout();
+		impl->_parent->impl->invalidate_layout(impl->_parent);
 		
 		auto old_child = shared_from_this();
 		
@@ -308,14 +318,67 @@ namespace uicore
 
 	void View::set_needs_layout()
 	{
-		impl->needs_layout = true;
-		impl->layout_cache.clear();
+		ViewTree *tree = view_tree();
+		if (tree)
+			tree->add_damage(impl->render_box);
 
-		View *super = parent();
-		if (super)
-			super->set_needs_layout();
-		else
-			set_needs_render();
+		impl->invalidate_layout(this);
+
+		// A layout boundary keeps its size when its content changes, but whatever changed may be its own style
+		if (impl->_parent && is_layout_boundary())
+			impl->_parent->impl->invalidate_layout(impl->_parent);
+	}
+
+	bool View::is_layout_boundary() const
+	{
+		if (impl->layout_boundary || !impl->_parent)
+			return true;
+
+		// Flex and positioned layout only use the preferred size of a view when its width or height is not a length
+		const auto &cascade = style_cascade();
+		if (!cascade.computed_value("width").is_length() || !cascade.computed_value("height").is_length())
+			return false;
+
+		auto flex_basis = cascade.computed_value("flex-basis");
+		return flex_basis.is_keyword("auto") || flex_basis.is_length() || flex_basis.is_percentage();
+	}
+
+	void View::set_layout_boundary(bool enable)
+	{
+		if (impl->layout_boundary != enable)
+		{
+			impl->layout_boundary = enable;
+			if (impl->_parent)
+				impl->_parent->impl->invalidate_layout(impl->_parent);
+		}
+	}
+
+	void ViewImpl::invalidate_layout(View *self)
+	{
+		// Views that move during layout are damaged by update_render_boxes, so only the view that changed is damaged here.
+		// Dirtiness stops at the nearest layout boundary, which keeps its size. The views above it keep their layout caches
+		// and only remember that something below them must be laid out.
+		bool inside_boundary = true;
+		for (View *view = self; view; view = view->parent())
+		{
+			if (inside_boundary)
+			{
+				view->impl->needs_layout = true;
+				view->impl->layout_cache.clear();
+				inside_boundary = !view->is_layout_boundary();
+			}
+			else
+			{
+				view->impl->descendant_needs_layout = true;
+			}
+
+			if (view->impl->layer)
+				view->impl->layer->valid = false;
+		}
+
+		ViewTree *tree = self->view_tree();
+		if (tree)
+			tree->set_needs_render();
 	}
 
 	CanvasPtr View::canvas() const
@@ -329,9 +392,23 @@ namespace uicore
 
 	void View::set_needs_render()
 	{
+		impl->invalidate_layers(this);
+
 		ViewTree *tree = view_tree();
 		if (tree)
+		{
+			tree->add_damage(impl->render_box);
 			tree->set_needs_render();
+		}
+	}
+
+	void ViewImpl::invalidate_layers(View *self)
+	{
+		for (View *view = self; view; view = view->parent())
+		{
+			if (view->impl->layer)
+				view->impl->layer->valid = false;
+		}
 	}
 
 	const ViewGeometry &View::geometry() const
@@ -375,6 +452,11 @@ namespace uicore
 	void View::set_view_transform(const Mat4f &transform)
 	{
 		impl->view_transform = transform;
+
+		// The children move without a layout
+		ViewTree *tree = view_tree();
+		if (tree)
+			tree->set_render_boxes_dirty();
 		set_needs_render();
 	}
 
@@ -392,6 +474,30 @@ namespace uicore
 		}
 	}
 
+	bool View::layer_cached() const
+	{
+		return impl->layer_cached || style_cascade().computed_value("layer").is_keyword("cache");
+	}
+
+	void View::set_layer_cached(bool enable)
+	{
+		if (impl->layer_cached != enable)
+		{
+			impl->layer_cached = enable;
+			set_needs_render();
+		}
+	}
+
+	int View::layer_memory_budget()
+	{
+		return ViewLayerCache::instance().budget;
+	}
+
+	void View::set_layer_memory_budget(int bytes)
+	{
+		ViewLayerCache::instance().budget = bytes;
+	}
+
 	float View::preferred_margin_width(const CanvasPtr &canvas)
 	{
 		float margin_left = style_cascade().computed_value("margin-left").number();
@@ -1013,6 +1119,72 @@ namespace uicore
 	}
 
 	void ViewImpl::render(View *self, const CanvasPtr &canvas)
+	{
+		if (self->layer_cached())
+		{
+			if (render_layer(self, canvas))
+				return;
+		}
+		else if (layer)
+		{
+			layer.reset();
+		}
+
+		render_direct(self, canvas);
+	}
+
+	bool ViewImpl::render_layer(View *self, const CanvasPtr &canvas)
+	{
+		ViewTree *tree = self->view_tree();
+		if (!tree)
+			return false;
+
+		// Start the layer at a whole pixel so its content stays as sharp as when rendered directly
+		float pixel_ratio = canvas->pixel_ratio();
+		Rectf box = visual_box();
+		box.left = std::floor(box.left * pixel_ratio) / pixel_ratio;
+		box.top = std::floor(box.top * pixel_ratio) / pixel_ratio;
+		Size size((int)std::ceil(box.width() * pixel_ratio), (int)std::ceil(box.height() * pixel_ratio));
+		if (size.width <= 0 || size.height <= 0)
+			return false;
+
+		if (!layer)
+			layer.reset(new ViewLayer());
+
+		// Moving the view keeps the layer, as its content is rendered relative to the visual box
+		if (!layer->valid || layer->size != size)
+		{
+			// Layers inside a layer being rendered can only be drawn from, as the layer canvas is in use
+			ViewLayerCache &cache = ViewLayerCache::instance();
+			if (cache.rendering_layer || !layer->allocate(canvas->gc(), size))
+				return false;
+
+			CanvasImpl *canvas_impl = static_cast<CanvasImpl*>(canvas.get());
+			canvas_impl->batcher.flush();
+
+			const CanvasPtr &layer_canvas = tree->layer_canvas(canvas, layer->texture);
+			layer_canvas->begin();
+			layer_canvas->clear(StandardColorf::transparent());
+			layer_canvas->set_transform(Mat4f::translate(-box.left, -box.top, 0.0f));
+			cache.rendering_layer = true;
+			render_direct(self, layer_canvas);
+			cache.rendering_layer = false;
+			layer_canvas->end();
+
+			canvas_impl->restore_state();
+
+			// Render again next frame if something was still loading
+			layer->valid = !static_cast<CanvasImpl*>(layer_canvas.get())->placeholders_drawn;
+			if (!layer->valid)
+				canvas_impl->placeholders_drawn = true;
+		}
+
+		layer->touch();
+		static_cast<CanvasImpl*>(canvas.get())->draw_premultiplied(layer->texture, Rectf(0.0f, 0.0f, Sizef(size)), Rectf(box.left, box.top, Sizef(size) / pixel_ratio));
+		return true;
+	}
+
+	void ViewImpl::render_direct(View *self, const CanvasPtr &canvas)
 	{
 		style_cascade.render_background(canvas, _geometry);
 		style_cascade.render_border(canvas, _geometry);
@@ -1075,39 +1247,215 @@ namespace uicore
 		canvas->set_transform(old_transform);
 	}
 
-	void ViewImpl::update_style_cascade() const
+	void ViewImpl::update_render_boxes(ViewTree *tree, const Mat4f &transform, bool visible)
 	{
-		std::vector<std::pair<Style *, size_t>> matches;
+		Rectf box;
+		if (visible)
+		{
+			// Note: same axis aligned approximation as render uses for rotated transforms
+			Rectf local_box = visual_box();
+			Vec4f tl_point = transform * Vec4f(local_box.left, local_box.top, 0.0f, 1.0f);
+			Vec4f br_point = transform * Vec4f(local_box.right, local_box.bottom, 0.0f, 1.0f);
+			box = Rectf(std::min(tl_point.x, br_point.x), std::min(tl_point.y, br_point.y), std::max(tl_point.x, br_point.x), std::max(tl_point.y, br_point.y));
+		}
 
-		for (auto it : styles)
+		if (box != render_box)
 		{
-			auto &style_list = it.first;
-			auto &style = it.second;
+			tree->add_damage(render_box);
+			tree->add_damage(box);
+			render_box = box;
+		}
 
-			auto style_classes = Text::split(style_list, " ");
+		Pointf translate = _geometry.content_pos();
+		Mat4f child_transform = transform * Mat4f::translate(translate.x, translate.y, 0) * view_transform;
+		for (auto view = _first_child; view != nullptr; view = view->next_sibling())
+		{
+			view->impl->update_render_boxes(tree, child_transform, visible && !view->hidden());
+		}
+	}
+
+	bool ViewImpl::layout_dirty_subtrees(View *self, ViewTree *tree, const CanvasPtr &canvas, const Mat4f &transform, bool visible, bool update_boxes)
+	{
+		if (needs_layout)
+		{
+			// The topmost dirty view on a path from the root is a layout boundary and keeps its current geometry
+			self->layout_children(canvas);
+			PositionedLayout::layout_children(canvas, self);
+			clear_layout_flags();
+
+			if (update_boxes)
+				update_render_boxes(tree, transform, visible);
+			return true;
+		}
 
-			bool match = true;
-			for (const auto &state : style_classes)
+		if (!descendant_needs_layout)
+			return false;
+
+		bool layout_changed = false;
+		Pointf translate = _geometry.content_pos();
+		Mat4f child_transform = transform * Mat4f::translate(translate.x, translate.y, 0) * view_transform;
+		for (auto view = _first_child; view != nullptr; view = view->next_sibling())
+		{
+			if (view->impl->layout_dirty_subtrees(view.get(), tree, canvas, child_transform, visible && !view->hidden(), update_boxes))
+				layout_changed = true;
+		}
+
+		// Cleared last, as laying out the children marks the path to the root again
+		descendant_needs_layout = false;
+		return layout_changed;
+	}
+
+	void ViewImpl::clear_layout_flags()
+	{
+		needs_layout = false;
+		descendant_needs_layout = false;
+		for (auto view = _first_child; view != nullptr; view = view->next_sibling())
+		{
+			view->impl->clear_layout_flags();
+		}
+	}
+
+	void ViewImpl::add_subtree_damage(ViewTree *tree)
+	{
+		tree->add_damage(render_box);
+		render_box = Rectf();
+
+		for (auto view = _first_child; view != nullptr; view = view->next_sibling())
+		{
+			view->impl->add_subtree_damage(tree);
+		}
+	}
+
+	Rectf ViewImpl::visual_box() const
+	{
+		Rectf border_box = _geometry.border_box();
+		Rectf box = border_box;
+
+		int num_shadows = style_cascade.array_size("box-shadow-style");
+		for (int index = 0; index < num_shadows; index++)
+		{
+			std::string index_text = "[" + Text::to_string(index) + "]";
+			float offset_x = style_cascade.computed_value("box-shadow-horizontal-offset" + index_text).number();
+			float offset_y = style_cascade.computed_value("box-shadow-vertical-offset" + index_text).number();
+			float blur_radius = style_cascade.computed_value("box-shadow-blur-radius" + index_text).number();
+
+			Rectf shadow_box = border_box;
+			shadow_box.translate(offset_x, offset_y);
+			shadow_box.expand(blur_radius);
+			box.bounding_rect(shadow_box);
+		}
+
+		return box;
+	}
+
+	StyleChange ViewImpl::update_style_cascade() const
+	{
+		// The styles are kept in cascade order, so the cascade only depends on which of them match the states
+		std::vector<Style *> uncached_cascade;
+		std::vector<Style *> *matching_styles = &uncached_cascade;
+		if (state_styles.size() <= 64)
+		{
+			uint64_t matches = 0;
+			for (size_t i = 0; i < state_styles.size(); i++)
 			{
-				auto search_it = states.find(state);
-				if (search_it == states.end() || !search_it->second.enabled)
-					match = false;
+				if (enabled_states.contains(state_styles[i].required_states))
+					matches |= uint64_t(1) << i;
 			}
 
-			if (match)
-				matches.push_back({ style.get(), style_classes.size() });
+			auto it = cascade_cache.find(matches);
+			if (it == cascade_cache.end())
+			{
+				it = cascade_cache.insert({ matches, std::vector<Style *>() }).first;
+				for (size_t i = 0; i < state_styles.size(); i++)
+				{
+					if (matches & (uint64_t(1) << i))
+						it->second.push_back(state_styles[i].style);
+				}
+			}
+			matching_styles = &it->second;
+		}
+		else
+		{
+			for (const auto &state_style : state_styles)
+			{
+				if (enabled_states.contains(state_style.required_states))
+					uncached_cascade.push_back(state_style.style);
+			}
 		}
+		const std::vector<Style *> &cascade = *matching_styles;
 
-		std::stable_sort(matches.begin(), matches.end(), [](const std::pair<Style *, size_t> &a, const std::pair<Style *, size_t> &b) { return a.second != b.second ? a.second > b.second : a.first > b.first; });
+		const StyleCascade *parent = _parent ? &_parent->style_cascade() : nullptr;
 
-		if (_parent)
-			style_cascade.parent = &_parent->style_cascade();
+		if (parent == style_cascade.parent && cascade == style_cascade.cascade)
+			return StyleChange::none;
+
+		StyleChange change = StyleChange::paint;
+		if (parent != style_cascade.parent)
+		{
+			change = StyleChange::layout;
+		}
 		else
-			style_cascade.parent = nullptr;
+		{
+			// Styles present both before and after must keep their order, or other properties could win
+			auto contains = [](const std::vector<Style *> &list, Style *style) { return std::find(list.begin(), list.end(), style) != list.end(); };
+			std::vector<Style *> kept_before, kept_after;
+			for (Style *style : style_cascade.cascade)
+			{
+				if (contains(cascade, style))
+					kept_before.push_back(style);
+				else if (style->impl->affects_layout())
+					change = StyleChange::layout;
+				else if (change == StyleChange::paint && style->impl->affects_descendants())
+					change = StyleChange::paint_subtree;
+			}
+			for (Style *style : cascade)
+			{
+				if (contains(style_cascade.cascade, style))
+					kept_after.push_back(style);
+				else if (style->impl->affects_layout())
+					change = StyleChange::layout;
+				else if (change == StyleChange::paint && style->impl->affects_descendants())
+					change = StyleChange::paint_subtree;
+			}
+			if (kept_before != kept_after)
+				change = StyleChange::layout;
+		}
+
+		style_cascade.parent = parent;
+		style_cascade.cascade = cascade;
+		style_cascade.invalidate();
+		return change;
+	}
+
+	void ViewImpl::apply_style_change(View *self, StyleChange change)
+	{
+		switch (change)
+		{
+		case StyleChange::none:
+			break;
+		case StyleChange::paint:
+			self->set_needs_render();
+			break;
+		case StyleChange::paint_subtree:
+			self->set_needs_render();
+			if (self->view_tree())
+				invalidate_subtree_render(self->view_tree());
+			break;
+		case StyleChange::layout:
+			self->set_needs_layout();
+			break;
+		}
+	}
 
-		style_cascade.cascade.clear();
-		for (auto &match : matches)
-			style_cascade.cascade.push_back(match.first);
+	void ViewImpl::invalidate_subtree_render(ViewTree *tree)
+	{
+		for (auto view = _first_child; view != nullptr; view = view->next_sibling())
+		{
+			if (view->impl->layer)
+				view->impl->layer->valid = false;
+			tree->add_damage(view->impl->render_box);
+			view->impl->invalidate_subtree_render(tree);
+		}
 	}
 
 	void ViewImpl::process_event_handler(ViewEventHandler *handler, EventUI *e)
@@ -35,7 +35,10 @@
 #include "../Animation/animation_group.h"
 #include "view_layout.h"
 #include "flex_layout.h"
+#include "view_layer.h"
+#include "view_state.h"
 #include <map>
+#include <unordered_map>
 
 namespace uicore
 {
@@ -74,15 +77,35 @@ namespace uicore
 		}
 	};
 
+	/// \brief What a change of the styles in a view cascade requires
+	enum class StyleChange
+	{
+		none,
+		paint,          // Only paint properties changed
+		paint_subtree,  // Only paint properties changed, some of them inherited by descendants
+		layout
+	};
+
 	class ViewImpl
 	{
 	public:
 		ViewLayout *active_layout(View *self);
 
 		void render(View *self, const CanvasPtr &canvas);
+		void render_direct(View *self, const CanvasPtr &canvas);
+		bool render_layer(View *self, const CanvasPtr &canvas);
+		void invalidate_layout(View *self);
+		void invalidate_layers(View *self);
+		void update_render_boxes(ViewTree *tree, const Mat4f &transform, bool visible);
+		bool layout_dirty_subtrees(View *self, ViewTree *tree, const CanvasPtr &canvas, const Mat4f &transform, bool visible, bool update_boxes);
+		void clear_layout_flags();
+		void add_subtree_damage(ViewTree *tree);
+		Rectf visual_box() const;
 		void process_event(View *self, EventUI *e, bool use_capture);
 		void process_event_handler(ViewEventHandler *handler, EventUI *e);
-		void update_style_cascade() const;
+		StyleChange update_style_cascade() const;
+		void apply_style_change(View *self, StyleChange change);
+		void invalidate_subtree_render(ViewTree *tree);
 
 		unsigned int find_next_tab_index(unsigned int tab_index) const;
 		unsigned int find_prev_tab_index(unsigned int tab_index) const;
@@ -90,7 +113,7 @@ namespace uicore
 		View *find_next_with_tab_index(unsigned int tab_index, const ViewImpl *search_from = nullptr, bool also_search_ancestors = true) const;
 		View *find_prev_with_tab_index(unsigned int tab_index, const ViewImpl *search_from = nullptr, bool also_search_ancestors = true) const;
 
-		void set_state_cascade_siblings(const std::string &name, bool value);
+		void set_state_cascade_siblings(int state, bool value);
 
 		void inverse_bubble(EventUI *e, const View *until_parent_view);
 
@@ -122,16 +145,11 @@ namespace uicore
 
 		mutable StyleCascade style_cascade;
 		mutable std::map<std::string, std::shared_ptr<Style>> styles;
+		mutable std::vector<ViewStateStyle> state_styles;	// Sorted in cascade order, most specific first
+		mutable std::unordered_map<uint64_t, std::vector<Style *>> cascade_cache;	// Cascade for each set of matching state_styles
 
-		struct StyleState
-		{
-			StyleState(){}
-			StyleState(bool is_inherited, bool is_enabled) : inherited(is_inherited), enabled(is_enabled){}
-			bool inherited = true;	// Set to true by set_state_cascade(), else false
-			bool enabled = false;
-		};
-
-		std::map<std::string, StyleState> states;
+		ViewStateSet enabled_states;
+		ViewStateSet explicit_states;	// States set on this view rather than by set_state_cascade() on an ancestor
 		
 		ViewGeometry _geometry;
 		bool hidden = false;
@@ -139,9 +157,16 @@ namespace uicore
 		Mat4f view_transform = Mat4f::identity();
 		bool content_clipped = false;
 
+		bool layer_cached = false;
+		std::unique_ptr<ViewLayer> layer;	// Created the first time the view renders as a layer
+
 		bool exception_encountered = false;
 
 		bool needs_layout = true;
+		bool descendant_needs_layout = false;	// A view below the nearest layout boundary under this view needs layout
+		bool layout_boundary = false;	// Set by set_layout_boundary
+
+		Rectf render_box;	// Area covered by the view in the canvas at the last layout, empty if not visible
 
 		ViewTree *view_tree = nullptr;
 
@@ -0,0 +1,118 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "view_layer.h"
+
+namespace uicore
+{
+	ViewLayer::ViewLayer()
+	{
+	}
+
+	ViewLayer::~ViewLayer()
+	{
+		release();
+	}
+
+	bool ViewLayer::allocate(const GraphicContextPtr &gc, const Size &new_size)
+	{
+		if (texture && size == new_size)
+			return true;
+
+		release();
+
+		ViewLayerCache &cache = ViewLayerCache::instance();
+		if (!cache.reserve(new_size.width * new_size.height * 4))
+			return false;
+
+		texture = Texture2D::create(gc, new_size, tf_rgba8);
+		size = new_size;
+		cache.add(this);
+		return true;
+	}
+
+	void ViewLayer::release()
+	{
+		if (in_lru)
+			ViewLayerCache::instance().remove(this);
+
+		texture.reset();
+		size = Size();
+		valid = false;
+	}
+
+	void ViewLayer::touch()
+	{
+		ViewLayerCache &cache = ViewLayerCache::instance();
+		last_used_frame = cache.frame;
+		if (in_lru)
+			cache.lru.splice(cache.lru.begin(), cache.lru, lru_it);
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	ViewLayerCache &ViewLayerCache::instance()
+	{
+		static ViewLayerCache cache;
+		return cache;
+	}
+
+	bool ViewLayerCache::reserve(int bytes)
+	{
+		if (bytes > budget)
+			return false;
+
+		// Release the least recently drawn layers, but never those needed for the current frame
+		while (used + bytes > budget && !lru.empty())
+		{
+			ViewLayer *oldest = lru.back();
+			if (oldest->last_used_frame == frame)
+				return false;
+			oldest->release();
+		}
+
+		return used + bytes <= budget;
+	}
+
+	void ViewLayerCache::add(ViewLayer *layer)
+	{
+		used += layer->memory();
+		lru.push_front(layer);
+		layer->lru_it = lru.begin();
+		layer->in_lru = true;
+	}
+
+	void ViewLayerCache::remove(ViewLayer *layer)
+	{
+		used -= layer->memory();
+		lru.erase(layer->lru_it);
+		layer->in_lru = false;
+	}
+}
@@ -0,0 +1,93 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include "UICore/Display/Render/texture_2d.h"
+#include "UICore/Core/Math/rect.h"
+#include <list>
+
+namespace uicore
+{
+	/// \brief Offscreen texture a view and its children were rendered into
+	class ViewLayer
+	{
+	public:
+		ViewLayer();
+		~ViewLayer();
+
+		/// \brief Makes sure the texture has the given size, releasing least recently used layers to stay within the budget
+		///
+		/// \return False if the layer does not fit in the budget or the target cannot render into textures
+		bool allocate(const GraphicContextPtr &gc, const Size &size);
+
+		/// \brief Releases the texture
+		void release();
+
+		/// \brief Marks the layer as drawn in the current frame
+		void touch();
+
+		Texture2DPtr texture;
+		Size size;	// Size of the texture in pixels
+		bool valid = false;	// Texture holds the current rendering of the views
+
+	private:
+		int memory() const { return size.width * size.height * 4; }
+
+		int last_used_frame = -1;
+		bool in_lru = false;
+		std::list<ViewLayer*>::iterator lru_it;
+
+		friend class ViewLayerCache;
+	};
+
+	/// \brief Memory budget shared by all view layers
+	class ViewLayerCache
+	{
+	public:
+		static ViewLayerCache &instance();
+
+		/// \brief Starts a new frame. Layers drawn in the current frame are never released to make room for others
+		void next_frame() { frame++; }
+
+		int budget = 32 * 1024 * 1024;
+		bool rendering_layer = false;	// A layer is being rendered, so the layer canvas is in use
+
+	private:
+		bool reserve(int bytes);
+		void add(ViewLayer *layer);
+		void remove(ViewLayer *layer);
+
+		int used = 0;
+		int frame = 0;
+		std::list<ViewLayer*> lru;	// Most recently drawn first
+
+		friend class ViewLayer;
+	};
+}
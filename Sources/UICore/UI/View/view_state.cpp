@@ -0,0 +1,101 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#include "UICore/precomp.h"
+#include "UICore/Core/Text/text.h"
+#include "view_state.h"
+#include <unordered_map>
+
+namespace uicore
+{
+	static std::unordered_map<std::string, int> &view_state_ids()
+	{
+		static std::unordered_map<std::string, int> ids;
+		return ids;
+	}
+
+	int ViewStateNames::find(const std::string &name)
+	{
+		auto &ids = view_state_ids();
+		auto it = ids.find(name);
+		return it != ids.end() ? it->second : -1;
+	}
+
+	int ViewStateNames::intern(const std::string &name)
+	{
+		auto &ids = view_state_ids();
+		auto it = ids.find(name);
+		if (it != ids.end())
+			return it->second;
+
+		int id = (int)ids.size();
+		ids[name] = id;
+		return id;
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	void ViewStateSet::set(int id, bool value)
+	{
+		size_t word = id / 64;
+		uint64_t bit = uint64_t(1) << (id % 64);
+		if (value)
+		{
+			if (word >= words.size())
+				words.resize(word + 1);
+			words[word] |= bit;
+		}
+		else if (word < words.size())
+		{
+			words[word] &= ~bit;
+		}
+	}
+
+	bool ViewStateSet::contains(const ViewStateSet &other) const
+	{
+		for (size_t i = 0; i < other.words.size(); i++)
+		{
+			uint64_t word = i < words.size() ? words[i] : 0;
+			if ((other.words[i] & ~word) != 0)
+				return false;
+		}
+		return true;
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	ViewStateStyle::ViewStateStyle(Style *style, const std::string &states) : style(style)
+	{
+		for (const auto &state : Text::split(states, " "))
+		{
+			required_states.set(ViewStateNames::intern(state), true);
+			state_count++;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+/*
+**  UICore
+**  Copyright (c) 1997-2015 The UICore Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+**  Note: Some of the libraries UICore may link to may have additional
+**  requirements or restrictions.
+**
+**  File Author(s):
+**
+**    Magnus Norddahl
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uicore
+{
+	class Style;
+
+	/// \brief Interned view state names
+	///
+	/// Each state name used with View::set_state or in a style selector gets a small integer id shared by all views.
+	class ViewStateNames
+	{
+	public:
+		/// \brief Returns the id for a state name, or -1 if the name was never interned
+		static int find(const std::string &name);
+
+		/// \brief Returns the id for a state name, adding it if needed
+		static int intern(const std::string &name);
+	};
+
+	/// \brief Set of view states, indexed by interned state id
+	class ViewStateSet
+	{
+	public:
+		bool test(int id) const
+		{
+			size_t word = id / 64;
+			return id >= 0 && word < words.size() && ((words[word] >> (id % 64)) & 1) != 0;
+		}
+
+		void set(int id, bool value);
+
+		/// \brief True if every state in other is also in this set
+		bool contains(const ViewStateSet &other) const;
+
+	private:
+		std::vector<uint64_t> words;
+	};
+
+	/// \brief Style of a view and the states that must be set for it to apply
+	class ViewStateStyle
+	{
+	public:
+		ViewStateStyle(Style *style, const std::string &states);
+
+		Style *style;
+		ViewStateSet required_states;
+		size_t state_count = 0;
+	};
+}
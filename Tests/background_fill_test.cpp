@@ -0,0 +1,60 @@
+#include "test.h"
+
+using namespace uicore;
+
+static void fill_rect_paths()
+{
+	TestCanvas target(64, 64);
+	target.canvas->set_stats_enabled(true);
+	target.canvas->begin();
+	target.canvas->clear(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+
+	// add_rect, as closed by it
+	Path::rect(Rectf(4.0f, 4.0f, 20.0f, 20.0f))->fill(target.canvas, Brush::solid(1.0f, 0.0f, 0.0f));
+
+	// Lines back to the first corner, as in border area paths
+	auto path = Path::create();
+	path->move_to(30.0f, 4.0f);
+	path->line_to(50.0f, 4.0f);
+	path->line_to(50.0f, 20.0f);
+	path->line_to(30.0f, 20.0f);
+	path->line_to(30.0f, 4.0f);
+	path->close();
+	path->fill(target.canvas, Brush::solid(0.0f, 1.0f, 0.0f));
+	target.canvas->end();
+
+	TEST_CHECK(target.canvas->stats().mask_blocks == 0);
+	TEST_CHECK(target.pixel(10, 10) == 0xff0000ff);
+	TEST_CHECK(target.pixel(40, 10) == 0xff00ff00);
+	TEST_CHECK(target.pixel(25, 10) == 0xff000000);
+}
+
+static void view_backgrounds()
+{
+	TestCanvas target(64, 64);
+	target.canvas->set_stats_enabled(true);
+
+	TestViewTree tree(target.canvas);
+	tree.root_view()->style()->set("layout: flex; flex-direction: column");
+	auto square = tree.add_child();
+	square->style()->set("height: 20px; margin: 4px; background: rgb(255,0,0)");
+	tree.frame(Rectf(0.0f, 0.0f, 64.0f, 64.0f));
+
+	// Drawn as a quad by the triangle batcher, not rasterized into a coverage mask by the path batcher
+	TEST_CHECK(target.canvas->stats().mask_blocks == 0);
+	TEST_CHECK(target.pixel(10, 10) == 0xff0000ff);
+	TEST_CHECK(target.pixel(2, 10) == 0xff000000);
+
+	// Rounded corners still need the path batcher
+	square->style()->set("border-radius: 6px");
+	square->set_needs_render();
+	tree.frame(Rectf(0.0f, 0.0f, 64.0f, 64.0f));
+	TEST_CHECK(target.canvas->stats().mask_blocks > 0);
+}
+
+int main()
+{
+	fill_rect_paths();
+	view_backgrounds();
+	return test_failures();
+}
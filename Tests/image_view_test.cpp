@@ -0,0 +1,50 @@
+#include "test.h"
+#include <thread>
+#include <chrono>
+#include <cstdio>
+
+using namespace uicore;
+
+static void loaded_image_relayout()
+{
+	std::string filename = "image_view_test.png";
+	save_test_png(filename, 8, 4, 0xffffffff);
+
+	TestCanvas target(64, 64);
+	TestViewTree tree(target.canvas);
+	tree.root_view()->style()->set("layout: flex; flex-direction: column; align-items: flex-start");
+
+	// The height follows the image, which has a size of zero until it is loaded
+	auto image = Image::create_async(target.canvas, filename);
+	auto image_view = tree.add_child<ImageBaseView>();
+	image_view->style()->set("width: 16px; margin: 8px");
+	image_view->set_image(image);
+
+	Rectf box(0.0f, 0.0f, 64.0f, 64.0f);
+	tree.damage_frame(box);
+	TEST_CHECK(image_view->geometry().content_height == 0.0f);
+
+	for (int i = 0; i < 500 && !image->is_ready(); i++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		tree.damage_frame(box);
+	}
+	TEST_CHECK(image->is_ready());
+
+	tree.damage_frame(box);
+	TEST_CHECK(image_view->geometry().content_height == 8.0f);
+	TEST_CHECK(target.pixel(12, 10) == 0xffffffff);
+	TEST_CHECK(target.pixel(12, 24) == 0xff000000);
+
+	// Nothing is left to redraw once the image is shown
+	Rectf damage = tree.damage_frame(box);
+	TEST_CHECK(damage.left >= damage.right || damage.top >= damage.bottom);
+
+	std::remove(filename.c_str());
+}
+
+int main()
+{
+	loaded_image_relayout();
+	return test_failures();
+}
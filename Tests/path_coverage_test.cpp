@@ -0,0 +1,165 @@
+#include "test.h"
+#include <cmath>
+#include <cstdlib>
+
+using namespace uicore;
+
+// The reference fills the path at 4x the size, for 8x8 coverage samples per pixel once scaled down
+static const int reference_scale = 4;
+
+// A pixel may differ by the error of the reference, up to 1/8th pixel in x and y along an edge
+static const int polygon_tolerance = 48;
+
+// Curves are also flattened differently at the larger size, within 0.25 pixels of the curve
+static const int curve_tolerance = polygon_tolerance + 64;
+
+// Coverage is found from the average winding number of each pixel. Where the outline crosses itself
+// a pixel can hold both outside and doubly covered parts, so only the total area is compared
+static const int self_intersection_tolerance = 255;
+
+static std::shared_ptr<Path> star(float center_x, float center_y, float radius, PathFillMode mode)
+{
+	auto path = Path::create();
+	path->set_fill_mode(mode);
+	for (int i = 0; i < 5; i++)
+	{
+		float angle = 3.14159265f * (0.5f + i * 0.8f);
+		Pointf point(center_x + radius * std::cos(angle), center_y - radius * std::sin(angle));
+		if (i == 0)
+			path->move_to(point);
+		else
+			path->line_to(point);
+	}
+	path->close();
+	return path;
+}
+
+static std::shared_ptr<Path> curves()
+{
+	auto path = Path::create();
+	path->move_to(6.3f, 50.2f);
+	path->bezier_to(Pointf(20.0f, 2.0f), Pointf(44.0f, 70.0f), Pointf(58.1f, 12.4f));
+	path->bezier_to(Pointf(40.0f, 40.0f), Pointf(30.5f, 58.7f));
+	path->close();
+	return path;
+}
+
+static PixelBufferPtr fill_analytic(const std::shared_ptr<Path> &path)
+{
+	TestCanvas target(64, 64);
+	target.canvas->set_path_rasterizer(PathRasterizer::analytic);
+	target.canvas->begin();
+	target.canvas->clear(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+	path->fill(target.canvas, Brush::solid(1.0f, 1.0f, 1.0f));
+	target.canvas->end();
+	return target.pixels;
+}
+
+// Coverage of each pixel from the supersampled rasterizer, filling at a larger size and averaging the pixels covered
+static std::vector<int> fill_reference(const std::shared_ptr<Path> &path)
+{
+	TestCanvas target(64 * reference_scale, 64 * reference_scale);
+	target.canvas->set_path_rasterizer(PathRasterizer::supersampled);
+	target.canvas->begin();
+	target.canvas->clear(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+	target.canvas->set_transform(Mat4f::scale((float)reference_scale, (float)reference_scale, 1.0f));
+	path->fill(target.canvas, Brush::solid(1.0f, 1.0f, 1.0f));
+	target.canvas->end();
+
+	std::vector<int> coverage(64 * 64);
+	for (int y = 0; y < 64; y++)
+	{
+		for (int x = 0; x < 64; x++)
+		{
+			int sum = 0;
+			for (int sy = 0; sy < reference_scale; sy++)
+			{
+				for (int sx = 0; sx < reference_scale; sx++)
+					sum += target.pixel(x * reference_scale + sx, y * reference_scale + sy) & 0xff;
+			}
+			coverage[x + y * 64] = (sum + reference_scale * reference_scale / 2) / (reference_scale * reference_scale);
+		}
+	}
+	return coverage;
+}
+
+// Area of a polygon that does not intersect itself
+static float polygon_area(const std::vector<Pointf> &points)
+{
+	float area = 0.0f;
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		const Pointf &a = points[i];
+		const Pointf &b = points[(i + 1) % points.size()];
+		area += a.x * b.y - b.x * a.y;
+	}
+	return std::abs(area) * 0.5f;
+}
+
+static std::shared_ptr<Path> polygon(const std::vector<Pointf> &points)
+{
+	auto path = Path::create();
+	path->move_to(points[0]);
+	for (size_t i = 1; i < points.size(); i++)
+		path->line_to(points[i]);
+	path->close();
+	return path;
+}
+
+// Compares the analytic coverage with the reference, and the total area with exact_area if it is known
+static void compare(const char *name, const std::shared_ptr<Path> &path, int max_pixel_difference, double exact_area = -1.0)
+{
+	int failures = test_failures();
+	PixelBufferPtr analytic = fill_analytic(path);
+	std::vector<int> reference = fill_reference(path);
+
+	int max_difference = 0;
+	double analytic_area = 0.0;
+	double reference_area = 0.0;
+	for (int y = 0; y < 64; y++)
+	{
+		for (int x = 0; x < 64; x++)
+		{
+			int a = analytic->line_uint32(y)[x] & 0xff;
+			int s = reference[x + y * 64];
+			max_difference = std::max(max_difference, std::abs(a - s));
+			analytic_area += a / 255.0;
+			reference_area += s / 255.0;
+		}
+	}
+
+	TEST_CHECK(reference_area > 0.0);
+	TEST_CHECK(max_difference <= max_pixel_difference);
+
+	if (exact_area >= 0.0)
+	{
+		TEST_CHECK(std::abs(analytic_area - exact_area) <= 0.001 * exact_area + 0.5);
+	}
+	else
+	{
+		// The sampling errors of the reference mostly cancel out over the whole path
+		TEST_CHECK(std::abs(analytic_area - reference_area) <= 0.01 * reference_area + 1.0);
+	}
+
+	if (test_failures() != failures)
+		std::printf("%s: max difference %d, area %.2f, reference area %.2f\n", name, max_difference, analytic_area, reference_area);
+}
+
+static void compare_polygon(const char *name, const std::vector<Pointf> &points)
+{
+	compare(name, polygon(points), polygon_tolerance, polygon_area(points));
+}
+
+int main()
+{
+	compare_polygon("rect", { Pointf(4.3f, 5.6f), Pointf(50.2f, 5.6f), Pointf(50.2f, 41.9f), Pointf(4.3f, 41.9f) });
+	compare_polygon("rotated square", { Pointf(31.6f, 2.2f), Pointf(61.1f, 30.9f), Pointf(32.4f, 60.5f), Pointf(2.9f, 31.8f) });
+	compare_polygon("arrow", { Pointf(3.2f, 24.5f), Pointf(36.7f, 24.5f), Pointf(36.7f, 10.1f), Pointf(60.4f, 32.3f), Pointf(36.7f, 54.6f), Pointf(36.7f, 40.2f), Pointf(3.2f, 40.2f) });
+	compare_polygon("sliver", { Pointf(3.5f, 60.0f), Pointf(60.2f, 3.3f), Pointf(61.0f, 5.1f) });
+	compare("circle", Path::circle(32.3f, 31.7f, 24.6f), curve_tolerance);
+	compare("ellipse", Path::ellipse(30.0f, 34.2f, 27.5f, 9.3f), curve_tolerance);
+	compare("curves", curves(), curve_tolerance);
+	compare("star winding", star(32.0f, 33.0f, 28.0f, PathFillMode::winding), self_intersection_tolerance);
+	compare("star alternate", star(32.0f, 33.0f, 28.0f, PathFillMode::alternate), self_intersection_tolerance);
+	return test_failures();
+}
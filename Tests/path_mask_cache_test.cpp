@@ -0,0 +1,78 @@
+#include "test.h"
+#include "UICore/Display/2D/path_mask_cache.h"
+
+using namespace uicore;
+
+static std::shared_ptr<Path> triangle(float x)
+{
+	auto path = Path::create();
+	path->move_to(x, 2.0f);
+	path->line_to(x + 20.0f, 2.0f);
+	path->line_to(x + 10.0f, 30.0f);
+	path->close();
+	return path;
+}
+
+static const PathImpl &impl(const std::shared_ptr<Path> &path)
+{
+	return *static_cast<PathImpl*>(path.get());
+}
+
+static PathMaskPtr mask()
+{
+	auto mask = std::make_shared<PathMask>();
+	mask->blocks.push_back(PathMask::Block(0, 0, -1));
+	return mask;
+}
+
+// Paths with the same hash only share a mask if their geometry is the same
+static void hash_collision()
+{
+	auto path_a = triangle(2.0f);
+	auto path_b = triangle(5.0f);
+	Mat4f transform = Mat4f::identity();
+
+	PathMaskKey key_a(1, impl(path_a), nullptr, PathFillMode::alternate, transform, 64, 64);
+	PathMaskKey key_b(1, impl(path_b), nullptr, PathFillMode::alternate, transform, 64, 64);
+	TEST_CHECK(!(key_a == key_b));
+
+	PathMaskCache cache;
+	PathMaskPtr mask_a = mask();
+	cache.insert(key_a, mask_a);
+	TEST_CHECK(!cache.find(key_b));
+
+	// The cache keeps its own copy of the geometry, so a path rebuilt the same way still matches
+	auto path_c = triangle(2.0f);
+	PathMaskKey key_c(1, impl(path_c), nullptr, PathFillMode::alternate, transform, 64, 64);
+	TEST_CHECK(cache.find(key_c) == mask_a);
+
+	path_a->line_to(40.0f, 40.0f);
+	TEST_CHECK(cache.find(key_c) == mask_a);
+}
+
+// Strokes with the same hash only share a mask if their pens have the same shape
+static void pen_collision()
+{
+	auto path = triangle(2.0f);
+	Mat4f transform = Mat4f::identity();
+
+	Pen thin(Colorf(1.0f, 1.0f, 1.0f), 1.0f);
+	Pen thick(Colorf(1.0f, 1.0f, 1.0f), 3.0f);
+	Pen red(Colorf(1.0f, 0.0f, 0.0f), 1.0f);
+
+	PathMaskKey key_thin(2, impl(path), &thin, PathFillMode::winding, transform, 64, 64);
+	PathMaskKey key_thick(2, impl(path), &thick, PathFillMode::winding, transform, 64, 64);
+	PathMaskKey key_red(2, impl(path), &red, PathFillMode::winding, transform, 64, 64);
+	PathMaskKey key_fill(2, impl(path), nullptr, PathFillMode::winding, transform, 64, 64);
+
+	TEST_CHECK(!(key_thin == key_thick));
+	TEST_CHECK(!(key_thin == key_fill));
+	TEST_CHECK(key_thin == key_red);
+}
+
+int main()
+{
+	hash_collision();
+	pen_collision();
+	return test_failures();
+}
@@ -0,0 +1,79 @@
+#include "test.h"
+
+using namespace uicore;
+
+static const unsigned int black = 0xff000000;
+static const unsigned int white = 0xffffffff;
+
+static void stroke_closed_rect(PenCap cap, const std::vector<float> &dashes)
+{
+	TestCanvas target(64, 64);
+	target.canvas->begin();
+	target.canvas->clear(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+
+	Pen pen(Colorf(1.0f, 1.0f, 1.0f, 1.0f), 4.0f);
+	pen.cap = cap;
+	pen.dashes = dashes;
+	Path::rect(Rectf(20.0f, 20.0f, 44.0f, 44.0f))->stroke(target.canvas, pen);
+	target.canvas->end();
+
+	// close() leaves an empty subpath starting at the origin, which must not become a cap dot
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+			TEST_CHECK(target.pixel(x, y) == black);
+	}
+
+	TEST_CHECK(target.pixel(20, 21) == white);
+	TEST_CHECK(target.pixel(32, 32) == black);
+}
+
+static void stroke_zero_length_line()
+{
+	TestCanvas target(64, 64);
+	target.canvas->begin();
+	target.canvas->clear(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+
+	Pen pen(Colorf(1.0f, 1.0f, 1.0f, 1.0f), 8.0f);
+	pen.cap = PenCap::round;
+	auto path = Path::create();
+	path->move_to(32.0f, 32.0f);
+	path->line_to(32.0f, 32.0f);
+	path->stroke(target.canvas, pen);
+	target.canvas->end();
+
+	// A real zero length segment still gets its dot
+	TEST_CHECK(target.pixel(32, 32) == white);
+	TEST_CHECK(target.pixel(0, 0) == black);
+}
+
+// Dashes too short or too many to draw one by one become a solid line
+static void stroke_degenerate_dashes(float length, const std::vector<float> &dashes)
+{
+	TestCanvas target(64, 64);
+	target.canvas->begin();
+	target.canvas->clear(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+
+	Pen pen(Colorf(1.0f, 1.0f, 1.0f, 1.0f), 4.0f);
+	pen.dashes = dashes;
+	auto path = Path::create();
+	path->move_to(0.0f, 32.0f);
+	path->line_to(length, 32.0f);
+	path->stroke(target.canvas, pen);
+	target.canvas->end();
+
+	TEST_CHECK(target.pixel(3, 32) == white);
+	TEST_CHECK(target.pixel(60, 32) == white);
+	TEST_CHECK(target.pixel(3, 20) == black);
+}
+
+int main()
+{
+	stroke_closed_rect(PenCap::round, {});
+	stroke_closed_rect(PenCap::square, {});
+	stroke_closed_rect(PenCap::round, { 6.0f, 3.0f });
+	stroke_zero_length_line();
+	stroke_degenerate_dashes(64.0f, { 0.001f, 0.001f });
+	stroke_degenerate_dashes(1.0e7f, { 2.0f, 2.0f });
+	return test_failures();
+}
@@ -0,0 +1,65 @@
+#include "test.h"
+#include <thread>
+#include <chrono>
+#include <cstdio>
+
+using namespace uicore;
+
+// Draws an image stretched over the content box, even while it is still loading
+class StretchedImageView : public View
+{
+public:
+	StretchedImageView(const ImagePtr &image) : image(image) { }
+
+protected:
+	void render_content(const CanvasPtr &canvas) override
+	{
+		image->draw(canvas, Rectf(0.0f, 0.0f, geometry().content_width, geometry().content_height));
+	}
+
+private:
+	ImagePtr image;
+};
+
+static void placeholder_replaced()
+{
+	std::string filename = "placeholder_redraw_test.png";
+	save_test_png(filename, 4, 4, 0xffffffff);
+
+	TestCanvas target(64, 64);
+	TestViewTree tree(target.canvas);
+	tree.root_view()->style()->set("layout: flex; flex-direction: column");
+
+	// A fixed size, so the view does not move when the image arrives
+	auto image = Image::create_async(target.canvas, filename);
+	auto image_view = tree.add_child<StretchedImageView>(image);
+	image_view->style()->set("width: 16px; height: 16px; margin: 8px");
+
+	Rectf box(0.0f, 0.0f, 64.0f, 64.0f);
+	tree.damage_frame(box);
+
+	// Only the finished upload asks for the next frames
+	for (int i = 0; i < 500 && !image->is_ready(); i++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		tree.damage_frame(box);
+	}
+	TEST_CHECK(image->is_ready());
+
+	tree.damage_frame(box);
+	tree.damage_frame(box);
+	TEST_CHECK(target.pixel(16, 16) == 0xffffffff);
+	TEST_CHECK(target.pixel(2, 2) == 0xff000000);
+
+	// Back to redrawing only what changed
+	Rectf damage = tree.damage_frame(box);
+	TEST_CHECK(damage.left >= damage.right || damage.top >= damage.bottom);
+
+	std::remove(filename.c_str());
+}
+
+int main()
+{
+	placeholder_replaced();
+	return test_failures();
+}
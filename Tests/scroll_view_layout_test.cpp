@@ -0,0 +1,57 @@
+#include "test.h"
+
+using namespace uicore;
+
+// A scroll view without a fixed size takes the size of its content
+static void auto_sized_follows_content()
+{
+	TestCanvas target(64, 64);
+	TestViewTree tree(target.canvas);
+	tree.root_view()->style()->set("layout: flex; flex-direction: column; align-items: flex-start");
+
+	auto scroll = tree.add_child<ScrollBaseView>();
+	auto content = std::make_shared<View>();
+	content->style()->set("width: 20px; height: 10px");
+	scroll->content_view()->add_child(content);
+
+	Rectf box(0.0f, 0.0f, 64.0f, 64.0f);
+	tree.damage_frame(box);
+	TEST_CHECK(scroll->geometry().content_height == 10.0f);
+
+	content->style()->set("height: 30px");
+	content->set_needs_layout();
+	tree.damage_frame(box);
+	TEST_CHECK(scroll->geometry().content_height == 30.0f);
+	TEST_CHECK(!scroll->is_layout_boundary());
+}
+
+// With a definite size only the scroll range changes, so relayout stops at the scroll view
+static void fixed_size_is_boundary()
+{
+	TestCanvas target(64, 64);
+	TestViewTree tree(target.canvas);
+	tree.root_view()->style()->set("layout: flex; flex-direction: column; align-items: flex-start");
+
+	auto scroll = tree.add_child<ScrollBaseView>();
+	scroll->style()->set("width: 40px; height: 20px");
+	auto content = std::make_shared<View>();
+	content->style()->set("width: 20px; height: 10px");
+	scroll->content_view()->add_child(content);
+
+	Rectf box(0.0f, 0.0f, 64.0f, 64.0f);
+	tree.damage_frame(box);
+	TEST_CHECK(scroll->is_layout_boundary());
+
+	content->style()->set("height: 50px");
+	content->set_needs_layout();
+	TEST_CHECK(!tree.root_view()->needs_layout());
+	tree.damage_frame(box);
+	TEST_CHECK(scroll->geometry().content_height == 20.0f);
+}
+
+int main()
+{
+	auto_sized_follows_content();
+	fixed_size_is_boundary();
+	return test_failures();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <uicore.h>
+#include <cstdio>
+
+// Each test program prints the checks that failed and returns their count, which ctest treats as a failure when not zero
+
+inline int &test_failures()
+{
+	static int failures = 0;
+	return failures;
+}
+
+inline void test_check(bool condition, const char *expression, const char *file, int line)
+{
+	if (!condition)
+	{
+		std::printf("%s(%d): check failed: %s\n", file, line, expression);
+		test_failures()++;
+	}
+}
+
+#define TEST_CHECK(condition) test_check(condition, #condition, __FILE__, __LINE__)
+
+// Canvas drawing into a pixel buffer on the CPU, so the tests need neither a window nor a GPU
+class TestCanvas
+{
+public:
+	TestCanvas(int width, int height)
+	{
+		pixels = uicore::PixelBuffer::create(width, height, uicore::tf_rgba8);
+		canvas = uicore::Canvas::create(uicore::SoftwareTarget::create_graphic_context(pixels));
+	}
+
+	// Pixel in the tf_rgba8 layout, 0xAABBGGRR
+	unsigned int pixel(int x, int y) const { return pixels->line_uint32(y)[x]; }
+
+	uicore::PixelBufferPtr pixels;
+	uicore::CanvasPtr canvas;
+};
+
+// View tree rendering into a test canvas
+class TestViewTree : public uicore::ViewTree
+{
+public:
+	TestViewTree(const uicore::CanvasPtr &canvas) : tree_canvas(canvas) { }
+
+	uicore::DisplayWindowPtr display_window() override { return nullptr; }
+	uicore::CanvasPtr canvas() const override { return tree_canvas; }
+
+	// Clears the canvas to black and renders all views
+	void frame(const uicore::Rectf &box)
+	{
+		tree_canvas->begin();
+		tree_canvas->clear(uicore::Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+		render(tree_canvas, box);
+		tree_canvas->end();
+	}
+
+	// Redraws only the damage, keeping the rest of the previous frame like TopLevelWindow does. Returns the area redrawn
+	uicore::Rectf damage_frame(const uicore::Rectf &box)
+	{
+		tree_canvas->begin();
+		uicore::Rectf damage = update_layout(tree_canvas, box);
+		if (damage.left < damage.right && damage.top < damage.bottom)
+		{
+			tree_canvas->push_clip(damage);
+			tree_canvas->clear(uicore::Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+			render(tree_canvas, box);
+			tree_canvas->pop_clip();
+		}
+		tree_canvas->end();
+		return damage;
+	}
+
+protected:
+	void set_needs_render() override { }
+	uicore::Pointf client_to_screen_pos(const uicore::Pointf &pos) override { return pos; }
+	uicore::Pointf screen_to_client_pos(const uicore::Pointf &pos) override { return pos; }
+
+private:
+	uicore::CanvasPtr tree_canvas;
+};
+
+// Writes a single colored PNG file for the image loading tests
+inline void save_test_png(const std::string &filename, int width, int height, unsigned int color)
+{
+	auto pixels = uicore::PixelBuffer::create(width, height, uicore::tf_rgba8);
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+			pixels->line_uint32(y)[x] = color;
+	}
+	uicore::PNGFormat::save(pixels, filename);
+}